@@ -26,12 +26,15 @@
 #define GLM_FORCE_RADIANS
 
 #include <mutex>
+#include <set>
 #include <utility>
 
 #include <wx/datetime.h>
 #include <wx/dir.h>
+#include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx/stdpaths.h>
+#include <wx/textfile.h>
 
 #include <boost/version.hpp>
 
@@ -55,12 +58,18 @@
 #include <project.h>
 #include <settings/common_settings.h>
 #include <settings/settings_manager.h>
+#include <core/thread_pool.h>
 #include <wx_filename.h>
 
 
 #define MASK_3D_CACHE "3D_CACHE"
 
+// name of the file in the cache directory mapping model files to their hashes
+#define FILE_INDEX_NAME wxT( "models.idx" )
+#define FILE_INDEX_VERSION wxT( "#3d-file-index 1" )
+
 static std::mutex mutex3D_cache;
+static std::mutex mutex3D_index;
 
 
 static bool isSHA1Same( const unsigned char* shaA, const unsigned char* shaB ) noexcept
@@ -120,6 +129,40 @@ static const wxString sha1ToWXString( const unsigned char* aSHA1Sum )
 }
 
 
+static bool sha1FromWXString( const wxString& aString, unsigned char* aSHA1Sum )
+{
+    if( aString.length() != 40 )
+        return false;
+
+    for( int i = 0; i < 20; ++i )
+    {
+        unsigned long val;
+
+        if( !aString.Mid( i * 2, 2 ).ToULong( &val, 16 ) )
+            return false;
+
+        aSHA1Sum[i] = static_cast<unsigned char>( val );
+    }
+
+    return true;
+}
+
+
+static bool getFileStamp( const wxString& aFileName, long long& aModTime, long long& aSize )
+{
+    wxFileName fname( aFileName );
+    wxDateTime modTime = fname.GetModificationTime();
+    wxULongLong size = fname.GetSize();
+
+    if( !modTime.IsValid() || size == wxInvalidSize )
+        return false;
+
+    aModTime = modTime.GetValue().GetValue();
+    aSize = static_cast<long long>( size.GetValue() );
+    return true;
+}
+
+
 class S3D_CACHE_ENTRY
 {
 public:
@@ -189,6 +232,7 @@ S3D_CACHE::S3D_CACHE()
     m_FNResolver = new FILENAME_RESOLVER;
     m_project = nullptr;
     m_Plugins = new S3D_PLUGIN_MANAGER;
+    m_fileIndexDirty = false;
 }
 
 
@@ -235,7 +279,7 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePa
             if( fmdate != mi->second->modTime )
             {
                 unsigned char hashSum[20];
-                getSHA1( full3Dpath, hashSum );
+                getFileHash( full3Dpath, hashSum );
                 mi->second->modTime = fmdate;
 
                 if( !isSHA1Same( hashSum, mi->second->sha1sum ) )
@@ -289,7 +333,7 @@ SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY**
     wxFileName fname( aFileName );
     ep->modTime = fname.GetModificationTime();
 
-    if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
+    if( !getFileHash( aFileName, sha1sum ) || m_CacheDir.empty() )
     {
         // just in case we can't get a hash digest (for example, on access issues)
         // or we do not have a configured cache file directory, we create an
@@ -401,6 +445,136 @@ bool S3D_CACHE::getSHA1( const wxString& aFileName, unsigned char* aSHA1Sum )
 }
 
 
+bool S3D_CACHE::getFileHash( const wxString& aFileName, unsigned char* aSHA1Sum )
+{
+    long long modTime = 0;
+    long long size = 0;
+    bool      haveStamp = getFileStamp( aFileName, modTime, size );
+
+    if( haveStamp )
+    {
+        std::lock_guard<std::mutex> lock( mutex3D_index );
+
+        auto it = m_fileIndex.find( aFileName );
+
+        if( it != m_fileIndex.end() && it->second.m_modTime == modTime
+                && it->second.m_size == size )
+        {
+            memcpy( aSHA1Sum, it->second.m_sha1, 20 );
+            return true;
+        }
+    }
+
+    if( !getSHA1( aFileName, aSHA1Sum ) )
+        return false;
+
+    if( haveStamp )
+    {
+        std::lock_guard<std::mutex> lock( mutex3D_index );
+
+        FILE_STAMP& stamp = m_fileIndex[aFileName];
+        stamp.m_modTime = modTime;
+        stamp.m_size = size;
+        memcpy( stamp.m_sha1, aSHA1Sum, 20 );
+        m_fileIndexDirty = true;
+    }
+
+    return true;
+}
+
+
+void S3D_CACHE::loadFileIndex()
+{
+    wxTextFile file( m_CacheDir + FILE_INDEX_NAME );
+
+    if( m_CacheDir.empty() || !file.Exists() || !file.Open( wxConvUTF8 ) )
+        return;
+
+    if( file.GetLineCount() == 0 || file.GetFirstLine() != FILE_INDEX_VERSION )
+        return;
+
+    std::lock_guard<std::mutex> lock( mutex3D_index );
+
+    // Each record is "<sha1> <modification time> <size>\t<full path>"
+    for( size_t i = 1; i < file.GetLineCount(); ++i )
+    {
+        const wxString& line = file.GetLine( i );
+        wxString        path;
+        wxString        fields = line.BeforeFirst( '\t', &path );
+        FILE_STAMP      stamp;
+
+        wxString sha1 = fields.BeforeFirst( ' ', &fields );
+        wxString modTime = fields.BeforeFirst( ' ', &fields );
+
+        if( path.empty() || !sha1FromWXString( sha1, stamp.m_sha1 )
+                || !modTime.ToLongLong( &stamp.m_modTime ) || !fields.ToLongLong( &stamp.m_size ) )
+        {
+            continue;
+        }
+
+        m_fileIndex[path] = stamp;
+    }
+
+    m_fileIndexDirty = false;
+}
+
+
+void S3D_CACHE::saveFileIndex()
+{
+    std::lock_guard<std::mutex> lock( mutex3D_index );
+
+    if( !m_fileIndexDirty || m_CacheDir.empty() )
+        return;
+
+    // Write to a temporary file and move it into place, so that a crash or another instance
+    // writing at the same time never leaves a truncated index behind.
+    wxString indexName = m_CacheDir + FILE_INDEX_NAME;
+    wxString tempName = wxFileName::CreateTempFileName( indexName );
+    wxFFile  file;
+
+    if( tempName.empty() || !file.Open( tempName, wxT( "wb" ) ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] cannot write file index in '%s'" ),
+                    m_CacheDir );
+        return;
+    }
+
+    wxString out = FILE_INDEX_VERSION + wxT( "\n" );
+
+    for( auto it = m_fileIndex.begin(); it != m_fileIndex.end(); )
+    {
+        const FILE_STAMP& stamp = it->second;
+        wxString          sha1 = sha1ToWXString( stamp.m_sha1 );
+
+        // Drop entries whose cache file has been cleaned away (or was never written)
+        if( !wxFileName::FileExists( m_CacheDir + sha1 + wxT( ".3dc" ) ) )
+        {
+            it = m_fileIndex.erase( it );
+            continue;
+        }
+
+        out << sha1 << ' '
+            << wxString::Format( wxT( "%lld %lld" ), stamp.m_modTime, stamp.m_size ) << '\t'
+            << it->first << '\n';
+
+        ++it;
+    }
+
+    bool written = file.Write( out, wxConvUTF8 );
+    written &= file.Close();
+
+    if( !written || !wxRenameFile( tempName, indexName, true ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] cannot write file index '%s'" ),
+                    indexName );
+        wxRemoveFile( tempName );
+        return;
+    }
+
+    m_fileIndexDirty = false;
+}
+
+
 bool S3D_CACHE::loadCacheData( S3D_CACHE_ENTRY* aCacheItem )
 {
     wxString bname = aCacheItem->GetCacheBaseName();
@@ -555,6 +729,7 @@ bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
     }
 
     m_CacheDir = cacheDir.GetPathWithSep();
+    loadFileIndex();
     return true;
 }
 
@@ -619,6 +794,8 @@ void S3D_CACHE::FlushCache( bool closePlugins )
     m_CacheList.clear();
     m_CacheMap.clear();
 
+    saveFileIndex();
+
     if( closePlugins )
         ClosePlugins();
 }
@@ -657,6 +834,96 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName, const wxString& a
     return mp;
 }
 
+void S3D_CACHE::PrefetchModels( const std::vector<std::pair<wxString, wxString>>& aModels )
+{
+    if( m_CacheDir.empty() || ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache )
+        return;
+
+    struct PREFETCH_ITEM
+    {
+        wxString      m_path;
+        wxDateTime    m_modTime;
+        unsigned char m_sha1[20];
+        SCENEGRAPH*   m_scene = nullptr;
+    };
+
+    std::vector<PREFETCH_ITEM> items;
+
+    {
+        std::set<wxString> seen;
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+        for( const auto& [ modelFile, basePath ] : aModels )
+        {
+            wxString fullPath = m_FNResolver->ResolvePath( modelFile, basePath );
+
+            if( fullPath.empty() || m_CacheMap.count( fullPath ) || !seen.insert( fullPath ).second )
+                continue;
+
+            items.emplace_back();
+            items.back().m_path = fullPath;
+        }
+    }
+
+    if( items.empty() )
+        return;
+
+    // Hashing only touches per-item state, so it can run concurrently.  Parsing the cache
+    // files goes through the plugin manager and shared scene graph state, so it is done one
+    // file at a time.  Plugin imports stay serial in load().
+    thread_pool& tp = GetKiCadThreadPool();
+    std::mutex   parseMutex;
+
+    tp.push_loop( items.size(),
+            [&]( const int a, const int b )
+            {
+                for( int i = a; i < b; ++i )
+                {
+                    PREFETCH_ITEM& item = items[i];
+
+                    item.m_modTime = wxFileName( item.m_path ).GetModificationTime();
+
+                    if( !getFileHash( item.m_path, item.m_sha1 ) )
+                        continue;
+
+                    wxString cacheName = m_CacheDir + sha1ToWXString( item.m_sha1 ) + wxT( ".3dc" );
+
+                    if( wxFileName::FileExists( cacheName ) )
+                    {
+                        std::lock_guard<std::mutex> parseLock( parseMutex );
+
+                        item.m_scene = (SCENEGRAPH*) S3D::ReadCache( cacheName.ToUTF8(),
+                                                                     m_Plugins, checkTag );
+                    }
+                }
+            } );
+
+    tp.wait_for_tasks();
+
+    std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+    for( PREFETCH_ITEM& item : items )
+    {
+        if( !item.m_scene )
+            continue;
+
+        if( m_CacheMap.count( item.m_path ) )
+        {
+            S3D::DestroyNode( (SGNODE*) item.m_scene );
+            continue;
+        }
+
+        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
+        ep->modTime = item.m_modTime;
+        ep->SetSHA1( item.m_sha1 );
+        ep->sceneData = item.m_scene;
+
+        m_CacheList.push_back( ep );
+        m_CacheMap.emplace( item.m_path, ep );
+    }
+}
+
+
 void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
 {
     wxDir         dir;
@@ -690,8 +957,13 @@ void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
             {
                 if( lastAccess.IsEarlierThan( thresholdDate ) )
                 {
-                    // This file is older than the threshold so delete it
-                    wxRemoveFile( thisFile.GetFullPath() );
+                    // This file is older than the threshold so delete it, and have the file
+                    // index drop its entry the next time it is saved
+                    if( wxRemoveFile( thisFile.GetFullPath() ) )
+                    {
+                        std::lock_guard<std::mutex> lock( mutex3D_index );
+                        m_fileIndexDirty = true;
+                    }
                 }
             }
         }
@@ -34,6 +34,7 @@
 #include "string_utils.h"
 #include <list>
 #include <map>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -127,6 +128,17 @@ public:
      */
     S3DMODEL* GetModel( const wxString& aModelFileName, const wxString& aBasePath );
 
+    /**
+     * Warm the cache for a batch of models before they are requested one by one.
+     *
+     * File hashes are computed and existing ".3dc" cache files are read concurrently on the
+     * thread pool.  Models without a usable cache file are left for Load() or GetModel(),
+     * since the import plugins are not safe to run concurrently.
+     *
+     * @param aModels is a list of (model file name, base path) pairs.
+     */
+    void PrefetchModels( const std::vector<std::pair<wxString, wxString>>& aModels );
+
     /**
      * Delete up old cache files in cache directory.
      *
@@ -158,6 +170,18 @@ private:
      */
     bool getSHA1( const wxString& aFileName, unsigned char* aSHA1Sum );
 
+    /**
+     * Return the SHA1 hash of the given file, using the file index when the modification
+     * time and size of the file are unchanged since it was last hashed.
+     *
+     * This function is thread safe.
+     */
+    bool getFileHash( const wxString& aFileName, unsigned char* aSHA1Sum );
+
+    /// Read and write the persistent file index in the cache directory.
+    void loadFileIndex();
+    void saveFileIndex();
+
     // load scene data from a cache file
     bool loadCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
@@ -173,6 +197,18 @@ private:
     /// mapping of file names to cache names and data
     std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString > m_CacheMap;
 
+    /// modification time and size of a model file when it was last hashed
+    struct FILE_STAMP
+    {
+        long long     m_modTime;
+        long long     m_size;
+        unsigned char m_sha1[20];
+    };
+
+    /// mapping of full model file names to their last known hash
+    std::map<wxString, FILE_STAMP> m_fileIndex;
+    bool                           m_fileIndexDirty;
+
     FILENAME_RESOLVER*  m_FNResolver;
 
     S3D_PLUGIN_MANAGER* m_Plugins;
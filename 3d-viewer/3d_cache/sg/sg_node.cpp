@@ -23,6 +23,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <iostream>
@@ -47,7 +48,9 @@ static const std::string node_names[S3D::SGTYPE_END + 1] = {
 };
 
 
-static unsigned int node_counts[S3D::SGTYPE_END] = { 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+// Nodes are also created on thread pool workers: S3D_CACHE::PrefetchModels() reads cache files
+// there, one file at a time.  Atomic counters keep names unique whichever thread builds a node.
+static std::atomic<unsigned int> node_counts[S3D::SGTYPE_END] = { 1, 1, 1, 1, 1, 1, 1, 1, 1 };
 
 
 char const* S3D::GetNodeTypeName( S3D::SGTYPES aType ) noexcept
@@ -64,8 +67,7 @@ static void getNodeName( S3D::SGTYPES nodeType, std::string& aName )
         return;
     }
 
-    unsigned int seqNum = node_counts[nodeType];
-    ++node_counts[nodeType];
+    unsigned int seqNum = node_counts[nodeType]++;
 
     std::ostringstream ostr;
     ostr << node_names[nodeType] << "_" << seqNum;
@@ -272,6 +272,42 @@ bool BOARD_ADAPTER::Is3dLayerEnabled( PCB_LAYER_ID aLayer,
 }
 
 
+BOARD_ADAPTER::LAYERS_CACHE_KEY BOARD_ADAPTER::makeLayersCacheKey() const
+{
+    const EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_Cfg->m_Render;
+    std::bitset<LAYER_3D_END>                      visibilityFlags = GetVisibleLayers();
+    LAYERS_CACHE_KEY                               key;
+
+    if( m_board )
+    {
+        key.m_board = m_board;
+        key.m_boardUuid = m_board->m_Uuid;
+        key.m_boardTimeStamp = m_board->GetTimeStamp();
+    }
+
+    key.m_biuTo3Dunits = m_biuTo3Dunits;
+    key.m_copperLayersCount = m_copperLayersCount;
+
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; ++layer )
+    {
+        if( Is3dLayerEnabled( ToLAYER_ID( layer ), visibilityFlags ) )
+            key.m_enabledLayers.set( layer );
+    }
+
+    for( GAL_LAYER_ID layer : { LAYER_FP_REFERENCES, LAYER_FP_VALUES, LAYER_FP_TEXT } )
+        key.m_fpTextFlags.set( layer, visibilityFlags.test( layer ) );
+
+    key.m_buildContours = cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL;
+    key.m_differentiatePlatedCopper = cfg.differentiate_plated_copper;
+    key.m_subtractMaskFromSilk = cfg.subtract_mask_from_silk;
+    key.m_clipSilkOnViaAnnuli = cfg.clip_silk_on_via_annuli;
+    key.m_showZones = cfg.show_zones;
+    key.m_showOffBoardSilk = cfg.show_off_board_silk;
+
+    return key;
+}
+
+
 bool BOARD_ADAPTER::IsFootprintShown( FOOTPRINT_ATTR_T aFPAttributes ) const
 {
     if( m_IsPreviewer )     // In panel Preview, footprints are always shown, of course
@@ -530,10 +566,20 @@ void BOARD_ADAPTER::InitSettings( REPORTER* aStatusReporter, REPORTER* aWarningR
     unsigned stats_startCreateBoardPolyTime = GetRunningMicroSecs();
 #endif
 
-    if( aStatusReporter )
-        aStatusReporter->Report( _( "Create layers" ) );
+    LAYERS_CACHE_KEY layersKey = makeLayersCacheKey();
 
-    createLayers( aStatusReporter );
+    if( layersKey == m_layersCacheKey )
+    {
+        wxLogTrace( m_logTrace, wxT( "BOARD_ADAPTER::InitSettings: layers are up to date" ) );
+    }
+    else
+    {
+        if( aStatusReporter )
+            aStatusReporter->Report( _( "Create layers" ) );
+
+        createLayers( aStatusReporter );
+        m_layersCacheKey = layersKey;
+    }
 
     auto to_SFVEC4F =
             []( const COLOR4D& src )
@@ -344,6 +344,47 @@ private:
     void createLayers( REPORTER* aStatusReporter );
     void destroyLayers();
 
+    /**
+     * Everything the geometry built by createLayers() depends on.  If none of it changed since
+     * the last build (for instance only colors or 3D model visibility were edited), the layers
+     * are reused as they are.
+     */
+    struct LAYERS_CACHE_KEY
+    {
+        const BOARD*              m_board = nullptr;
+        KIID                      m_boardUuid = niluuid;
+        int                       m_boardTimeStamp = 0;
+        double                    m_biuTo3Dunits = 0.0;
+        unsigned int              m_copperLayersCount = 0;
+        LSET                      m_enabledLayers;
+        std::bitset<LAYER_3D_END> m_fpTextFlags;
+        bool                      m_buildContours = false;
+        bool                      m_differentiatePlatedCopper = false;
+        bool                      m_subtractMaskFromSilk = false;
+        bool                      m_clipSilkOnViaAnnuli = false;
+        bool                      m_showZones = false;
+        bool                      m_showOffBoardSilk = false;
+
+        bool operator==( const LAYERS_CACHE_KEY& aOther ) const
+        {
+            return m_board == aOther.m_board
+                    && m_boardUuid == aOther.m_boardUuid
+                    && m_boardTimeStamp == aOther.m_boardTimeStamp
+                    && m_biuTo3Dunits == aOther.m_biuTo3Dunits
+                    && m_copperLayersCount == aOther.m_copperLayersCount
+                    && m_enabledLayers == aOther.m_enabledLayers
+                    && m_fpTextFlags == aOther.m_fpTextFlags
+                    && m_buildContours == aOther.m_buildContours
+                    && m_differentiatePlatedCopper == aOther.m_differentiatePlatedCopper
+                    && m_subtractMaskFromSilk == aOther.m_subtractMaskFromSilk
+                    && m_clipSilkOnViaAnnuli == aOther.m_clipSilkOnViaAnnuli
+                    && m_showZones == aOther.m_showZones
+                    && m_showOffBoardSilk == aOther.m_showOffBoardSilk;
+        }
+    };
+
+    LAYERS_CACHE_KEY makeLayersCacheKey() const;
+
     // Helper functions to create the board
     void createViaWithMargin( const PCB_TRACK* aTrack, CONTAINER_2D_BASE* aDstContainer,
                               int aMargin );
@@ -461,6 +502,8 @@ private:
     BVH_CONTAINER_2D  m_viaAnnuli;            ///< List of via annular rings
     BVH_CONTAINER_2D  m_viaTH_ODs;            ///< List of via hole outer diameters
 
+    LAYERS_CACHE_KEY  m_layersCacheKey;       ///< What the current layers were built from
+
     unsigned int      m_copperLayersCount;
 
     double            m_biuTo3Dunits;         ///< Scale factor to convert board internal units
@@ -45,10 +45,11 @@
 #include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
 #include <vector>
-#include <thread>
+#include <mutex>
+#include <unordered_map>
 #include <core/arraydim.h>
+#include <core/thread_pool.h>
 #include <algorithm>
-#include <atomic>
 #include <wx/log.h>
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -85,6 +86,25 @@ void buildPadOutlineAsPolygon( const PAD* aPad, SHAPE_POLY_SET& aBuffer, int aWi
 }
 
 
+/*
+ * Run aFunc( index ) for each index below aCount on the thread pool, one task per index, and
+ * wait for all of them to finish.
+ */
+template <typename FUNC>
+static void parallelFor( size_t aCount, FUNC&& aFunc )
+{
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.parallelize_loop( 0, aCount,
+                         [&]( size_t aStart, size_t aEnd )
+                         {
+                             for( size_t ii = aStart; ii < aEnd; ++ii )
+                                 aFunc( ii );
+                         },
+                         aCount ).get();
+}
+
+
 void transformFPShapesToPolySet( const FOOTPRINT* aFootprint, PCB_LAYER_ID aLayer,
                                  SHAPE_POLY_SET& aBuffer, int aMaxError, ERROR_LOC aErrorLoc )
 {
@@ -142,6 +162,8 @@ void BOARD_ADAPTER::destroyLayers()
     m_TH_IDs.Clear();
     m_viaAnnuli.Clear();
     m_viaTH_ODs.Clear();
+
+    m_layersCacheKey = LAYERS_CACHE_KEY();
 }
 
 
@@ -163,6 +185,7 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     LSET         cu_set = LSET::AllCuMask( m_copperLayersCount );
 
     EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_Cfg->m_Render;
+    const bool buildContours = cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL;
 
     std::bitset<LAYER_3D_END> visibilityFlags = GetVisibleLayers();
 
@@ -232,7 +255,7 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         BVH_CONTAINER_2D *layerContainer = new BVH_CONTAINER_2D;
         m_layerMap[layer] = layerContainer;
 
-        if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
+        if( buildContours )
         {
             SHAPE_POLY_SET* layerPoly = new SHAPE_POLY_SET;
             m_layers_poly[layer] = layerPoly;
@@ -259,31 +282,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( aStatusReporter )
         aStatusReporter->Report( _( "Create tracks and vias" ) );
 
-    // Create tracks as objects and add it to container
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
-
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
-
-        for( const PCB_TRACK* track : trackList )
-        {
-            // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( layer ) )
-                continue;
-
-            // Skip vias annulus when not flashed on this layer
-            if( track->Type() == PCB_VIA_T
-                    && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
-            {
-                continue;
-            }
-
-            // Add object item to layer container
-            createTrack( track, layerContainer );
-        }
-    }
-
     // Create VIAS and THTs objects and add it to holes containers
     for( PCB_LAYER_ID layer : layer_ids )
     {
@@ -448,38 +446,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
     }
 
-    // Creates vertical outline contours of the tracks and add it to the poly of the layer
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
-
-            // ADD TRACKS
-            unsigned int nTracks = trackList.size();
-
-            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-            {
-                const PCB_TRACK *track = trackList[trackIdx];
-
-                if( !track->IsOnLayer( layer ) )
-                    continue;
-
-                // Skip vias annulus when not flashed on this layer
-                if( track->Type() == PCB_VIA_T
-                        && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
-                {
-                    continue;
-                }
-
-                // Add the track/via contour
-                track->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-            }
-        }
-    }
-
     // Add holes of footprints
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
@@ -543,145 +509,146 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
     }
 
-    // Add footprints PADs objects to containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
+    // Add tracks, pads and graphic items to the object container of each copper layer, and to
+    // its poly contours when building vertical outlines.  A layer only writes its own containers,
+    // so the layers are built in parallel.
+    auto buildCopperLayer =
+            [&]( PCB_LAYER_ID layer )
+            {
+                BVH_CONTAINER_2D* layerContainer = m_layerMap.at( layer );
+                SHAPE_POLY_SET*   layerPoly = buildContours ? m_layers_poly.at( layer ) : nullptr;
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+                // ADD TRACKS
+                for( const PCB_TRACK* track : trackList )
+                {
+                    // NOTE: Vias can be on multiple layers
+                    if( !track->IsOnLayer( layer ) )
+                        continue;
 
-        // ADD PADS
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            addPads( footprint, layerContainer, layer, cfg.differentiate_plated_copper, false );
+                    // Skip vias annulus when not flashed on this layer
+                    if( track->Type() == PCB_VIA_T
+                            && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
+                    {
+                        continue;
+                    }
 
-            // Micro-wave footprints may have items on copper layers
-            addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
-        }
-    }
+                    // Add object item to layer container
+                    createTrack( track, layerContainer );
 
-    // Add footprints PADs poly contours (vertical outlines)
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+                    // Add the track/via contour
+                    if( layerPoly )
+                    {
+                        track->TransformShapeToPolygon( *layerPoly, layer, 0, maxError,
+                                                        ERROR_INSIDE );
+                    }
+                }
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                // ADD PADS
+                for( FOOTPRINT* footprint : m_board->Footprints() )
+                {
+                    addPads( footprint, layerContainer, layer, cfg.differentiate_plated_copper,
+                             false );
 
-            // Add pads to polygon list
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                // Note: NPTH pads are not drawn on copper layers when the pad has same shape as
-                // its hole
-                footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE,
-                                                   true, cfg.differentiate_plated_copper, false );
+                    // Micro-wave footprints may have items on copper layers
+                    addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
 
-                transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError, ERROR_INSIDE );
-            }
-        }
+                    if( layerPoly )
+                    {
+                        // Note: NPTH pads are not drawn on copper layers when the pad has same
+                        // shape as its hole
+                        footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError,
+                                                           ERROR_INSIDE, true,
+                                                           cfg.differentiate_plated_copper, false );
+
+                        transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError,
+                                                    ERROR_INSIDE );
+                    }
+                }
 
-        if( cfg.differentiate_plated_copper )
-        {
-            // ADD PLATED PADS contours
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                footprint->TransformPadsToPolySet( *m_frontPlatedPadPolys, F_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
+                // Add graphic items on copper layers (texts and other graphics)
+                for( BOARD_ITEM* item : m_board->Drawings() )
+                {
+                    if( !item->IsOnLayer( layer ) )
+                        continue;
 
-                footprint->TransformPadsToPolySet( *m_backPlatedPadPolys, B_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
-            }
-        }
-    }
+                    switch( item->Type() )
+                    {
+                    case PCB_SHAPE_T:
+                        addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
+                        break;
 
-    // Add graphic item on copper layers to object containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
+                    case PCB_TEXT_T:
+                        addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
+                        break;
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+                    case PCB_TEXTBOX_T:
+                        addText( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
+                        addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
+                        break;
 
-        // Add graphic items on copper layers (texts and other graphics)
-        for( BOARD_ITEM* item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( layer ) )
-                continue;
+                    case PCB_DIM_ALIGNED_T:
+                    case PCB_DIM_CENTER_T:
+                    case PCB_DIM_RADIAL_T:
+                    case PCB_DIM_ORTHOGONAL_T:
+                    case PCB_DIM_LEADER_T:
+                        addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
+                        break;
 
-            switch( item->Type() )
-            {
-            case PCB_SHAPE_T:
-                addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXT_T:
-                addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXTBOX_T:
-                addText( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                    addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                break;
-
-            case PCB_DIM_ALIGNED_T:
-            case PCB_DIM_CENTER_T:
-            case PCB_DIM_RADIAL_T:
-            case PCB_DIM_ORTHOGONAL_T:
-            case PCB_DIM_LEADER_T:
-                addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                break;
-
-            default:
-                wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-                break;
-            }
-        }
-    }
+                    default:
+                        wxLogTrace( m_logTrace,
+                                    wxT( "createLayers: item type: %d not implemented" ),
+                                    item->Type() );
+                        break;
+                    }
 
-    // Add graphic item on copper layers to poly contours (vertical outlines)
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+                    if( !layerPoly )
+                        continue;
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                    switch( item->Type() )
+                    {
+                    case PCB_SHAPE_T:
+                        item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError,
+                                                       ERROR_INSIDE );
+                        break;
 
-            // Add graphic items on copper layers (texts and other )
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
+                    case PCB_TEXT_T:
+                    {
+                        PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
 
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
+                        text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
+                        break;
+                    }
 
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+                    case PCB_TEXTBOX_T:
+                    {
+                        PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+
+                        textbox->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
+                        break;
+                    }
 
-                    text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
+                    default:
+                        break;
+                    }
                 }
+            };
 
-                case PCB_TEXTBOX_T:
-                {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+    parallelFor( layer_ids.size(),
+                 [&]( size_t aIdx )
+                 {
+                     buildCopperLayer( layer_ids[aIdx] );
+                 } );
 
-                    textbox->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+    // ADD PLATED PADS contours
+    if( buildContours && cfg.differentiate_plated_copper )
+    {
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            footprint->TransformPadsToPolySet( *m_frontPlatedPadPolys, F_Cu, 0, maxError,
+                                               ERROR_INSIDE, true, false, true );
 
-                default:
-                    wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                                item->Type() );
-                    break;
-                }
-            }
+            footprint->TransformPadsToPolySet( *m_backPlatedPadPolys, B_Cu, 0, maxError,
+                                               ERROR_INSIDE, true, false, true );
         }
     }
 
@@ -714,51 +681,26 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
 
         // Add zones objects
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::min<size_t>( zones.size(),
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
-
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < zones.size();
-                            areaId = nextZone.fetch_add( 1 ) )
-                {
-                    ZONE* zone = zones[areaId].first;
-
-                    if( zone == nullptr )
-                        break;
-
-                    PCB_LAYER_ID layer = zones[areaId].second;
-
-                    auto layerContainer = m_layerMap.find( layer );
-                    auto layerPolyContainer = m_layers_poly.find( layer );
-
-                    if( layerContainer != m_layerMap.end() )
-                        addSolidAreasShapes( zone, layerContainer->second, layer );
-
-                    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL
-                            && layerPolyContainer != m_layers_poly.end() )
-                    {
-                        auto mut_it = layer_lock.find( layer );
-
-                        std::lock_guard< std::mutex > lock( *( mut_it->second ) );
-                        zone->TransformSolidAreasShapesToPolygon( layer, *layerPolyContainer->second );
-                    }
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        parallelFor( zones.size(),
+                     [&]( size_t aIdx )
+                     {
+                         ZONE*        zone = zones[aIdx].first;
+                         PCB_LAYER_ID layer = zones[aIdx].second;
+
+                         auto layerContainer = m_layerMap.find( layer );
+                         auto layerPolyContainer = m_layers_poly.find( layer );
+
+                         if( layerContainer != m_layerMap.end() )
+                             addSolidAreasShapes( zone, layerContainer->second, layer );
+
+                         if( buildContours && layerPolyContainer != m_layers_poly.end() )
+                         {
+                             SHAPE_POLY_SET&             layerPoly = *layerPolyContainer->second;
+                             std::lock_guard<std::mutex> lock( *layer_lock.at( layer ) );
+
+                             zone->TransformSolidAreasShapesToPolygon( layer, layerPoly );
+                         }
+                     } );
     }
     // End Build Copper layers
 
@@ -801,203 +743,218 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         enabledFlags.set( LAYER_3D_SOLDERMASK_BOTTOM );
     }
 
+    std::vector<PCB_LAYER_ID> techLayers;
+
     for( PCB_LAYER_ID layer : LSET::AllNonCuMask().Seq( techLayerList, arrayDim( techLayerList ) ) )
     {
-        if( aStatusReporter )
-            aStatusReporter->Report( wxString::Format( _( "Build Tech layer %d" ), (int) layer ) );
-
         if( !Is3dLayerEnabled( layer, enabledFlags ) )
             continue;
 
-        BVH_CONTAINER_2D *layerContainer = new BVH_CONTAINER_2D;
-        m_layerMap[layer] = layerContainer;
+        techLayers.push_back( layer );
+        m_layerMap[layer] = new BVH_CONTAINER_2D;
+        m_layers_poly[layer] = new SHAPE_POLY_SET;
+    }
 
-        SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
-        m_layers_poly[layer] = layerPoly;
+    const int silkLineWidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
+    const int maskExpansion = m_board->GetDesignSettings().m_SolderMaskExpansion;
 
-        if( Is3dLayerEnabled( layer, visibilityFlags ) )
-        {
-            // Add drawing objects
-            for( BOARD_ITEM* item : m_board->Drawings() )
+    // As for copper, each tech layer only writes its own containers
+    auto buildTechLayer =
+            [&]( PCB_LAYER_ID layer )
             {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
+                BVH_CONTAINER_2D* layerContainer = m_layerMap.at( layer );
+                SHAPE_POLY_SET*   layerPoly = m_layers_poly.at( layer );
 
-                switch( item->Type() )
+                if( Is3dLayerEnabled( layer, visibilityFlags ) )
                 {
-                case PCB_SHAPE_T:
-                    addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
-                    break;
+                    // Add drawing objects
+                    for( BOARD_ITEM* item : m_board->Drawings() )
+                    {
+                        if( !item->IsOnLayer( layer ) )
+                            continue;
 
-                case PCB_TEXT_T:
-                    addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                    break;
+                        switch( item->Type() )
+                        {
+                        case PCB_SHAPE_T:
+                            addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
+                            break;
 
-                case PCB_TEXTBOX_T:
-                    addText( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
+                        case PCB_TEXT_T:
+                            addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
+                            break;
 
-                    if( static_cast<PCB_TEXTBOX*>( item )->IsBorderEnabled() )
-                        addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
+                        case PCB_TEXTBOX_T:
+                            addText( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
 
-                    break;
+                            if( static_cast<PCB_TEXTBOX*>( item )->IsBorderEnabled() )
+                                addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
 
-                case PCB_DIM_ALIGNED_T:
-                case PCB_DIM_CENTER_T:
-                case PCB_DIM_RADIAL_T:
-                case PCB_DIM_ORTHOGONAL_T:
-                case PCB_DIM_LEADER_T:
-                    addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                    break;
+                            break;
 
-                default:
-                    break;
-                }
-            }
+                        case PCB_DIM_ALIGNED_T:
+                        case PCB_DIM_CENTER_T:
+                        case PCB_DIM_RADIAL_T:
+                        case PCB_DIM_ORTHOGONAL_T:
+                        case PCB_DIM_LEADER_T:
+                            addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer,
+                                      item );
+                            break;
 
-            // Add via tech layers
-            if( ( layer == F_Mask || layer == B_Mask ) && !m_board->GetTentVias() )
-            {
-                int maskExpansion = GetBoard()->GetDesignSettings().m_SolderMaskExpansion;
+                        default:
+                            break;
+                        }
+                    }
 
-                for( PCB_TRACK* track : m_board->Tracks() )
-                {
-                    if( track->Type() == PCB_VIA_T
-                            && static_cast<const PCB_VIA*>( track )->FlashLayer( layer )  )
+                    // Add via tech layers
+                    if( ( layer == F_Mask || layer == B_Mask ) && !m_board->GetTentVias() )
                     {
-                        createViaWithMargin( track, layerContainer, maskExpansion );
+                        for( PCB_TRACK* track : m_board->Tracks() )
+                        {
+                            if( track->Type() == PCB_VIA_T
+                                    && static_cast<const PCB_VIA*>( track )->FlashLayer( layer )  )
+                            {
+                                createViaWithMargin( track, layerContainer, maskExpansion );
+                            }
+                        }
                     }
-                }
-            }
-
-            // Add footprints tech layers - objects
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                if( layer == F_SilkS || layer == B_SilkS )
-                {
-                    int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
 
-                    for( PAD* pad : footprint->Pads() )
+                    // Add footprints tech layers - objects
+                    for( FOOTPRINT* footprint : m_board->Footprints() )
                     {
-                        if( !pad->IsOnLayer( layer ) )
-                            continue;
+                        if( layer == F_SilkS || layer == B_SilkS )
+                        {
+                            for( PAD* pad : footprint->Pads() )
+                            {
+                                if( !pad->IsOnLayer( layer ) )
+                                    continue;
 
-                        buildPadOutlineAsSegments( pad, layerContainer, linewidth );
-                    }
-                }
-                else
-                {
-                    addPads( footprint, layerContainer, layer, false, false );
-                }
+                                buildPadOutlineAsSegments( pad, layerContainer, silkLineWidth );
+                            }
+                        }
+                        else
+                        {
+                            addPads( footprint, layerContainer, layer, false, false );
+                        }
 
-                addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
-            }
+                        addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
+                    }
 
-            // Draw non copper zones
-            if( cfg.show_zones )
-            {
-                for( ZONE* zone : m_board->Zones() )
-                {
-                    if( zone->IsOnLayer( layer ) )
-                        addSolidAreasShapes( zone, layerContainer, layer );
+                    // Draw non copper zones
+                    if( cfg.show_zones )
+                    {
+                        for( ZONE* zone : m_board->Zones() )
+                        {
+                            if( zone->IsOnLayer( layer ) )
+                                addSolidAreasShapes( zone, layerContainer, layer );
+                        }
+                    }
                 }
-            }
-        }
 
-        // Add item contours.  We need these if we're building vertical walls or if this is a
-        // mask layer and we're differentiating copper from plated copper.
-        if( ( cfg.engine == RENDER_ENGINE::OPENGL && cfg.opengl_copper_thickness )
-                || ( cfg.differentiate_plated_copper && ( layer == F_Mask || layer == B_Mask ) ) )
-        {
-            // DRAWINGS
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
-
-                switch( item->Type() )
+                // Add item contours.  We need these if we're building vertical walls or if this
+                // is a mask layer and we're differentiating copper from plated copper.
+                if( buildContours
+                        || ( cfg.differentiate_plated_copper
+                             && ( layer == F_Mask || layer == B_Mask ) ) )
                 {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
+                    // DRAWINGS
+                    for( BOARD_ITEM* item : m_board->Drawings() )
+                    {
+                        if( !item->IsOnLayer( layer ) )
+                            continue;
 
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+                        switch( item->Type() )
+                        {
+                        case PCB_SHAPE_T:
+                            item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError,
+                                                           ERROR_INSIDE );
+                            break;
 
-                    text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                        case PCB_TEXT_T:
+                        {
+                            PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
 
-                case PCB_TEXTBOX_T:
-                {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+                            text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
+                            break;
+                        }
 
-                    textbox->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                        case PCB_TEXTBOX_T:
+                        {
+                            PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
 
-                default:
-                    break;
-                }
-            }
+                            textbox->TransformTextToPolySet( *layerPoly, 0, maxError,
+                                                             ERROR_INSIDE );
+                            break;
+                        }
 
-            // NON-TENTED VIAS
-            if( ( layer == F_Mask || layer == B_Mask ) && !m_board->GetTentVias() )
-            {
-                int maskExpansion = GetBoard()->GetDesignSettings().m_SolderMaskExpansion;
+                        default:
+                            break;
+                        }
+                    }
 
-                for( PCB_TRACK* track : m_board->Tracks() )
-                {
-                    if( track->Type() == PCB_VIA_T
-                            && static_cast<const PCB_VIA*>( track )->FlashLayer( layer )  )
+                    // NON-TENTED VIAS
+                    if( ( layer == F_Mask || layer == B_Mask ) && !m_board->GetTentVias() )
                     {
-                        track->TransformShapeToPolygon( *layerPoly, layer, maskExpansion, maxError,
-                                                        ERROR_INSIDE );
+                        for( PCB_TRACK* track : m_board->Tracks() )
+                        {
+                            if( track->Type() == PCB_VIA_T
+                                    && static_cast<const PCB_VIA*>( track )->FlashLayer( layer )  )
+                            {
+                                track->TransformShapeToPolygon( *layerPoly, layer, maskExpansion,
+                                                                maxError, ERROR_INSIDE );
+                            }
+                        }
                     }
-                }
-            }
-
-            // FOOTPRINT CHILDREN
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                if( layer == F_SilkS || layer == B_SilkS )
-                {
-                    int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
 
-                    for( PAD* pad : footprint->Pads() )
+                    // FOOTPRINT CHILDREN
+                    for( FOOTPRINT* footprint : m_board->Footprints() )
                     {
-                        if( pad->IsOnLayer( layer ) )
+                        if( layer == F_SilkS || layer == B_SilkS )
                         {
-                            buildPadOutlineAsPolygon( pad, *layerPoly, linewidth, maxError,
-                                                      ERROR_INSIDE );
+                            for( PAD* pad : footprint->Pads() )
+                            {
+                                if( pad->IsOnLayer( layer ) )
+                                {
+                                    buildPadOutlineAsPolygon( pad, *layerPoly, silkLineWidth,
+                                                              maxError, ERROR_INSIDE );
+                                }
+                            }
+                        }
+                        else
+                        {
+                            footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError,
+                                                               ERROR_INSIDE );
                         }
-                    }
-                }
-                else
-                {
-                    footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                }
 
-                // On tech layers, use a poor circle approximation, only for texts (stroke font)
-                footprint->TransformFPTextToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
+                        // On tech layers, use a poor circle approximation, only for texts (stroke
+                        // font)
+                        footprint->TransformFPTextToPolySet( *layerPoly, layer, 0, maxError,
+                                                             ERROR_INSIDE );
 
-                // Add the remaining things with dynamic seg count for circles
-                transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError, ERROR_INSIDE );
-            }
+                        // Add the remaining things with dynamic seg count for circles
+                        transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError,
+                                                    ERROR_INSIDE );
+                    }
 
-            if( cfg.show_zones || layer == F_Mask || layer == B_Mask )
-            {
-                for( ZONE* zone : m_board->Zones() )
-                {
-                    if( zone->IsOnLayer( layer ) )
-                        zone->TransformSolidAreasShapesToPolygon( layer, *layerPoly );
+                    if( cfg.show_zones || layer == F_Mask || layer == B_Mask )
+                    {
+                        for( ZONE* zone : m_board->Zones() )
+                        {
+                            if( zone->IsOnLayer( layer ) )
+                                zone->TransformSolidAreasShapesToPolygon( layer, *layerPoly );
+                        }
+                    }
+
+                    // This will make a union of all added contours
+                    layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
                 }
-            }
+            };
+
+    parallelFor( techLayers.size(),
+                 [&]( size_t aIdx )
+                 {
+                     buildTechLayer( techLayers[aIdx] );
+                 } );
 
-            // This will make a union of all added contours
-            layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
-        }
-    }
     // End Build Tech layers
 
     // If we're rendering off-board silk, also render pads of footprints which are entirely
@@ -1080,7 +1037,7 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         m_platedPadsBack->BuildBVH();
     }
 
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
+    if( buildContours )
     {
         std::vector<PCB_LAYER_ID> &selected_layer_id = layer_ids;
         std::vector<PCB_LAYER_ID> layer_id_without_F_and_B;
@@ -1107,39 +1064,17 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
                                                            (int) selected_layer_id.size() ) );
             }
 
-            std::atomic<size_t> nextItem( 0 );
-            std::atomic<size_t> threadsFinished( 0 );
-
-            size_t parallelThreadCount = std::min<size_t>(
-                    std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                    selected_layer_id.size() );
-
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            {
-                std::thread t = std::thread(
-                        [&nextItem, &threadsFinished, &selected_layer_id, this]()
-                        {
-                            for( size_t i = nextItem.fetch_add( 1 );
-                                        i < selected_layer_id.size();
-                                        i = nextItem.fetch_add( 1 ) )
-                            {
-                                auto layerPoly = m_layers_poly.find( selected_layer_id[i] );
-
-                                if( layerPoly != m_layers_poly.end() )
-                                {
-                                    // This will make a union of all added contours
-                                    layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
-                                }
-                            }
-
-                            threadsFinished++;
-                        } );
-
-                t.detach();
-            }
-
-            while( threadsFinished < parallelThreadCount )
-                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            parallelFor( selected_layer_id.size(),
+                         [&]( size_t aIdx )
+                         {
+                             auto layerPoly = m_layers_poly.find( selected_layer_id[aIdx] );
+
+                             if( layerPoly != m_layers_poly.end() )
+                             {
+                                 // This will make a union of all added contours
+                                 layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
+                             }
+                         } );
         }
     }
 
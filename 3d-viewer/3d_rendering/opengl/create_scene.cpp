@@ -925,7 +925,11 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
         return;
     }
 
-    // Go for all footprints
+    // Resolve the library base path of every footprint first so that all the models
+    // not yet in memory can be handed to the cache manager as one batch.
+    std::vector<std::pair<const FOOTPRINT*, wxString>> footprints;
+    std::vector<std::pair<wxString, wxString>>         prefetch;
+
     for( const FOOTPRINT* footprint : m_boardAdapter.GetBoard()->Footprints() )
     {
         wxString                libraryName = footprint->GetFPID().GetLibNickname();
@@ -949,6 +953,24 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
             }
         }
 
+        for( const FP_3DMODEL& fp_model : footprint->Models() )
+        {
+            if( fp_model.m_Show && !fp_model.m_Filename.empty()
+                    && m_3dModelMap.find( fp_model.m_Filename ) == m_3dModelMap.end() )
+            {
+                prefetch.emplace_back( fp_model.m_Filename, footprintBasePath );
+            }
+        }
+
+        footprints.emplace_back( footprint, footprintBasePath );
+    }
+
+    if( !prefetch.empty() )
+        m_boardAdapter.Get3dCacheManager()->PrefetchModels( prefetch );
+
+    // Go for all footprints
+    for( const auto& [ footprint, footprintBasePath ] : footprints )
+    {
         for( const FP_3DMODEL& fp_model : footprint->Models() )
         {
             if( fp_model.m_Show && !fp_model.m_Filename.empty() )
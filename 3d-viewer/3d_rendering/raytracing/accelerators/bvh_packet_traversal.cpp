@@ -29,8 +29,13 @@
 
 #include "bvh_pbrt.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
 
-#define BVH_RANGED_TRAVERSAL
+
+#define BVH_SIMD_TRAVERSAL
+//#define BVH_RANGED_TRAVERSAL
 //#define BVH_PARTITION_TRAVERSAL
 
 
@@ -162,6 +167,232 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
 #endif
 
 
+#ifdef BVH_SIMD_TRAVERSAL
+
+// SSE2 is part of the x86-64 baseline, so it needs no runtime check.  Other targets use the
+// scalar version of the same slab test, which compilers are free to auto-vectorize.
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define BVH_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+#endif
+
+
+static_assert( RAYPACKET_RAYS_PER_PACKET == 64, "ray masks are stored in 64 bits" );
+static_assert( RAYPACKET_RAYS_PER_PACKET % 4 == 0, "rays are tested in groups of 4" );
+
+
+static inline unsigned int lowestBit( uint64_t aMask )
+{
+#if defined( _MSC_VER ) && !defined( __clang__ )
+    unsigned long idx;
+    _BitScanForward64( &idx, aMask );
+    return idx;
+#else
+    return __builtin_ctzll( aMask );
+#endif
+}
+
+
+/**
+ * The rays of a packet in structure of arrays layout, so a box can be tested against four
+ * rays at a time with a plain slab test.
+ *
+ * Also tracks the distance of each ray's nearest hit so far, so boxes further away than that
+ * are culled without going back to the hit info.
+ */
+struct RAYPACKET_SOA
+{
+    RAYPACKET_SOA( const RAYPACKET& aRayPacket, const HITINFO_PACKET* aHitInfoPacket )
+    {
+        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        {
+            const RAY& ray = aRayPacket.m_ray[i];
+
+            m_originX[i] = ray.m_Origin.x;
+            m_originY[i] = ray.m_Origin.y;
+            m_originZ[i] = ray.m_Origin.z;
+
+            // Axis aligned rays have infinite components, which would turn into NaNs when the
+            // origin lies on a slab.  With a finite stand-in such rays can at worst miss a box
+            // they only graze along one of its faces.
+            m_invDirX[i] = glm::clamp( ray.m_InvDir.x, -FLT_MAX, FLT_MAX );
+            m_invDirY[i] = glm::clamp( ray.m_InvDir.y, -FLT_MAX, FLT_MAX );
+            m_invDirZ[i] = glm::clamp( ray.m_InvDir.z, -FLT_MAX, FLT_MAX );
+
+            m_tMax[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+        }
+    }
+
+    /**
+     * @return the subset of \a aRays (bit i standing for ray i) that enter \a aBBox closer
+     *         than their nearest hit so far.
+     */
+    uint64_t HitMask( const BBOX_3D& aBBox, uint64_t aRays ) const
+    {
+        uint64_t hits = 0;
+
+#ifdef BVH_USE_SSE2
+        const __m128 minX = _mm_set1_ps( aBBox.Min().x );
+        const __m128 minY = _mm_set1_ps( aBBox.Min().y );
+        const __m128 minZ = _mm_set1_ps( aBBox.Min().z );
+        const __m128 maxX = _mm_set1_ps( aBBox.Max().x );
+        const __m128 maxY = _mm_set1_ps( aBBox.Max().y );
+        const __m128 maxZ = _mm_set1_ps( aBBox.Max().z );
+        const __m128 zero = _mm_setzero_ps();
+#endif
+
+        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; i += 4 )
+        {
+            if( !( ( aRays >> i ) & 0xF ) )
+                continue;
+
+#ifdef BVH_USE_SSE2
+            __m128 invDir = _mm_load_ps( &m_invDirX[i] );
+            __m128 origin = _mm_load_ps( &m_originX[i] );
+            __m128 t0 = _mm_mul_ps( _mm_sub_ps( minX, origin ), invDir );
+            __m128 t1 = _mm_mul_ps( _mm_sub_ps( maxX, origin ), invDir );
+            __m128 tNear = _mm_min_ps( t0, t1 );
+            __m128 tFar = _mm_max_ps( t0, t1 );
+
+            invDir = _mm_load_ps( &m_invDirY[i] );
+            origin = _mm_load_ps( &m_originY[i] );
+            t0 = _mm_mul_ps( _mm_sub_ps( minY, origin ), invDir );
+            t1 = _mm_mul_ps( _mm_sub_ps( maxY, origin ), invDir );
+            tNear = _mm_max_ps( tNear, _mm_min_ps( t0, t1 ) );
+            tFar = _mm_min_ps( tFar, _mm_max_ps( t0, t1 ) );
+
+            invDir = _mm_load_ps( &m_invDirZ[i] );
+            origin = _mm_load_ps( &m_originZ[i] );
+            t0 = _mm_mul_ps( _mm_sub_ps( minZ, origin ), invDir );
+            t1 = _mm_mul_ps( _mm_sub_ps( maxZ, origin ), invDir );
+            tNear = _mm_max_ps( tNear, _mm_min_ps( t0, t1 ) );
+            tFar = _mm_min_ps( tFar, _mm_max_ps( t0, t1 ) );
+
+            const __m128 hit = _mm_and_ps( _mm_cmple_ps( _mm_max_ps( tNear, zero ), tFar ),
+                                           _mm_cmplt_ps( tNear, _mm_load_ps( &m_tMax[i] ) ) );
+
+            hits |= (uint64_t) _mm_movemask_ps( hit ) << i;
+#else
+            for( unsigned int j = i; j < i + 4; ++j )
+            {
+                float t0 = ( aBBox.Min().x - m_originX[j] ) * m_invDirX[j];
+                float t1 = ( aBBox.Max().x - m_originX[j] ) * m_invDirX[j];
+                float tNear = std::min( t0, t1 );
+                float tFar = std::max( t0, t1 );
+
+                t0 = ( aBBox.Min().y - m_originY[j] ) * m_invDirY[j];
+                t1 = ( aBBox.Max().y - m_originY[j] ) * m_invDirY[j];
+                tNear = std::max( tNear, std::min( t0, t1 ) );
+                tFar = std::min( tFar, std::max( t0, t1 ) );
+
+                t0 = ( aBBox.Min().z - m_originZ[j] ) * m_invDirZ[j];
+                t1 = ( aBBox.Max().z - m_originZ[j] ) * m_invDirZ[j];
+                tNear = std::max( tNear, std::min( t0, t1 ) );
+                tFar = std::min( tFar, std::max( t0, t1 ) );
+
+                if( std::max( tNear, 0.0f ) <= tFar && tNear < m_tMax[j] )
+                    hits |= (uint64_t) 1 << j;
+            }
+#endif
+        }
+
+        return hits & aRays;
+    }
+
+    alignas( 16 ) float m_originX[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_originY[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_originZ[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_invDirX[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_invDirY[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_invDirZ[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 16 ) float m_tMax[RAYPACKET_RAYS_PER_PACKET];
+};
+
+
+struct MaskStackNode
+{
+    int      cell;
+    uint64_t rays;  // Rays that hit the parent node
+};
+
+
+// Like the ranged traversal, but each node is only tested against the rays that hit its
+// parent, four rays at a time
+bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoPacket ) const
+{
+    if( m_nodes == nullptr )
+        return false;
+
+    if( &m_nodes[0] == nullptr )
+        return false;
+
+    RAYPACKET_SOA soa( aRayPacket, aHitInfoPacket );
+
+    bool          anyHit = false;
+    int           todoOffset = 0, nodeNum = 0;
+    MaskStackNode todo[MAX_TODOS];
+
+    uint64_t rays = ~(uint64_t) 0;
+
+    while( true )
+    {
+        const LinearBVHNode *curCell = &m_nodes[nodeNum];
+
+        rays = soa.HitMask( curCell->bounds, rays );
+
+        if( rays )
+        {
+            if( curCell->nPrimitives == 0 )
+            {
+                MaskStackNode& node = todo[todoOffset++];
+                node.cell = curCell->secondChildOffset;
+                node.rays = rays;
+                nodeNum = nodeNum + 1;
+                continue;
+            }
+            else
+            {
+                for( int j = 0; j < curCell->nPrimitives; ++j )
+                {
+                    const OBJECT_3D* obj = m_primitives[curCell->primitivesOffset + j];
+
+                    if( !aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
+                        continue;
+
+                    for( uint64_t pending = rays; pending; pending &= pending - 1 )
+                    {
+                        const unsigned int i = lowestBit( pending );
+
+                        if( obj->Intersect( aRayPacket.m_ray[i], aHitInfoPacket[i].m_HitInfo ) )
+                        {
+                            anyHit = true;
+                            aHitInfoPacket[i].m_hitresult = true;
+                            aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                            soa.m_tMax[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+                        }
+                    }
+                }
+            }
+        }
+
+        if( todoOffset == 0 )
+            break;
+
+        const MaskStackNode& node = todo[--todoOffset];
+
+        nodeNum = node.cell;
+        rays = node.rays;
+    }
+
+    return anyHit;
+}
+#endif
+
+
 // "Ray Tracing Deformable Scenes Using Dynamic Bounding Volume Hierarchies"
 // http://www.cs.cmu.edu/afs/cs/academic/class/15869-f11/www/readings/wald07_packetbvh.pdf
 
@@ -36,6 +36,7 @@
 #include "3d_math.h"
 #include "../common_ogl/ogl_utils.h"
 #include <core/profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <wx/image.h>
 #include <wx/log.h>
 
 
@@ -371,9 +372,11 @@ void RENDER_3D_RAYTRACE::renderTracing( GLubyte* ptrPBO, REPORTER* aStatusReport
                     m_blockPositionsWasProcessed[iBlock] = 1;
 
                     // Check if it spend already some time render and request to exit
-                    // to display the progress
-                    if( std::chrono::duration_cast<std::chrono::milliseconds>(
-                            std::chrono::steady_clock::now() - startTime ).count() > 150 )
+                    // to display the progress (there is nothing to display it on when
+                    // rendering off-screen)
+                    if( m_canvas
+                            && std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::steady_clock::now() - startTime ).count() > 150 )
                         breakLoop = true;
                 }
             }
@@ -441,6 +444,77 @@ SFVEC3F ConvertSRGBToLinear( const SFVEC3F& aSRGBcolor )
 #endif
 
 
+bool RENDER_3D_RAYTRACE::RenderToImage( const wxSize& aSize, wxImage& aImage,
+                                        REPORTER* aStatusReporter )
+{
+    wxCHECK_MSG( !m_canvas, false, wxT( "RenderToImage() is only for off-screen renderers" ) );
+
+    // initializeBlockPositions() needs room for at least one fast preview block
+    if( !m_accelerator || aSize.x <= 4 * RAYPACKET_DIM + 4 || aSize.y <= 4 * RAYPACKET_DIM + 4 )
+        return false;
+
+    m_windowSize = aSize;
+    m_oldWindowsSize = aSize;
+    m_camera.SetCurWindowSize( aSize );
+
+    initializeBlockPositions();
+
+    if( m_realBufferSize.x == 0 || m_realBufferSize.y == 0 )
+        return false;
+
+    // Plays the part of the PBO: RGBA, bottom row first
+    std::vector<GLubyte> buffer( (size_t) m_realBufferSize.x * m_realBufferSize.y * 4, 0 );
+
+    m_camera.ParametersChanged();
+    m_renderState = RT_RENDER_STATE_MAX;
+
+    // Without a canvas renderTracing() doesn't stop to show progress, so this only loops
+    // through the post processing states
+    do
+    {
+        render( buffer.data(), aStatusReporter );
+    } while( m_renderState != RT_RENDER_STATE_FINISH );
+
+    if( !aImage.Create( aSize.x, aSize.y, false ) )
+        return false;
+
+    unsigned char* dst = aImage.GetData();
+
+    for( int y = 0; y < aSize.y; ++y )
+    {
+        // The image goes top-down, the buffer bottom-up and centered in the window
+        const int windowY = aSize.y - 1 - y;
+        const int bufferY = windowY - (int) m_yoffset;
+
+        // Same gradient renderBlockTracing() uses for rays that miss the board
+        const float   posYfactor = (float) windowY / (float) aSize.y;
+        const SFVEC3F bgLinear = m_backgroundColorTop * SFVEC3F( posYfactor )
+                                 + m_backgroundColorBottom * ( SFVEC3F( 1.0f ) - posYfactor );
+        GLubyte       bgColor[4];
+
+        renderFinalColor( bgColor, bgLinear, true );
+
+        for( int x = 0; x < aSize.x; ++x )
+        {
+            const int bufferX = x - (int) m_xoffset;
+            const GLubyte* src = bgColor;
+
+            if( bufferX >= 0 && bufferX < (int) m_realBufferSize.x
+                    && bufferY >= 0 && bufferY < (int) m_realBufferSize.y )
+            {
+                src = &buffer[( (size_t) bufferY * m_realBufferSize.x + bufferX ) * 4];
+            }
+
+            *dst++ = src[0];
+            *dst++ = src[1];
+            *dst++ = src[2];
+        }
+    }
+
+    return true;
+}
+
+
 void RENDER_3D_RAYTRACE::renderFinalColor( GLubyte* ptrPBO, const SFVEC3F& rgbColor,
                                          bool applyColorSpaceConversion )
 {
@@ -1807,6 +1881,10 @@ void RENDER_3D_RAYTRACE::initializeNewWindowSize()
 
 void RENDER_3D_RAYTRACE::initPbo()
 {
+    // There is no OpenGL context when rendering off-screen, see RenderToImage()
+    if( !m_canvas )
+        return;
+
     if( GLEW_ARB_pixel_buffer_object )
     {
         m_openglSupportsVertexBufferObjects = true;
@@ -36,6 +36,8 @@
 
 #include <map>
 
+class wxImage;
+
 /// Vector of materials
 typedef std::vector< BLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 
@@ -73,6 +75,17 @@ public:
 
     BOARD_ITEM *IntersectBoardItem( const RAY& aRay );
 
+    /**
+     * Trace the scene into \a aImage, without the need of an OpenGL canvas.
+     *
+     * Used to render boards from the command line.  The renderer must have been created
+     * without a canvas and Reload() must have been called.  The image is traced and post
+     * processed in full before returning.
+     *
+     * @return false if the scene could not be rendered at this size.
+     */
+    bool RenderToImage( const wxSize& aSize, wxImage& aImage, REPORTER* aStatusReporter );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
@@ -217,6 +217,8 @@ static const wxChar EnableGenerators[] = wxT( "EnableGenerators" );
 
 static const wxChar EnableGit[] = wxT( "EnableGit" );
 
+static const wxChar UndoMemoryBudget[] = wxT( "UndoMemoryBudget" );
+
 /**
  * The time in milliseconds to wait before displaying a disambiguation menu.
  */
@@ -360,6 +362,8 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_DisambiguationMenuDelay   = 500;
 
+    m_UndoMemoryBudget          = 1024;
+
     loadFromConfigFile();
 }
 
@@ -524,6 +528,10 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::EnableGit,
                                                 &m_EnableGit, m_EnableGit ) );
 
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::UndoMemoryBudget,
+                                               &m_UndoMemoryBudget, m_UndoMemoryBudget,
+                                               0, 65536 ) );
+
 
 
     // Special case for trace mask setting...we just grab them and set them immediately
@@ -166,6 +166,10 @@ void COMMIT::makeEntry( EDA_ITEM* aItem, CHANGE_TYPE aType, EDA_ITEM* aCopy, BAS
 
 COMMIT::COMMIT_LINE* COMMIT::findEntry( EDA_ITEM* aItem, BASE_SCREEN *aScreen )
 {
+    // Every entry is also in m_changedItems; avoid walking a long commit for unchanged items
+    if( m_changedItems.find( aItem ) == m_changedItems.end() )
+        return nullptr;
+
     for( COMMIT_LINE& change : m_changes )
     {
         if( change.m_item == aItem && change.m_screen == aScreen )
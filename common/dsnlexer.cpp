@@ -23,11 +23,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <array>
 #include <charconv>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>         // bsearch()
 #include <cctype>
+#include <limits>
+#include <locale>
+#include <sstream>
 
 #include <dsnlexer.h>
 #include <wx/translation.h>
@@ -417,30 +421,40 @@ int DSNLEXER::NeedNUMBER( const char* aExpectation )
 }
 
 
+/// Character classes of the tokenizer, looked up by s_charClasses
+enum CHAR_CLASS : uint8_t
+{
+    CC_SPACE = 0x01,    ///< whitespace
+    CC_SEP   = 0x02     ///< ends an unquoted token: whitespace or a parenthesis
+};
+
+
+static constexpr std::array<uint8_t, 256> makeCharClasses()
+{
+    std::array<uint8_t, 256> classes{};
+
+    // Our whitespace, by our definition, is a subset of ASCII, i.e. no bytes with MSB on can be
+    // considered whitespace, since they are likely part of a multibyte UTF8 character.
+    for( unsigned char cc : { ' ', '\n', '\r', '\t', '\0' } )   // PCAD s-expression files have \0
+        classes[cc] = CC_SPACE | CC_SEP;
+
+    classes['('] = CC_SEP;
+    classes[')'] = CC_SEP;
+
+    return classes;
+}
+
+
+/// One lookup per character instead of a chain of compares in the tokenizer's inner loops
+static constexpr std::array<uint8_t, 256> s_charClasses = makeCharClasses();
+
+
 /**
  * Test for whitespace.
- *
- * Our whitespace, by our definition, is a subset of ASCII, i.e. no bytes with MSB on can be
- * considered whitespace, since they are likely part of a multibyte UTF8 character.
  */
-static bool isSpace( char cc )
+static inline bool isSpace( char cc )
 {
-    // cc is signed, so it is often negative.
-    // Treat negative as large positive to exclude rapidly.
-    if( (unsigned char) cc <= ' ' )
-    {
-        switch( (unsigned char) cc )
-        {
-        case ' ':
-        case '\n':
-        case '\r':
-        case '\t':
-        case '\0':              // PCAD s-expression files have this.
-            return true;
-        }
-    }
-
-    return false;
+    return s_charClasses[(unsigned char) cc] & CC_SPACE;
 }
 
 
@@ -453,7 +467,7 @@ inline bool isDigit( char cc )
 ///< @return true if @a cc is an s-expression separator character.
 inline bool isSep( char cc )
 {
-    return isSpace( cc ) || cc=='(' || cc==')';
+    return s_charClasses[(unsigned char) cc] & CC_SEP;
 }
 
 
@@ -688,7 +702,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // Copy the run of plain characters up to the next escape or delimiter
+                    const char* run = head;
+
+                    while( head < limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -769,13 +791,14 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
+
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
 
-    if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
+    curText.assign( cur, head );
+
+    if( isNumber( cur, head ) )
     {
         curTok = DSN_NUMBER;
         goto exit;
@@ -828,28 +851,43 @@ double DSNLEXER::parseDouble()
     // GCC older than 11 "supports" C++17 without supporting the C++17 std::from_chars for doubles
     // clang is similar
 
-    char* tmp;
+    // strtod() would follow the global C locale, so read through a stream pinned to the
+    // classic locale instead; this keeps the parser safe to run alongside other threads
+    const std::string& str = CurStr();
+    size_t             woff = 0;
 
-    errno = 0;
+    while( woff < str.length() && std::isspace( (unsigned char) str[woff] ) )
+        woff++;
 
-    double fval = strtod( CurText(), &tmp );
+    // Unlike strtod() and std::from_chars(), streams don't read infinities and NaNs
+    bool        negative = woff < str.length() && str[woff] == '-';
+    std::string word;
 
-    if( errno )
-    {
-        wxString error;
-        error.Printf( _( "Invalid floating point number in\nfile: '%s'\nline: %d\noffset: %d" ),
-                      CurSource(), CurLineNumber(), CurOffset() );
+    if( woff < str.length() && ( str[woff] == '-' || str[woff] == '+' ) )
+        woff++;
 
-        THROW_IO_ERROR( error );
-    }
+    for( size_t ii = woff; ii < str.length(); ++ii )
+        word += (char) std::tolower( (unsigned char) str[ii] );
 
-    if( CurText() == tmp )
+    if( word == "inf" || word == "infinity" )
     {
-        wxString error;
-        error.Printf( _( "Missing floating point number in\nfile: '%s'\nline: %d\noffset: %d" ),
-                      CurSource(), CurLineNumber(), CurOffset() );
+        return negative ? -std::numeric_limits<double>::infinity()
+                        : std::numeric_limits<double>::infinity();
+    }
+
+    if( word == "nan" || word.compare( 0, 4, "nan(" ) == 0 )
+        return std::numeric_limits<double>::quiet_NaN();
+
+    std::istringstream stream( str );
+    stream.imbue( std::locale::classic() );
 
-        THROW_IO_ERROR( error );
+    double fval = 0.0;
+    stream >> fval;
+
+    if( stream.fail() )
+    {
+        THROW_PARSE_ERROR( _( "Invalid floating point number" ), CurSource(), CurLine(),
+                           CurLineNumber(), CurOffset() );
     }
 
     return fval;
@@ -860,7 +898,7 @@ double DSNLEXER::parseDouble()
 
     // Offset any leading whitespace, this is one thing from_chars does not handle
     size_t woff = 0;
-    while( std::isspace( str[woff] ) && woff < str.length() )
+    while( woff < str.length() && std::isspace( str[woff] ) )
     {
         woff++;
     }
@@ -124,15 +124,8 @@ EDA_TEXT::EDA_TEXT( const EDA_TEXT& aText ) :
     m_render_cache_angle = aText.m_render_cache_angle;
     m_render_cache_offset = aText.m_render_cache_offset;
 
-    m_render_cache.clear();
-
-    for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aText.m_render_cache )
-    {
-        if( KIFONT::OUTLINE_GLYPH* outline = dynamic_cast<KIFONT::OUTLINE_GLYPH*>( glyph.get() ) )
-            m_render_cache.emplace_back( std::make_unique<KIFONT::OUTLINE_GLYPH>( *outline ) );
-        else if( KIFONT::STROKE_GLYPH* stroke = dynamic_cast<KIFONT::STROKE_GLYPH*>( glyph.get() ) )
-            m_render_cache.emplace_back( std::make_unique<KIFONT::STROKE_GLYPH>( *stroke ) );
-    }
+    m_render_cache = aText.m_render_cache;
+    m_render_cache_pos = aText.m_render_cache_pos;
 
     m_bounding_box_cache_valid = aText.m_bounding_box_cache_valid;
     m_bounding_box_cache = aText.m_bounding_box_cache;
@@ -160,15 +153,8 @@ EDA_TEXT& EDA_TEXT::operator=( const EDA_TEXT& aText )
     m_render_cache_angle = aText.m_render_cache_angle;
     m_render_cache_offset = aText.m_render_cache_offset;
 
-    m_render_cache.clear();
-
-    for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aText.m_render_cache )
-    {
-        if( KIFONT::OUTLINE_GLYPH* outline = dynamic_cast<KIFONT::OUTLINE_GLYPH*>( glyph.get() ) )
-            m_render_cache.emplace_back( std::make_unique<KIFONT::OUTLINE_GLYPH>( *outline ) );
-        else if( KIFONT::STROKE_GLYPH* stroke = dynamic_cast<KIFONT::STROKE_GLYPH*>( glyph.get() ) )
-            m_render_cache.emplace_back( std::make_unique<KIFONT::STROKE_GLYPH>( *stroke ) );
-    }
+    m_render_cache = aText.m_render_cache;
+    m_render_cache_pos = aText.m_render_cache_pos;
 
     m_bounding_box_cache_valid = aText.m_bounding_box_cache_valid;
     m_bounding_box_cache = aText.m_bounding_box_cache;
@@ -419,14 +405,7 @@ void EDA_TEXT::Offset( const VECTOR2I& aOffset )
         return;
 
     m_pos += aOffset;
-
-    for( std::unique_ptr<KIFONT::GLYPH>& glyph : m_render_cache )
-    {
-        if( KIFONT::OUTLINE_GLYPH* outline = dynamic_cast<KIFONT::OUTLINE_GLYPH*>( glyph.get() ) )
-            outline->Move( aOffset );
-        else if( KIFONT::STROKE_GLYPH* stroke = dynamic_cast<KIFONT::STROKE_GLYPH*>( glyph.get() ) )
-            glyph = stroke->Transform( { 1.0, 1.0 }, aOffset, 0, ANGLE_0, false, { 0, 0 } );
-    }
+    m_render_cache_pos += aOffset;
 
     m_bounding_box_cache_valid = false;
 }
@@ -477,7 +456,7 @@ const KIFONT::METRICS& EDA_TEXT::getFontMetrics() const
 
 void EDA_TEXT::ClearRenderCache()
 {
-    m_render_cache.clear();
+    m_render_cache.reset();
 }
 
 
@@ -487,36 +466,36 @@ void EDA_TEXT::ClearBoundingBoxCache()
 }
 
 
-std::vector<std::unique_ptr<KIFONT::GLYPH>>*
+const KIFONT::GLYPH_RUN*
 EDA_TEXT::GetRenderCache( const KIFONT::FONT* aFont, const wxString& forResolvedText,
-                          const VECTOR2I& aOffset ) const
+                          VECTOR2I& aRunPosition, const VECTOR2I& aOffset ) const
 {
     if( aFont->IsOutline() )
     {
         EDA_ANGLE resolvedAngle = GetDrawRotation();
 
-        if( m_render_cache.empty()
+        if( !m_render_cache
                 || m_render_cache_font != aFont
                 || m_render_cache_text != forResolvedText
                 || m_render_cache_angle != resolvedAngle
                 || m_render_cache_offset != aOffset )
         {
-            m_render_cache.clear();
-
             const KIFONT::OUTLINE_FONT* font = static_cast<const KIFONT::OUTLINE_FONT*>( aFont );
             TEXT_ATTRIBUTES             attrs = GetAttributes();
 
             attrs.m_Angle = resolvedAngle;
 
-            font->GetLinesAsGlyphs( &m_render_cache, forResolvedText, GetDrawPos() + aOffset,
-                                    attrs, getFontMetrics() );
+            m_render_cache = KIFONT::GLYPH_CACHE::Get().GetRun( font, forResolvedText, attrs,
+                                                                getFontMetrics() );
+            m_render_cache_pos = GetDrawPos() + aOffset;
             m_render_cache_font = aFont;
             m_render_cache_angle = resolvedAngle;
             m_render_cache_text = forResolvedText;
             m_render_cache_offset = aOffset;
         }
 
-        return &m_render_cache;
+        aRunPosition = m_render_cache_pos;
+        return m_render_cache.get();
     }
 
     return nullptr;
@@ -525,15 +504,26 @@ EDA_TEXT::GetRenderCache( const KIFONT::FONT* aFont, const wxString& forResolved
 
 void EDA_TEXT::SetupRenderCache( const wxString& aResolvedText, const EDA_ANGLE& aAngle )
 {
+    // A cache read from disk is in board coordinates and belongs to this text alone
     m_render_cache_text = aResolvedText;
     m_render_cache_angle = aAngle;
-    m_render_cache.clear();
+    m_render_cache = std::make_shared<KIFONT::GLYPH_RUN>();
+    m_render_cache_pos = VECTOR2I( 0, 0 );
 }
 
 
 void EDA_TEXT::AddRenderCacheGlyph( const SHAPE_POLY_SET& aPoly )
 {
-    m_render_cache.emplace_back( std::make_unique<KIFONT::OUTLINE_GLYPH>( aPoly ) );
+    wxCHECK( m_render_cache, /* void */ );
+
+    // Only ever called on the private run made by SetupRenderCache()
+    KIFONT::GLYPH_RUN* run = const_cast<KIFONT::GLYPH_RUN*>( m_render_cache.get() );
+
+    std::unique_ptr<KIFONT::OUTLINE_GLYPH> glyph = std::make_unique<KIFONT::OUTLINE_GLYPH>( aPoly );
+
+    // Glyphs are read-only once drawn, so they must be triangulated up front
+    glyph->CacheTriangulation( false );
+    run->emplace_back( std::move( glyph ) );
 }
 
 
@@ -917,7 +907,9 @@ std::shared_ptr<SHAPE_COMPOUND> EDA_TEXT::GetEffectiveTextShape( bool aTriangula
     VECTOR2I                        drawPos = GetDrawPos();
     TEXT_ATTRIBUTES                 attrs = GetAttributes();
 
-    std::vector<std::unique_ptr<KIFONT::GLYPH>>* cache = nullptr;
+    // Cached glyphs are laid out at the origin and must be moved to cachePos
+    const KIFONT::GLYPH_RUN* cache = nullptr;
+    VECTOR2I                 cachePos;
 
     if( aBBox.GetWidth() )
     {
@@ -931,7 +923,7 @@ std::shared_ptr<SHAPE_COMPOUND> EDA_TEXT::GetEffectiveTextShape( bool aTriangula
         attrs.m_Angle = GetDrawRotation();
 
         if( font->IsOutline() )
-            cache = GetRenderCache( font, shownText, VECTOR2I() );
+            cache = GetRenderCache( font, shownText, cachePos );
     }
 
     if( aTriangulate )
@@ -941,7 +933,8 @@ std::shared_ptr<SHAPE_COMPOUND> EDA_TEXT::GetEffectiveTextShape( bool aTriangula
                 // Stroke callback
                 [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2 )
                 {
-                    shape->AddShape( new SHAPE_SEGMENT( aPt1, aPt2, penWidth ) );
+                    shape->AddShape( new SHAPE_SEGMENT( aPt1 + cachePos, aPt2 + cachePos,
+                                                        penWidth ) );
                 },
                 // Triangulation callback
                 [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2, const VECTOR2I& aPt3 )
@@ -949,7 +942,7 @@ std::shared_ptr<SHAPE_COMPOUND> EDA_TEXT::GetEffectiveTextShape( bool aTriangula
                     SHAPE_SIMPLE* triShape = new SHAPE_SIMPLE;
 
                     for( const VECTOR2I& point : { aPt1, aPt2, aPt3 } )
-                        triShape->Append( point.x, point.y );
+                        triShape->Append( point.x + cachePos.x, point.y + cachePos.y );
 
                     shape->AddShape( triShape );
                 } );
@@ -966,12 +959,16 @@ std::shared_ptr<SHAPE_COMPOUND> EDA_TEXT::GetEffectiveTextShape( bool aTriangula
                 // Stroke callback
                 [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2 )
                 {
-                    shape->AddShape( new SHAPE_SEGMENT( aPt1, aPt2, penWidth ) );
+                    shape->AddShape( new SHAPE_SEGMENT( aPt1 + cachePos, aPt2 + cachePos,
+                                                        penWidth ) );
                 },
                 // Outline callback
                 [&]( const SHAPE_LINE_CHAIN& aPoly )
                 {
-                    shape->AddShape( aPoly.Clone() );
+                    SHAPE_LINE_CHAIN* poly = static_cast<SHAPE_LINE_CHAIN*>( aPoly.Clone() );
+
+                    poly->Move( cachePos );
+                    shape->AddShape( poly );
                 } );
 
         if( cache )
@@ -26,6 +26,7 @@
 #include <math/util.h>      // for KiROUND
 #include <macros.h>
 #include <charconv>
+#include <cstdint>
 #include <wx/translation.h>
 
 bool EDA_UNIT_UTILS::IsImperialUnit( EDA_UNITS aUnit )
@@ -141,35 +142,110 @@ std::string EDA_UNIT_UTILS::FormatAngle( const EDA_ANGLE& aAngle )
 }
 
 
-std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+/**
+ * Return the number of decimal places of a millimetre expressed in internal units, or -1 if
+ * \a aIuPerMm is not a power of ten.
+ */
+static int iuDecimalPlaces( double aIuPerMm )
 {
-    std::string buf;
-    double engUnits = aValue;
+    double pow10 = 1.0;
+
+    for( int places = 0; places <= 9; ++places, pow10 *= 10.0 )
+    {
+        if( aIuPerMm == pow10 )
+            return places;
+    }
 
-    engUnits /= aIuScale.IU_PER_MM;
+    return -1;
+}
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+
+/**
+ * Append \a aValue to \a aOut in millimetres.
+ *
+ * All the internal unit scales are a power of ten of a millimetre, so the value is written as
+ * an exact decimal straight from the integer.  An int has at most 10 significant digits, so
+ * this gives the same text as the floating point formatting below, which is only kept for
+ * other scales.
+ */
+static void formatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue, std::string& aOut )
+{
+    int places = iuDecimalPlaces( aIuScale.IU_PER_MM );
+
+    if( places < 0 )
     {
-        buf = fmt::format( "{:.10f}", engUnits );
+        double engUnits = aValue;
+
+        engUnits /= aIuScale.IU_PER_MM;
 
-        // remove trailing zeros
-        while( !buf.empty() && buf[buf.size() - 1] == '0' )
+        if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
         {
-            buf.pop_back();
+            std::string buf = fmt::format( "{:.10f}", engUnits );
+
+            // remove trailing zeros
+            while( !buf.empty() && buf[buf.size() - 1] == '0' )
+            {
+                buf.pop_back();
+            }
+
+            // if the value was really small
+            // we may have just stripped all the zeros after the decimal
+            if( buf[buf.size() - 1] == '.' )
+            {
+                buf.pop_back();
+            }
+
+            aOut += buf;
         }
-
-        // if the value was really small
-        // we may have just stripped all the zeros after the decimal
-        if( buf[buf.size() - 1] == '.' )
+        else
         {
-            buf.pop_back();
+            aOut += fmt::format( "{:.10g}", engUnits );
         }
+
+        return;
     }
-    else
+
+    uint64_t divisor = 1;
+
+    for( int ii = 0; ii < places; ++ii )
+        divisor *= 10;
+
+    // Widen before negating so INT_MIN is handled
+    int64_t  value = aValue;
+    uint64_t magnitude = value < 0 ? -value : value;
+    uint64_t integer = magnitude / divisor;
+    uint64_t fraction = magnitude % divisor;
+    char     buf[32];
+
+    if( value < 0 )
+        aOut += '-';
+
+    char* end = std::to_chars( buf, buf + sizeof( buf ), integer ).ptr;
+    aOut.append( buf, end );
+
+    if( fraction )
     {
-        buf = fmt::format( "{:.10g}", engUnits );
+        // Drop the trailing zeros, then left-pad what remains to its number of places
+        while( fraction % 10 == 0 )
+        {
+            fraction /= 10;
+            places--;
+        }
+
+        end = std::to_chars( buf, buf + sizeof( buf ), fraction ).ptr;
+
+        aOut += '.';
+        aOut.append( places - ( end - buf ), '0' );
+        aOut.append( buf, end );
     }
+}
+
 
+std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    std::string buf;
+
+    formatInternalUnits( aIuScale, aValue, buf );
     return buf;
 }
 
@@ -177,8 +253,12 @@ std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, i
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                  const VECTOR2I&     aPoint )
 {
-    return FormatInternalUnits( aIuScale, aPoint.x ) + " "
-           + FormatInternalUnits( aIuScale, aPoint.y );
+    std::string buf;
+
+    formatInternalUnits( aIuScale, aPoint.x, buf );
+    buf += ' ';
+    formatInternalUnits( aIuScale, aPoint.y, buf );
+    return buf;
 }
 
 
@@ -124,6 +124,7 @@ void OUTLINE_GLYPH::Triangulate( std::function<void( const VECTOR2I& aPt1,
 {
     // Only call CacheTriangulation if it has never been done before.  Otherwise we'll hash
     // the triangulation to see if it has been edited, and glyphs after creation are read-only.
+    // Glyphs shared through the GLYPH_CACHE are triangulated before they are published.
     if( TriangulatedPolyCount() == 0 )
         const_cast<OUTLINE_GLYPH*>( this )->CacheTriangulation( false );
 
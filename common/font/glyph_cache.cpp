@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KICAD, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 Kicad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <font/glyph_cache.h>
+#include <font/outline_font.h>
+#include <hash.h>
+
+using namespace KIFONT;
+
+
+GLYPH_CACHE& GLYPH_CACHE::Get()
+{
+    static GLYPH_CACHE s_cache;
+    return s_cache;
+}
+
+
+bool GLYPH_CACHE::KEY::operator==( const KEY& aOther ) const
+{
+    return m_font == aOther.m_font
+            && m_interlinePitch == aOther.m_interlinePitch
+            && m_overbarHeight == aOther.m_overbarHeight
+            && m_underlineOffset == aOther.m_underlineOffset
+            && m_attrs == aOther.m_attrs
+            && m_text == aOther.m_text;
+}
+
+
+size_t GLYPH_CACHE::KEY_HASH::operator()( const KEY& aKey ) const
+{
+    return hash_val( aKey.m_font, aKey.m_text, aKey.m_attrs, aKey.m_interlinePitch,
+                     aKey.m_overbarHeight, aKey.m_underlineOffset );
+}
+
+
+std::shared_ptr<const GLYPH_RUN> GLYPH_CACHE::GetRun( const OUTLINE_FONT* aFont,
+                                                      const wxString& aText,
+                                                      const TEXT_ATTRIBUTES& aAttrs,
+                                                      const METRICS& aFontMetrics )
+{
+    KEY key{ aFont, aText, aAttrs, aFontMetrics.m_InterlinePitch, aFontMetrics.m_OverbarHeight,
+             aFontMetrics.m_UnderlineOffset };
+
+    // Colour and visibility don't change the glyphs; don't let them split the cache
+    key.m_attrs.m_Font = const_cast<OUTLINE_FONT*>( aFont );
+    key.m_attrs.m_Color = KIGFX::COLOR4D::UNSPECIFIED;
+    key.m_attrs.m_Visible = true;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_runs.find( key );
+
+        if( it != m_runs.end() )
+        {
+            m_lru.splice( m_lru.begin(), m_lru, it->second.m_lruPos );
+            m_stats.m_Hits++;
+            return it->second.m_run;
+        }
+    }
+
+    // Build outside the lock; the font serializes its own FreeType access.
+    std::shared_ptr<GLYPH_RUN> run = std::make_shared<GLYPH_RUN>();
+
+    aFont->GetLinesAsGlyphs( run.get(), aText, VECTOR2I( 0, 0 ), key.m_attrs, aFontMetrics );
+
+    // Shared glyphs are read-only, so triangulate them before anybody else can see them (and
+    // after the font has released its lock, so other texts aren't held up by this)
+    for( const std::unique_ptr<GLYPH>& glyph : *run )
+    {
+        if( glyph->IsOutline() )
+            static_cast<OUTLINE_GLYPH*>( glyph.get() )->CacheTriangulation( false );
+    }
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    // If another thread got there first, use its run so the two texts share it
+    auto [it, inserted] = m_runs.emplace( std::move( key ), ENTRY{ std::move( run ), {} } );
+
+    if( !inserted )
+    {
+        m_lru.splice( m_lru.begin(), m_lru, it->second.m_lruPos );
+        m_stats.m_Hits++;
+        return it->second.m_run;
+    }
+
+    std::shared_ptr<const GLYPH_RUN> result = it->second.m_run;
+
+    m_stats.m_Misses++;
+    m_lru.push_front( &it->first );
+    it->second.m_lruPos = m_lru.begin();
+
+    while( m_runs.size() > m_maxRuns )
+    {
+        m_runs.erase( *m_lru.back() );
+        m_lru.pop_back();
+        m_stats.m_Evictions++;
+    }
+
+    return result;
+}
+
+
+void GLYPH_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_lru.clear();
+    m_runs.clear();
+}
+
+
+size_t GLYPH_CACHE::Size() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_runs.size();
+}
+
+
+GLYPH_CACHE::STATS GLYPH_CACHE::GetStats() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_stats;
+}
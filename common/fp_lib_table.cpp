@@ -317,6 +317,14 @@ void FP_LIB_TABLE::PrefetchLib( const wxString& aNickname )
 }
 
 
+bool FP_LIB_TABLE::IsLocaleIndependent( const wxString& aNickname ) const
+{
+    const FP_LIB_TABLE_ROW* row = dynamic_cast<const FP_LIB_TABLE_ROW*>( findRow( aNickname ) );
+
+    return row && row->type == IO_MGR::KICAD_SEXP;
+}
+
+
 const FP_LIB_TABLE_ROW* FP_LIB_TABLE::FindRow( const wxString& aNickname, bool aCheckIfEnabled )
 {
     // Do not optimize this code.  Is done this way specifically to fix a runtime
@@ -39,6 +39,7 @@ JOB_EXPORT_PCB_3D::JOB_EXPORT_PCB_3D( bool aIsCli ) :
     m_BoardOutlinesChainingEpsilon( 0.01 ),     // 0.01 mm is a good value
     m_exportTracks( false ),     // Extremely time consuming if true
     m_exportZones( false ),      // Extremely time consuming if true
+    m_fastBoardHoles( false ),
     m_format( JOB_EXPORT_PCB_3D::FORMAT::UNKNOWN ),
     m_vrmlUnits( JOB_EXPORT_PCB_3D::VRML_UNITS::METERS ),
     m_vrmlModelDir( wxEmptyString ),
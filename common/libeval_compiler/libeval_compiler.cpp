@@ -22,6 +22,7 @@
 #include <set>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 
 #include <eda_units.h>
 #include <string_utils.h>
@@ -180,10 +181,78 @@ wxString UOP::Format() const
 
 UCODE::~UCODE()
 {
-    for ( auto op : m_ucode )
+}
+
+
+void UCODE::AddOp( UOP* uop )
+{
+    m_ucode.push_back( std::move( *uop ) );
+    delete uop;
+}
+
+
+void UCODE::FoldConstants()
+{
+    auto isNumericConstant =
+            []( const UOP& aOp )
+            {
+                return aOp.GetConstant() && aOp.GetConstant()->GetType() == VT_NUMERIC;
+            };
+
+    std::vector<UOP> folded;
+    folded.reserve( m_ucode.size() );
+
+    for( UOP& op : m_ucode )
     {
-        delete op;
+        int operands = 0;
+
+        if( op.GetOp() & TR_OP_BINARY_MASK )
+            operands = 2;
+        else if( op.GetOp() & TR_OP_UNARY_MASK )
+            operands = 1;
+
+        // The program is in postfix order, so when the ops immediately preceding an operator
+        // are all constants they are exactly its operands.
+        bool foldable = operands > 0 && (int) folded.size() >= operands;
+
+        for( int ii = 0; foldable && ii < operands; ++ii )
+            foldable = isNumericConstant( folded[folded.size() - 1 - ii] );
+
+        if( !foldable )
+        {
+            folded.push_back( std::move( op ) );
+            continue;
+        }
+
+        // Run the operator itself so that folding can never disagree with evaluation
+        CONTEXT ctx;
+        bool    failed = false;
+
+        ctx.SetErrorCallback(
+                [&]( const wxString& aMessage, int aOffset )
+                {
+                    failed = true;
+                } );
+
+        for( int ii = operands; ii > 0; --ii )
+            ctx.Push( const_cast<VALUE*>( folded[folded.size() - ii].GetConstant() ) );
+
+        op.Exec( &ctx );
+        double result = ctx.Pop()->AsDouble();
+
+        // Leave an operator which reports an error or has no finite result (e.g. a division by
+        // zero) to be evaluated, so that it still behaves and reports exactly as it did before.
+        if( failed || !std::isfinite( result ) )
+        {
+            folded.push_back( std::move( op ) );
+            continue;
+        }
+
+        folded.resize( folded.size() - operands );
+        folded.emplace_back( TR_UOP_PUSH_VALUE, std::make_unique<VALUE>( result ) );
     }
+
+    m_ucode = std::move( folded );
 }
 
 
@@ -191,9 +260,9 @@ wxString UCODE::Dump() const
 {
     wxString rv;
 
-    for( auto op : m_ucode )
+    for( const UOP& op : m_ucode )
     {
-        rv += op->Format();
+        rv += op.Format();
         rv += "\n";
     }
 
@@ -674,6 +743,73 @@ void dumpNode( wxString& buf, TREE_NODE* tok, int depth = 0 )
 }
 
 
+/**
+ * Per-thread free list of values released by destroyed contexts.
+ */
+struct VALUE_POOL
+{
+    ~VALUE_POOL()
+    {
+        for( VALUE* value : m_free )
+            delete value;
+    }
+
+    static constexpr size_t MAX_FREE = 1024;
+
+    std::vector<VALUE*> m_free;
+};
+
+
+static thread_local VALUE_POOL s_valuePool;
+
+
+CONTEXT::~CONTEXT()
+{
+    while( m_pooledValues )
+    {
+        VALUE* value = m_pooledValues;
+        m_pooledValues = value->m_nextOwned;
+
+        if( s_valuePool.m_free.size() < VALUE_POOL::MAX_FREE )
+        {
+            value->Reset();
+            s_valuePool.m_free.push_back( value );
+        }
+        else
+        {
+            delete value;
+        }
+    }
+
+    while( m_storedValues )
+    {
+        VALUE* value = m_storedValues;
+        m_storedValues = value->m_nextOwned;
+        delete value;
+    }
+}
+
+
+VALUE* CONTEXT::AllocValue()
+{
+    VALUE* value;
+
+    if( s_valuePool.m_free.empty() )
+    {
+        value = new VALUE;
+    }
+    else
+    {
+        value = s_valuePool.m_free.back();
+        s_valuePool.m_free.pop_back();
+    }
+
+    value->m_nextOwned = m_pooledValues;
+    m_pooledValues = value;
+    return value;
+}
+
+
 void CONTEXT::ReportError( const wxString& aErrorMsg )
 {
     if( m_errorCallback )
@@ -1106,6 +1242,8 @@ bool COMPILER::generateUCode( UCODE* aCode, CONTEXT* aPreflightContext )
         stack.pop_back();
     }
 
+    aCode->FoldConstants();
+
     libeval_dbg(2,"dump: \n%s\n", aCode->Dump().c_str() );
 
     return true;
@@ -1118,14 +1256,7 @@ void UOP::Exec( CONTEXT* ctx )
     {
     case TR_UOP_PUSH_VAR:
     {
-        VALUE* value = nullptr;
-
-        if( m_ref )
-            value = ctx->StoreValue( m_ref->GetValue( ctx ) );
-        else
-            value = ctx->AllocValue();
-
-        ctx->Push( value );
+        ctx->Push( m_ref ? m_ref->GetValue( ctx ) : ctx->AllocValue() );
     }
         break;
 
@@ -1253,8 +1384,8 @@ VALUE* UCODE::Run( CONTEXT* ctx )
 
     try
     {
-        for( UOP* op : m_ucode )
-            op->Exec( ctx );
+        for( UOP& op : m_ucode )
+            op.Exec( ctx );
     }
     catch(...)
     {
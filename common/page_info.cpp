@@ -28,6 +28,7 @@
 #include <macros.h>
 #include <eda_units.h>
 #include <richio.h>         // for OUTPUTFORMATTER and IO_ERROR
+#include <fmt/core.h>
 
 
 // late arriving wxPAPER_A0, wxPAPER_A1
@@ -278,9 +279,9 @@ void PAGE_INFO::Format( OUTPUTFORMATTER* aFormatter, int aNestLevel, int aContro
     // The page dimensions are only required for user defined page sizes.
     // Internally, the page size is in mils
     if( GetType() == PAGE_INFO::Custom )
-        aFormatter->Print( 0, " %g %g",
-                           GetWidthMils() * 25.4 / 1000.0,
-                           GetHeightMils() * 25.4 / 1000.0 );
+        aFormatter->Print( 0, " %s %s",
+                           fmt::format( "{:g}", GetWidthMils() * 25.4 / 1000.0 ).c_str(),
+                           fmt::format( "{:g}", GetHeightMils() * 25.4 / 1000.0 ).c_str() );
 
     if( !IsCustom() && IsPortrait() )
         aFormatter->Print( 0, " portrait" );
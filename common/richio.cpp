@@ -23,7 +23,9 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <kiplatform/io.h>
@@ -188,9 +190,13 @@ void LINE_READER::expandCapacity( unsigned aNewsize )
 }
 
 
+/// Size of the blocks FILE_LINE_READER reads its own files in
+static const size_t FILE_READ_BLOCK_SIZE = 64 * 1024;
+
+
 FILE_LINE_READER::FILE_LINE_READER( const wxString& aFileName, unsigned aStartingLineNumber,
                                     unsigned aMaxLineLength ):
-    LINE_READER( aMaxLineLength ), m_iOwn( true )
+    LINE_READER( aMaxLineLength ), m_iOwn( true ), m_bufferPos( 0 ), m_bufferLen( 0 )
 {
     m_fp = KIPLATFORM::IO::SeqFOpen( aFileName, wxT( "rt" ) );
 
@@ -203,6 +209,7 @@ FILE_LINE_READER::FILE_LINE_READER( const wxString& aFileName, unsigned aStartin
 
     m_source  = aFileName;
     m_lineNum = aStartingLineNumber;
+    m_buffer.resize( FILE_READ_BLOCK_SIZE );
 }
 
 
@@ -210,10 +217,14 @@ FILE_LINE_READER::FILE_LINE_READER( FILE* aFile, const wxString& aFileName,
                     bool doOwn,
                     unsigned aStartingLineNumber,
                     unsigned aMaxLineLength ) :
-    LINE_READER( aMaxLineLength ), m_iOwn( doOwn ), m_fp( aFile )
+    LINE_READER( aMaxLineLength ), m_iOwn( doOwn ), m_fp( aFile ), m_bufferPos( 0 ),
+    m_bufferLen( 0 )
 {
     m_source  = aFileName;
     m_lineNum = aStartingLineNumber;
+
+    if( m_iOwn )
+        m_buffer.resize( FILE_READ_BLOCK_SIZE );
 }
 
 
@@ -229,6 +240,7 @@ long int FILE_LINE_READER::FileLength()
     fseek( m_fp, 0, SEEK_END );
     long int fileLength = ftell( m_fp );
     rewind( m_fp );
+    m_bufferPos = m_bufferLen = 0;
 
     return fileLength;
 }
@@ -236,7 +248,8 @@ long int FILE_LINE_READER::FileLength()
 
 long int FILE_LINE_READER::CurPos()
 {
-    return ftell( m_fp );
+    // Don't count what has been read ahead but not returned yet
+    return ftell( m_fp ) - (long int) ( m_bufferLen - m_bufferPos );
 }
 
 
@@ -244,24 +257,64 @@ char* FILE_LINE_READER::ReadLine()
 {
     m_length = 0;
 
-    for( ;; )
+    if( !m_buffer.empty() )
     {
-        if( m_length >= m_maxLineLength )
-            THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+        // Our own file: read it in blocks and copy out a whole line at a time.  memchr() is
+        // vectorized by the C libraries, so this is much cheaper than a getc() per byte.
+        for( ;; )
+        {
+            if( m_bufferPos == m_bufferLen )
+            {
+                m_bufferLen = fread( m_buffer.data(), 1, m_buffer.size(), m_fp );
+                m_bufferPos = 0;
 
-        if( m_length >= m_capacity )
-            expandCapacity( m_capacity * 2 );
+                if( m_bufferLen == 0 )
+                    break;
+            }
 
-        // faster, POSIX compatible fgetc(), no locking.
-        int cc = getc_unlocked( m_fp );
+            const char* begin = m_buffer.data() + m_bufferPos;
+            size_t      avail = m_bufferLen - m_bufferPos;
+            const char* eol = static_cast<const char*>( memchr( begin, '\n', avail ) );
+            size_t      count = eol ? eol - begin + 1 : avail;
 
-        if( cc == EOF )
-            break;
+            if( m_length + count > m_maxLineLength )
+                THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
 
-        m_line[ m_length++ ] = (char) cc;
+            if( m_length + count >= m_capacity )
+            {
+                size_t newCapacity = std::max<size_t>( m_capacity * 2, m_length + count + 1 );
+                expandCapacity( (unsigned) newCapacity );
+            }
 
-        if( cc == '\n' )
-            break;
+            memcpy( m_line + m_length, begin, count );
+            m_length += count;
+            m_bufferPos += count;
+
+            if( eol )
+                break;
+        }
+    }
+    else
+    {
+        for( ;; )
+        {
+            if( m_length >= m_maxLineLength )
+                THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+            if( m_length >= m_capacity )
+                expandCapacity( m_capacity * 2 );
+
+            // faster, POSIX compatible fgetc(), no locking.
+            int cc = getc_unlocked( m_fp );
+
+            if( cc == EOF )
+                break;
+
+            m_line[ m_length++ ] = (char) cc;
+
+            if( cc == '\n' )
+                break;
+        }
     }
 
     m_line[ m_length ] = 0;
@@ -462,13 +515,17 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 
     va_start( args, fmt );
 
+    static const char spaces[] = "                                                  ";
+
     int result = 0;
     int total  = 0;
+    int indent = nestLevel * NESTWIDTH;
 
-    for( int i = 0; i < nestLevel; ++i )
+    while( total < indent )
     {
         // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        result = std::min<int>( indent - total, sizeof( spaces ) - 1 );
+        write( spaces, result );
 
         total += result;
     }
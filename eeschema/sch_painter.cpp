@@ -2219,15 +2219,19 @@ void SCH_PAINTER::draw( const SCH_TEXT* aText, int aLayer )
         }
         else
         {
-            std::vector<std::unique_ptr<KIFONT::GLYPH>>* cache = nullptr;
+            const KIFONT::GLYPH_RUN* cache = nullptr;
+            VECTOR2I                 cachePos;
 
             if( !aText->IsHypertext() && font->IsOutline() )
-                cache = aText->GetRenderCache( font, shownText, text_offset );
+                cache = aText->GetRenderCache( font, shownText, cachePos, text_offset );
 
             if( cache )
             {
                 m_gal->SetLineWidth( attrs.m_StrokeWidth );
+                m_gal->Save();
+                m_gal->Translate( cachePos );
                 m_gal->DrawGlyphs( *cache );
+                m_gal->Restore();
             }
             else
             {
@@ -2264,15 +2268,19 @@ void SCH_PAINTER::draw( const SCH_TEXTBOX* aTextBox, int aLayer )
                     attrs.m_Underlined = true;
                 }
 
-                std::vector<std::unique_ptr<KIFONT::GLYPH>>* cache = nullptr;
+                const KIFONT::GLYPH_RUN* cache = nullptr;
+                VECTOR2I                 cachePos;
 
                 if( !aTextBox->IsHypertext() && font->IsOutline() )
-                    cache = aTextBox->GetRenderCache( font, shownText );
+                    cache = aTextBox->GetRenderCache( font, shownText, cachePos );
 
                 if( cache )
                 {
                     m_gal->SetLineWidth( attrs.m_StrokeWidth );
+                    m_gal->Save();
+                    m_gal->Translate( cachePos );
                     m_gal->DrawGlyphs( *cache );
+                    m_gal->Restore();
                 }
                 else
                 {
@@ -19,13 +19,13 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fmt/core.h>
 #include <wx/log.h>
 #include <base_units.h>
 #include <lib_shape.h>
 #include <lib_symbol.h>
 #include <lib_text.h>
 #include <lib_textbox.h>
-#include <locale_io.h>
 #include <macros.h>
 #include <richio.h>
 #include "sch_sexpr_lib_plugin_cache.h"
@@ -59,10 +59,6 @@ void SCH_SEXPR_PLUGIN_CACHE::Load()
                  wxString::Format( "Cannot use relative file paths in sexpr plugin to "
                                    "open library '%s'.", m_libFileName.GetFullPath() ) );
 
-    // The current locale must use period as the decimal point.
-    // Yes, we did this earlier, but it's sadly not thread-safe.
-    LOCALE_IO toggle;
-
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
@@ -85,8 +81,6 @@ void SCH_SEXPR_PLUGIN_CACHE::Save( const std::optional<bool>& aOpt )
     if( !m_isModified )
         return;
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     // Write through symlinks, don't replace them.
     wxFileName fn = GetRealFile();
 
@@ -133,10 +127,6 @@ void SCH_SEXPR_PLUGIN_CACHE::SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& a
 {
     wxCHECK_RET( aSymbol, "Invalid LIB_SYMBOL pointer." );
 
-    // The current locale must use period as the decimal point.
-    wxCHECK2( wxLocale::GetInfo( wxLOCALE_DECIMAL_POINT, wxLOCALE_CAT_NUMBER ) == ".",
-              LOCALE_IO toggle );
-
     int nextFreeFieldId = MANDATORY_FIELDS;
     std::vector<LIB_FIELD*> fields;
     std::string name = aFormatter.Quotew( aSymbol->GetLibId().GetLibItemName().wx_str() );
@@ -393,12 +383,12 @@ void SCH_SEXPR_PLUGIN_CACHE::saveField( LIB_FIELD* aField, OUTPUTFORMATTER& aFor
     if( aField->GetId() >= 0 && aField->GetId() < MANDATORY_FIELDS )
         fieldName = GetCanonicalFieldName( aField->GetId() );
 
-    aFormatter.Print( aNestLevel, "(property %s %s (at %s %s %g)",
+    aFormatter.Print( aNestLevel, "(property %s %s (at %s %s %s)",
                       aFormatter.Quotew( fieldName ).c_str(),
                       aFormatter.Quotew( aField->GetText() ).c_str(),
                       EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, aField->GetPosition().x ).c_str(),
                       EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, aField->GetPosition().y ).c_str(),
-                      aField->GetTextAngle().AsDegrees() );
+                      EDA_UNIT_UTILS::FormatAngle( aField->GetTextAngle() ).c_str() );
 
     if( aField->IsNameShown() )
         aFormatter.Print( 0, " (show_name)" );
@@ -460,12 +450,13 @@ void SCH_SEXPR_PLUGIN_CACHE::saveText( LIB_TEXT* aText, OUTPUTFORMATTER& aFormat
 {
     wxCHECK_RET( aText && aText->Type() == LIB_TEXT_T, "Invalid LIB_TEXT object." );
 
-    aFormatter.Print( aNestLevel, "(text%s %s (at %s %s %g)\n",
+    aFormatter.Print( aNestLevel, "(text%s %s (at %s %s %s)\n",
                       aText->IsPrivate() ? " private" : "",
                       aFormatter.Quotew( aText->GetText() ).c_str(),
                       EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, aText->GetPosition().x ).c_str(),
                       EDA_UNIT_UTILS::FormatInternalUnits( schIUScale, aText->GetPosition().y ).c_str(),
-                      (double) aText->GetTextAngle().AsTenthsOfADegree() );
+                      fmt::format( "{:g}",
+                                   (double) aText->GetTextAngle().AsTenthsOfADegree() ).c_str() );
 
     aText->EDA_TEXT::Format( &aFormatter, aNestLevel, 0 );
     aFormatter.Print( aNestLevel, ")\n" );
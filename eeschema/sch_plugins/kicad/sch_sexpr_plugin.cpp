@@ -31,7 +31,6 @@
 #include <advanced_config.h>
 #include <base_units.h>
 #include <trace_helpers.h>
-#include <locale_io.h>
 #include <sch_bitmap.h>
 #include <sch_bus_entry.h>
 #include <sch_symbol.h>
@@ -63,6 +62,7 @@
 #include <wx_filename.h>       // for ::ResolvePossibleSymlinks()
 #include <progress_reporter.h>
 #include <boost/algorithm/string/join.hpp>
+#include <fmt/core.h>
 
 using namespace TSCHEMATIC_T;
 
@@ -103,7 +103,6 @@ SCH_SHEET* SCH_SEXPR_PLUGIN::LoadSchematicFile( const wxString& aFileName, SCHEM
 {
     wxASSERT( !aFileName || aSchematic != nullptr );
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
     SCH_SHEET*  sheet;
 
     wxFileName fn = aFileName;
@@ -322,7 +321,6 @@ void SCH_SEXPR_PLUGIN::LoadContent( LINE_READER& aReader, SCH_SHEET* aSheet, int
 {
     wxCHECK( aSheet, /* void */ );
 
-    LOCALE_IO toggle;
     SCH_SEXPR_PARSER parser( &aReader );
 
     parser.ParseSchematic( aSheet, true, aFileVersion );
@@ -336,8 +334,6 @@ void SCH_SEXPR_PLUGIN::SaveSchematicFile( const wxString& aFileName, SCH_SHEET*
     wxCHECK_RET( aSheet != nullptr, "NULL SCH_SHEET object." );
     wxCHECK_RET( !aFileName.IsEmpty(), "No schematic file name defined." );
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale, to write floating point values.
-
     init( aSchematic, aProperties );
 
     wxFileName fn = aFileName;
@@ -507,7 +503,6 @@ void SCH_SEXPR_PLUGIN::Format( EE_SELECTION* aSelection, SCH_SHEET_PATH* aSelect
 {
     wxCHECK( aSelection && aSelectionPath && aFormatter, /* void */ );
 
-    LOCALE_IO toggle;
     SCH_SHEET_LIST fullHierarchy = aSchematic.GetSheets();
 
     m_schematic = &aSchematic;
@@ -897,7 +892,7 @@ void SCH_SEXPR_PLUGIN::saveField( SCH_FIELD* aField, int aNestLevel )
                                                        aField->GetPosition().x ).c_str(),
                   EDA_UNIT_UTILS::FormatInternalUnits( schIUScale,
                                                        aField->GetPosition().y ).c_str(),
-                  EDA_UNIT_UTILS::FormatAngle( aField->GetTextAngle() ).c_str() );
+                  fmt::format( "{:g}", aField->GetTextAngle().AsDegrees() ).c_str() );
 
     if( aField->IsNameShown() )
         m_out->Print( 0, " (show_name)" );
@@ -944,7 +939,7 @@ void SCH_SEXPR_PLUGIN::saveBitmap( SCH_BITMAP* aBitmap, int aNestLevel )
     }
 
     if( scale != 1.0 )
-        m_out->Print( 0, " (scale %g)", scale );
+        m_out->Print( 0, " (scale %s)", fmt::format( "{:g}", scale ).c_str() );
 
     m_out->Print( 0, "\n" );
 
@@ -1000,11 +995,11 @@ void SCH_SEXPR_PLUGIN::saveSheet( SCH_SHEET* aSheet, int aNestLevel )
 
     m_out->Print( 0, "\n" );
 
-    m_out->Print( aNestLevel + 1, "(fill (color %d %d %d %0.4f))\n",
+    m_out->Print( aNestLevel + 1, "(fill (color %d %d %d %s))\n",
                   KiROUND( aSheet->GetBackgroundColor().r * 255.0 ),
                   KiROUND( aSheet->GetBackgroundColor().g * 255.0 ),
                   KiROUND( aSheet->GetBackgroundColor().b * 255.0 ),
-                  aSheet->GetBackgroundColor().a );
+                  fmt::format( "{:.4f}", aSheet->GetBackgroundColor().a ).c_str() );
 
     m_out->Print( aNestLevel + 1, "(uuid %s)\n", TO_UTF8( aSheet->m_Uuid.AsString() ) );
 
@@ -1452,8 +1447,6 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
                                            const wxString&   aLibraryPath,
                                            const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
@@ -1473,8 +1466,6 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList
                                            const wxString&   aLibraryPath,
                                            const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
@@ -1493,8 +1484,6 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList
 LIB_SYMBOL* SCH_SEXPR_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
                                           const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-
     cacheLib( aLibraryPath, aProperties );
 
     LIB_SYMBOL_MAP::const_iterator it = m_cache->m_symbols.find( aSymbolName );
@@ -1520,8 +1509,6 @@ LIB_SYMBOL* SCH_SEXPR_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wx
 void SCH_SEXPR_PLUGIN::SaveSymbol( const wxString& aLibraryPath, const LIB_SYMBOL* aSymbol,
                                    const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-
     cacheLib( aLibraryPath, aProperties );
 
     m_cache->AddSymbol( aSymbol );
@@ -1534,8 +1521,6 @@ void SCH_SEXPR_PLUGIN::SaveSymbol( const wxString& aLibraryPath, const LIB_SYMBO
 void SCH_SEXPR_PLUGIN::DeleteSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
                                      const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-
     cacheLib( aLibraryPath, aProperties );
 
     m_cache->DeleteSymbol( aSymbolName );
@@ -1554,8 +1539,6 @@ void SCH_SEXPR_PLUGIN::CreateSymbolLib( const wxString& aLibraryPath,
                                           aLibraryPath.GetData() ) );
     }
 
-    LOCALE_IO toggle;
-
     delete m_cache;
     m_cache = new SCH_SEXPR_PLUGIN_CACHE( aLibraryPath );
     m_cache->SetModified();
@@ -1656,7 +1639,6 @@ std::vector<LIB_SYMBOL*> SCH_SEXPR_PLUGIN::ParseLibSymbols( std::string& aSymbol
                                                             std::string  aSource,
                                                             int aFileVersion )
 {
-    LOCALE_IO      toggle;     // toggles on, then off, the C locale.
     LIB_SYMBOL*    newSymbol = nullptr;
     LIB_SYMBOL_MAP map;
 
@@ -1682,8 +1664,6 @@ std::vector<LIB_SYMBOL*> SCH_SEXPR_PLUGIN::ParseLibSymbols( std::string& aSymbol
 
 void SCH_SEXPR_PLUGIN::FormatLibSymbol( LIB_SYMBOL* symbol, OUTPUTFORMATTER & formatter )
 {
-
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
     SCH_SEXPR_PLUGIN_CACHE::SaveSymbol( symbol, formatter );
 }
 
@@ -284,6 +284,12 @@ public:
      */
     bool m_EnableGit;
 
+    /**
+     * Rough limit, in megabytes, on the memory held by the board editor's undo and redo lists.
+     * The oldest commands are discarded to stay under it.  0 means no limit.
+     */
+    int m_UndoMemoryBudget;
+
 ///@}
 
 
@@ -60,7 +60,7 @@ class METRICS;
  * connect (whether or not it does in the end), and otherwise force the zone-connection state
  * to no-connection (even though a lower priority zone -might- have otherwise connected to it.
  */
-enum ZONE_LAYER_OVERRIDE
+enum ZONE_LAYER_OVERRIDE : uint8_t
 {
     ZLO_NONE,
     ZLO_FORCE_FLASHED,
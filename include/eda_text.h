@@ -31,6 +31,7 @@
 #include <outline_mode.h>
 #include <eda_search_data.h>
 #include <font/glyph.h>
+#include <font/glyph_cache.h>
 #include <font/text_attributes.h>
 
 class OUTPUTFORMATTER;
@@ -329,9 +330,16 @@ public:
     virtual void ClearRenderCache();
     virtual void ClearBoundingBoxCache();
 
-    std::vector<std::unique_ptr<KIFONT::GLYPH>>*
-    GetRenderCache( const KIFONT::FONT* aFont, const wxString& forResolvedText,
-                    const VECTOR2I& aOffset = { 0, 0 } ) const;
+    /**
+     * Return the glyphs of an outline-font text, or nullptr for a stroke font.
+     *
+     * The glyphs are shared with other texts (see KIFONT::GLYPH_CACHE) and laid out relative
+     * to \a aRunPosition, which is where they must be drawn.
+     */
+    const KIFONT::GLYPH_RUN* GetRenderCache( const KIFONT::FONT* aFont,
+                                             const wxString& forResolvedText,
+                                             VECTOR2I& aRunPosition,
+                                             const VECTOR2I& aOffset = { 0, 0 } ) const;
 
     // Support for reading the cache from disk.
     void SetupRenderCache( const wxString& aResolvedText, const EDA_ANGLE& aAngle );
@@ -411,7 +419,8 @@ private:
     mutable const KIFONT::FONT*                         m_render_cache_font;
     mutable EDA_ANGLE                                   m_render_cache_angle;
     mutable VECTOR2I                                    m_render_cache_offset;
-    mutable std::vector<std::unique_ptr<KIFONT::GLYPH>> m_render_cache;
+    mutable std::shared_ptr<const KIFONT::GLYPH_RUN>    m_render_cache;     // may be shared
+    mutable VECTOR2I                                    m_render_cache_pos; // where to draw it
 
     mutable bool     m_bounding_box_cache_valid;
     mutable VECTOR2I m_bounding_box_cache_pos;
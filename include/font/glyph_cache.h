@@ -0,0 +1,133 @@
+/*
+ * This program source code file is part of KICAD, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 Kicad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <gal/gal.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <wx/string.h>
+#include <font/glyph.h>
+#include <font/text_attributes.h>
+
+namespace KIFONT
+{
+
+class OUTLINE_FONT;
+class METRICS;
+
+/// The glyphs of a (possibly multi-line) text, as laid out by a font
+typedef std::vector<std::unique_ptr<GLYPH>> GLYPH_RUN;
+
+
+/**
+ * A process-wide store of outline-font text converted to glyphs.
+ *
+ * Every text showing the same string in the same font, size and style shares one run of
+ * glyphs, laid out at the origin; each text only remembers where to draw it.  Runs are never
+ * modified once cached (outline glyphs are triangulated before a run is published), so they
+ * may be used from several threads.
+ *
+ * Once the cache is full, the least recently used run is dropped to make room for a new one.
+ */
+class GAL_API GLYPH_CACHE
+{
+public:
+    struct STATS
+    {
+        size_t m_Hits = 0;
+        size_t m_Misses = 0;
+        size_t m_Evictions = 0;
+    };
+
+    /**
+     * @param aMaxRuns is the number of runs kept before the least recently used are dropped.
+     *                 Only tests should need anything but the shared cache returned by Get().
+     */
+    GLYPH_CACHE( size_t aMaxRuns = MAX_RUNS ) :
+            m_maxRuns( aMaxRuns )
+    {}
+
+    static GLYPH_CACHE& Get();
+
+    /**
+     * Return the glyphs of \a aText laid out at (0, 0) with \a aAttrs, building them if they
+     * aren't cached yet.
+     */
+    std::shared_ptr<const GLYPH_RUN> GetRun( const OUTLINE_FONT* aFont, const wxString& aText,
+                                             const TEXT_ATTRIBUTES& aAttrs,
+                                             const METRICS& aFontMetrics );
+
+    /**
+     * Forget all the cached runs.  Texts holding a run keep it until they rebuild their cache.
+     */
+    void Clear();
+
+    size_t Size() const;
+
+    STATS GetStats() const;
+
+private:
+    struct KEY
+    {
+        bool operator==( const KEY& aOther ) const;
+
+        const OUTLINE_FONT* m_font;
+        wxString            m_text;
+        TEXT_ATTRIBUTES     m_attrs;
+        double              m_interlinePitch;
+        double              m_overbarHeight;
+        double              m_underlineOffset;
+    };
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const;
+    };
+
+    struct ENTRY
+    {
+        std::shared_ptr<const GLYPH_RUN> m_run;
+        std::list<const KEY*>::iterator  m_lruPos;
+    };
+
+    ///< Default upper bound on the number of runs kept
+    static constexpr size_t MAX_RUNS = 100000;
+
+    size_t                                   m_maxRuns;
+    mutable std::mutex                       m_mutex;
+    std::unordered_map<KEY, ENTRY, KEY_HASH> m_runs;
+
+    ///< Keys of m_runs, most recently used first.  Map keys don't move, so pointing at them
+    ///< is safe until their entry is erased.
+    std::list<const KEY*>                    m_lru;
+    STATS                                    m_stats;
+};
+
+} // namespace KIFONT
+
+#endif  // GLYPH_CACHE_H
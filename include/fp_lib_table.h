@@ -163,6 +163,16 @@ public:
      */
     void PrefetchLib( const wxString& aNickname );
 
+    /**
+     * Return true if the library given by \a aNickname is read by a plugin which converts
+     * numbers without help from the C locale, and so may be loaded alongside other threads
+     * without a #LOCALE_IO.  Only the KiCad s-expression plugin qualifies at present.
+     *
+     * @param aNickname is a locator for the library; it is a name in LIB_TABLE_ROW.
+     * @return false if the library is read by another plugin or cannot be found.
+     */
+    bool IsLocaleIndependent( const wxString& aNickname ) const;
+
     /**
      * Load a footprint having @a aFootprintName from the library given by @a aNickname.
      *
@@ -276,7 +276,25 @@ public:
             m_valueStr = val.m_valueStr;
     }
 
+    /**
+     * Return the value to its default-constructed state so that it can be recycled.  The
+     * string buffer is kept so that reuse does not need to allocate.
+     */
+    void Reset()
+    {
+        m_type = VT_UNDEFINED;
+        m_valueDbl = 0;
+        m_valueStr.clear();
+        m_stringIsWildcard = false;
+        m_isDeferredDbl = false;
+        m_lambdaDbl = nullptr;
+        m_isDeferredStr = false;
+        m_lambdaStr = nullptr;
+    }
+
 private:
+    friend class CONTEXT;
+
     VAR_TYPE_T                m_type;
     mutable double            m_valueDbl;               // mutable to support deferred evaluation
     mutable wxString          m_valueStr;               // mutable to support deferred evaluation
@@ -287,6 +305,8 @@ private:
 
     mutable bool              m_isDeferredStr;
     std::function<wxString()> m_lambdaStr;
+
+    VALUE*                    m_nextOwned = nullptr;    // intrusive list of CONTEXT values
 };
 
 class VAR_REF
@@ -296,6 +316,11 @@ public:
     virtual ~VAR_REF() {};
 
     virtual VAR_TYPE_T GetType() const = 0;
+
+    /**
+     * Return the value of the variable for the given context.  The returned value must be
+     * owned by \a aCtx (see CONTEXT::AllocValue() and CONTEXT::StoreValue()).
+     */
     virtual VALUE* GetValue( CONTEXT* aCtx ) = 0;
 };
 
@@ -304,30 +329,31 @@ class CONTEXT
 {
 public:
     CONTEXT() :
+        m_pooledValues( nullptr ),
+        m_storedValues( nullptr ),
         m_stack(),
         m_stackPtr( 0 )
     {
-        m_ownedValues.reserve( 20 );
     }
 
-    virtual ~CONTEXT()
-    {
-        for( VALUE* v : m_ownedValues )
-        {
-            delete v;
-        }
-    }
+    virtual ~CONTEXT();
 
-    VALUE* AllocValue()
-    {
-        m_ownedValues.emplace_back( new VALUE );
-        return m_ownedValues.back();
-    }
+    /**
+     * Return a default-constructed value owned by the context.
+     *
+     * Values are recycled through a per-thread pool when the context is destroyed, so
+     * evaluating an expression does not normally touch the heap.
+     */
+    VALUE* AllocValue();
 
+    /**
+     * Take ownership of a heap-allocated value (typically a VALUE subclass).
+     */
     VALUE* StoreValue( VALUE* aValue )
     {
-        m_ownedValues.emplace_back( aValue );
-        return m_ownedValues.back();
+        aValue->m_nextOwned = m_storedValues;
+        m_storedValues = aValue;
+        return aValue;
     }
 
     void Push( VALUE* v )
@@ -361,7 +387,8 @@ public:
     void ReportError( const wxString& aErrorMsg );
 
 private:
-    std::vector<VALUE*> m_ownedValues;
+    VALUE*              m_pooledValues;     // values from AllocValue(), returned to the pool
+    VALUE*              m_storedValues;     // values from StoreValue(), deleted
     VALUE*              m_stack[100];       // std::stack not performant enough
     int                 m_stackPtr;
 
@@ -374,14 +401,16 @@ class UCODE
 public:
     virtual ~UCODE();
 
-    void AddOp( UOP* uop )
-    {
-        m_ucode.push_back(uop);
-    }
+    void AddOp( UOP* uop );
 
     VALUE* Run( CONTEXT* ctx );
     wxString Dump() const;
 
+    /**
+     * Replace operations whose operands are all numeric constants by their result.
+     */
+    void FoldConstants();
+
     virtual std::unique_ptr<VAR_REF> CreateVarRef( const wxString& var, const wxString& field )
     {
         return nullptr;
@@ -394,7 +423,7 @@ public:
 
 protected:
 
-    std::vector<UOP*> m_ucode;
+    std::vector<UOP> m_ucode;       // stored by value to keep the program contiguous
 };
 
 
@@ -420,6 +449,9 @@ public:
         m_value(nullptr)
     {};
 
+    UOP( UOP&& ) = default;
+    UOP& operator=( UOP&& ) = default;
+
     ~UOP()
     {
     }
@@ -428,6 +460,11 @@ public:
 
     wxString Format() const;
 
+    int GetOp() const { return m_op; }
+
+    /// Return the constant pushed by a TR_UOP_PUSH_VALUE op, or nullptr for other ops
+    const VALUE* GetConstant() const { return m_op == TR_UOP_PUSH_VALUE ? m_value.get() : nullptr; }
+
 private:
     int                      m_op;
 
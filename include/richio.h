@@ -235,14 +235,28 @@ public:
     {
         rewind( m_fp );
         m_lineNum = 0;
+        m_bufferPos = m_bufferLen = 0;
     }
 
     long int FileLength();
+
+    /**
+     * @return the offset in the file of the next line to be read.  The file is opened in
+     *         text mode, so where the C library strips the CR of CR-LF line endings (i.e. on
+     *         Windows) this is only approximate: good enough for progress reporting, but not
+     *         for seeking.
+     */
     long int CurPos();
 
 protected:
     bool    m_iOwn; ///< if I own the file, I'll promise to close it, else not.
     FILE*   m_fp;   ///< I may own this file, but might not.
+
+    /// Blocks read ahead from m_fp.  Only used when the file is ours: a shared file must
+    /// not be read past the end of the current line.
+    std::vector<char> m_buffer;
+    size_t            m_bufferPos;  ///< Offset of the next unread byte in m_buffer
+    size_t            m_bufferLen;  ///< Number of valid bytes in m_buffer
 };
 
 
@@ -375,6 +389,17 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Write \a aText to the output stream as is, without indentation or formatting.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Write( const std::string& aText )
+    {
+        if( !aText.empty() )
+            write( aText.data(), (int) aText.size() );
+    }
+
     /**
      * Perform quote character need determination.
      *
@@ -220,6 +220,13 @@ extern KICOMMON_API const wxChar* const traceGalProfile;
  */
 extern KICOMMON_API const wxChar* const traceKiCad2Step;
 
+/**
+ * Flag to enable timing of the phases of the board update from the schematic netlist.
+ *
+ * Use "KICAD_NETLIST_UPDATER" to enable.
+ */
+extern KICOMMON_API const wxChar* const traceBoardNetlistUpdater;
+
 ///@}
 
 /**
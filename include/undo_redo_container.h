@@ -287,9 +287,17 @@ public:
     wxString GetDescription() const                     { return m_description; }
     void SetDescription( const wxString& aDescription ) { m_description = aDescription; }
 
+    /**
+     * The memory held by the command, as estimated by the frame when it was pushed on to an
+     * undo or redo list.
+     */
+    size_t GetMemorySize() const                        { return m_memorySize; }
+    void SetMemorySize( size_t aSize )                  { m_memorySize = aSize; }
+
 private:
     wxString                 m_description;
     std::vector<ITEM_PICKER> m_ItemsList;
+    size_t                   m_memorySize;
 };
 
 
@@ -39,6 +39,7 @@
 #define ARG_BOARD_ONLY "--board-only"
 #define ARG_INCLUDE_TRACKS "--include-tracks"
 #define ARG_INCLUDE_ZONES "--include-zones"
+#define ARG_FAST_BOARD_HOLES "--fast-board-holes"
 #define ARG_FORMAT "--format"
 #define ARG_VRML_UNITS "--units"
 #define ARG_VRML_MODELS_DIR "--models-dir"
@@ -115,6 +116,13 @@ CLI::PCB_EXPORT_3D_COMMAND::PCB_EXPORT_3D_COMMAND( const std::string&        aNa
                 .implicit_value( true )
                 .default_value( false );
 
+        m_argParser.add_argument( ARG_FAST_BOARD_HOLES )
+                .help( UTF8STDSTR( _( "Remove holes from the board body before extruding it "
+                                      "(much faster on boards with many holes, but round holes "
+                                      "in the board body become polygons)" ) ) )
+                .implicit_value( true )
+                .default_value( false );
+
         m_argParser.add_argument( ARG_MIN_DISTANCE )
                 .default_value( std::string( "0.01mm" ) )
                 .help( UTF8STDSTR(
@@ -159,6 +167,7 @@ int CLI::PCB_EXPORT_3D_COMMAND::doPerform( KIWAY& aKiway )
         step->m_substModels = m_argParser.get<bool>( ARG_SUBST_MODELS );
         step->m_exportTracks = m_argParser.get<bool>( ARG_INCLUDE_TRACKS );
         step->m_exportZones = m_argParser.get<bool>( ARG_INCLUDE_ZONES );
+        step->m_fastBoardHoles = m_argParser.get<bool>( ARG_FAST_BOARD_HOLES );
         step->m_boardOnly = m_argParser.get<bool>( ARG_BOARD_ONLY );
     }
 
@@ -0,0 +1,166 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_render.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_pcb_render.h"
+#include <kiface_base.h>
+#include <string_utils.h>
+#include <wx/crt.h>
+#include <wx/filename.h>
+
+#include <macros.h>
+
+#define ARG_WIDTH "--width"
+#define ARG_HEIGHT "--height"
+#define ARG_SIDE "--side"
+#define ARG_QUALITY "--quality"
+#define ARG_ZOOM "--zoom"
+#define ARG_PERSPECTIVE "--perspective"
+#define ARG_FLOOR "--floor"
+
+CLI::PCB_RENDER_COMMAND::PCB_RENDER_COMMAND() : COMMAND( "render" )
+{
+    addCommonArgs( true, true, false, false );
+    addDefineArg();
+
+    m_argParser.add_description( UTF8STDSTR( _( "Renders the PCB with the raytracing engine of "
+                                                "the 3D viewer into a PNG or JPEG image" ) ) );
+
+    m_argParser.add_argument( ARG_WIDTH )
+            .help( UTF8STDSTR( _( "Image width in pixels" ) ) )
+            .scan<'i', int>()
+            .default_value( 1600 )
+            .metavar( "WIDTH" );
+
+    m_argParser.add_argument( ARG_HEIGHT )
+            .help( UTF8STDSTR( _( "Image height in pixels" ) ) )
+            .scan<'i', int>()
+            .default_value( 900 )
+            .metavar( "HEIGHT" );
+
+    m_argParser.add_argument( ARG_SIDE )
+            .default_value( std::string( "top" ) )
+            .help( UTF8STDSTR( _( "Side of the board to render, options: top, bottom, left, "
+                                  "right, front, back" ) ) )
+            .metavar( "SIDE" );
+
+    m_argParser.add_argument( ARG_QUALITY )
+            .default_value( std::string( "basic" ) )
+            .help( UTF8STDSTR( _( "Render quality, options: basic, high, user (the 3D viewer "
+                                  "raytracing settings)" ) ) )
+            .metavar( "QUALITY" );
+
+    m_argParser.add_argument( ARG_ZOOM )
+            .help( UTF8STDSTR( _( "Camera zoom factor" ) ) )
+            .scan<'g', double>()
+            .default_value( 1.0 )
+            .metavar( "ZOOM" );
+
+    m_argParser.add_argument( ARG_PERSPECTIVE )
+            .help( UTF8STDSTR( _( "Use a perspective instead of an orthographic projection" ) ) )
+            .implicit_value( true )
+            .default_value( false );
+
+    m_argParser.add_argument( ARG_FLOOR )
+            .help( UTF8STDSTR( _( "Render the floor below the board, with its shadow" ) ) )
+            .implicit_value( true )
+            .default_value( false );
+}
+
+
+int CLI::PCB_RENDER_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_RENDER> renderJob( new JOB_PCB_RENDER( true ) );
+
+    renderJob->m_filename = m_argInput;
+    renderJob->m_outputFile = m_argOutput;
+    renderJob->SetVarOverrides( m_argDefineVars );
+    renderJob->m_width = m_argParser.get<int>( ARG_WIDTH );
+    renderJob->m_height = m_argParser.get<int>( ARG_HEIGHT );
+    renderJob->m_zoom = m_argParser.get<double>( ARG_ZOOM );
+    renderJob->m_perspective = m_argParser.get<bool>( ARG_PERSPECTIVE );
+    renderJob->m_floor = m_argParser.get<bool>( ARG_FLOOR );
+
+    if( renderJob->m_width <= 0 || renderJob->m_height <= 0 )
+    {
+        wxFprintf( stderr, _( "Invalid image size\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    if( renderJob->m_zoom <= 0.0 )
+    {
+        wxFprintf( stderr, _( "Invalid zoom factor\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString side = From_UTF8( m_argParser.get<std::string>( ARG_SIDE ).c_str() );
+
+    if( side == wxS( "top" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::TOP;
+    else if( side == wxS( "bottom" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::BOTTOM;
+    else if( side == wxS( "left" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::LEFT;
+    else if( side == wxS( "right" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::RIGHT;
+    else if( side == wxS( "front" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::FRONT;
+    else if( side == wxS( "back" ) )
+        renderJob->m_side = JOB_PCB_RENDER::SIDE::BACK;
+    else
+    {
+        wxFprintf( stderr, _( "Invalid side\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString quality = From_UTF8( m_argParser.get<std::string>( ARG_QUALITY ).c_str() );
+
+    if( quality == wxS( "basic" ) )
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::BASIC;
+    else if( quality == wxS( "high" ) )
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::HIGH;
+    else if( quality == wxS( "user" ) )
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::USER;
+    else
+    {
+        wxFprintf( stderr, _( "Invalid quality\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString ext = wxFileName( renderJob->m_outputFile ).GetExt().Lower();
+
+    if( ext.IsEmpty() || ext == wxS( "png" ) )
+    {
+        renderJob->m_format = JOB_PCB_RENDER::FORMAT::PNG;
+    }
+    else if( ext == wxS( "jpg" ) || ext == wxS( "jpeg" ) )
+    {
+        renderJob->m_format = JOB_PCB_RENDER::FORMAT::JPEG;
+    }
+    else
+    {
+        wxFprintf( stderr, _( "Invalid image format, use a .png or .jpg output file\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, renderJob.get() );
+
+    return exitCode;
+}
@@ -0,0 +1,158 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHARDED_MAP_H
+#define SHARDED_MAP_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+/**
+ * A hash map split into independently locked shards.
+ *
+ * Intended for memoization caches which are read and written from many threads at once
+ * (such as the DRC expression caches on BOARD).  Threads only contend when their keys
+ * hash to the same shard, and readers of a shard do not block each other.
+ *
+ * Values are copied in and out; use a shared_ptr for anything expensive to copy.
+ */
+template <typename KEY, typename VALUE, typename HASH = std::hash<KEY>, size_t SHARDS = 32>
+class SHARDED_MAP
+{
+    static_assert( ( SHARDS & ( SHARDS - 1 ) ) == 0, "SHARDS must be a power of two" );
+
+public:
+    SHARDED_MAP() :
+            m_size( 0 )
+    {
+    }
+
+    /**
+     * Look up a key.
+     *
+     * @param aValue receives the cached value if the key is present.
+     * @return true if the key was present.
+     */
+    bool Get( const KEY& aKey, VALUE& aValue ) const
+    {
+        const SHARD&                        shard = shardFor( aKey );
+        std::shared_lock<std::shared_mutex> lock( shard.m_mutex );
+        auto                                it = shard.m_map.find( aKey );
+
+        if( it == shard.m_map.end() )
+            return false;
+
+        aValue = it->second;
+        return true;
+    }
+
+    /**
+     * Insert or overwrite the value for a key.
+     */
+    void Set( const KEY& aKey, const VALUE& aValue )
+    {
+        SHARD&                              shard = shardFor( aKey );
+        std::unique_lock<std::shared_mutex> lock( shard.m_mutex );
+
+        if( shard.m_map.insert_or_assign( aKey, aValue ).second )
+            m_size.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    /**
+     * Return the value for a key, calling \a aCompute to create it if it is not present.
+     *
+     * \a aCompute runs without any lock held, so two threads may compute the same key
+     * concurrently; the first result stored wins and is returned to both.
+     */
+    template <typename FUNC>
+    VALUE GetOrCompute( const KEY& aKey, FUNC&& aCompute )
+    {
+        VALUE value;
+
+        if( Get( aKey, value ) )
+            return value;
+
+        value = aCompute();
+
+        SHARD&                              shard = shardFor( aKey );
+        std::unique_lock<std::shared_mutex> lock( shard.m_mutex );
+        auto                                result = shard.m_map.emplace( aKey, value );
+
+        if( result.second )
+            m_size.fetch_add( 1, std::memory_order_relaxed );
+
+        return result.first->second;
+    }
+
+    /**
+     * @return the number of entries.  Only a hint while other threads are writing.
+     */
+    size_t Size() const { return m_size.load( std::memory_order_relaxed ); }
+
+    bool Empty() const { return Size() == 0; }
+
+    void Clear()
+    {
+        for( SHARD& shard : m_shards )
+        {
+            std::unique_lock<std::shared_mutex> lock( shard.m_mutex );
+            shard.m_map.clear();
+        }
+
+        m_size.store( 0, std::memory_order_relaxed );
+    }
+
+private:
+    // Keep each shard on its own cache line so that locking one doesn't slow its neighbours
+    struct alignas( 64 ) SHARD
+    {
+        mutable std::shared_mutex              m_mutex;
+        std::unordered_map<KEY, VALUE, HASH>   m_map;
+    };
+
+    SHARD& shardFor( const KEY& aKey )
+    {
+        return m_shards[ shardIndex( aKey ) ];
+    }
+
+    const SHARD& shardFor( const KEY& aKey ) const
+    {
+        return m_shards[ shardIndex( aKey ) ];
+    }
+
+    static size_t shardIndex( const KEY& aKey )
+    {
+        uint64_t hash = HASH()( aKey );
+
+        // The low bits are also used by the shard's own buckets; mix in the high bits
+        hash ^= hash >> 29;
+        hash *= 0x9e3779b97f4a7c15ULL;
+        return static_cast<size_t>( hash >> 32 ) & ( SHARDS - 1 );
+    }
+
+    std::array<SHARD, SHARDS> m_shards;
+    std::atomic<size_t>       m_size;
+};
+
+#endif // SHARDED_MAP_H
@@ -252,23 +252,27 @@ void BOARD::IncrementTimeStamp()
 {
     m_timeStamp++;
 
-    if( !m_IntersectsAreaCache.empty()
-        || !m_EnclosedByAreaCache.empty()
-        || !m_IntersectsCourtyardCache.empty()
-        || !m_IntersectsFCourtyardCache.empty()
-        || !m_IntersectsBCourtyardCache.empty()
-        || !m_LayerExpressionCache.empty()
+    if( !m_IntersectsAreaCache.Empty()
+        || !m_EnclosedByAreaCache.Empty()
+        || !m_IntersectsCourtyardCache.Empty()
+        || !m_IntersectsFCourtyardCache.Empty()
+        || !m_IntersectsBCourtyardCache.Empty()
+        || !m_LayerExpressionCache.Empty()
+        || !m_DeflatedAreaOutlineCache.Empty()
+        || !m_RuleAreaNameCache.Empty()
         || !m_ZoneBBoxCache.empty()
         || m_CopperItemRTreeCache )
     {
-        std::unique_lock<std::mutex> cacheLock( m_CachesMutex );
+        m_IntersectsAreaCache.Clear();
+        m_EnclosedByAreaCache.Clear();
+        m_IntersectsCourtyardCache.Clear();
+        m_IntersectsFCourtyardCache.Clear();
+        m_IntersectsBCourtyardCache.Clear();
+        m_LayerExpressionCache.Clear();
+        m_DeflatedAreaOutlineCache.Clear();
+        m_RuleAreaNameCache.Clear();
 
-        m_IntersectsAreaCache.clear();
-        m_EnclosedByAreaCache.clear();
-        m_IntersectsCourtyardCache.clear();
-        m_IntersectsFCourtyardCache.clear();
-        m_IntersectsBCourtyardCache.clear();
-        m_LayerExpressionCache.clear();
+        std::unique_lock<std::mutex> cacheLock( m_CachesMutex );
 
         m_ZoneBBoxCache.clear();
 
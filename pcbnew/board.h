@@ -35,6 +35,7 @@
 #include <pcb_plot_params.h>
 #include <title_block.h>
 #include <tools/pcb_selection.h>
+#include <core/sharded_map.h>
 #include <mutex>
 #include <list>
 
@@ -1222,13 +1223,22 @@ public:
     };
 
     // ------------ Run-time caches -------------
+    // The expression function caches are hit from every DRC thread, so they are sharded
+    // rather than sharing m_CachesMutex.
+    SHARDED_MAP<PTR_PTR_CACHE_KEY, bool>                  m_IntersectsCourtyardCache;
+    SHARDED_MAP<PTR_PTR_CACHE_KEY, bool>                  m_IntersectsFCourtyardCache;
+    SHARDED_MAP<PTR_PTR_CACHE_KEY, bool>                  m_IntersectsBCourtyardCache;
+    SHARDED_MAP<PTR_PTR_LAYER_CACHE_KEY, bool>            m_IntersectsAreaCache;
+    SHARDED_MAP<PTR_PTR_LAYER_CACHE_KEY, bool>            m_EnclosedByAreaCache;
+    SHARDED_MAP<wxString, LSET>                           m_LayerExpressionCache;
+
+    /// Rule area outlines deflated by the DRC epsilon and prepared for collision tests
+    SHARDED_MAP<const ZONE*, std::shared_ptr<SHAPE_POLY_SET>> m_DeflatedAreaOutlineCache;
+
+    /// Rule areas matching a name pattern used in an expression
+    SHARDED_MAP<wxString, std::shared_ptr<std::vector<ZONE*>>> m_RuleAreaNameCache;
+
     std::mutex                                            m_CachesMutex;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsFCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsBCourtyardCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_IntersectsAreaCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_EnclosedByAreaCache;
-    std::unordered_map< wxString, LSET >                  m_LayerExpressionCache;
     std::unordered_map<ZONE*, std::unique_ptr<DRC_RTREE>> m_CopperZoneRTreeCache;
     std::shared_ptr<DRC_RTREE>                            m_CopperItemRTreeCache;
     mutable std::unordered_map<const ZONE*, BOX2I>        m_ZoneBBoxCache;
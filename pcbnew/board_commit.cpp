@@ -26,6 +26,7 @@
 #include <macros.h>
 #include <board.h>
 #include <footprint.h>
+#include <pad.h>
 #include <pcb_group.h>
 #include <pcb_track.h>
 #include <tool/tool_manager.h>
@@ -142,6 +143,59 @@ void BOARD_COMMIT::dirtyIntersectingZones( BOARD_ITEM* item, int aChangeType )
 }
 
 
+/**
+ * @return false if the modified \a aItem still anchors its teardrops exactly as its image
+ * \a aCopy did (same shape, position, layers, net and teardrop settings), so they can be kept
+ * as they are.  Editing a footprint field or a track's locked flag then costs no teardrop
+ * rebuild.
+ */
+static bool teardropAnchorsChanged( const BOARD_ITEM* aItem, const BOARD_ITEM* aCopy )
+{
+    auto connectedItemChanged =
+            []( const BOARD_ITEM* aNew, const BOARD_ITEM* aOld ) -> bool
+            {
+                auto newItem = static_cast<const BOARD_CONNECTED_ITEM*>( aNew );
+                auto oldItem = static_cast<const BOARD_CONNECTED_ITEM*>( aOld );
+
+                return !( *newItem == *oldItem )
+                        || newItem->GetNetCode() != oldItem->GetNetCode()
+                        || newItem->GetTeardropParams() != oldItem->GetTeardropParams();
+            };
+
+    if( !aCopy || aCopy->Type() != aItem->Type() )
+        return true;
+
+    switch( aItem->Type() )
+    {
+    case PCB_FOOTPRINT_T:
+    {
+        const PADS& newPads = static_cast<const FOOTPRINT*>( aItem )->Pads();
+        const PADS& oldPads = static_cast<const FOOTPRINT*>( aCopy )->Pads();
+
+        if( newPads.size() != oldPads.size() )
+            return true;
+
+        for( size_t ii = 0; ii < newPads.size(); ++ii )
+        {
+            if( connectedItemChanged( newPads[ii], oldPads[ii] ) )
+                return true;
+        }
+
+        return false;
+    }
+
+    case PCB_PAD_T:
+    case PCB_VIA_T:
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+        return connectedItemChanged( aItem, aCopy );
+
+    default:
+        return true;
+    }
+}
+
+
 void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
 {
     KIGFX::VIEW*        view = m_toolMgr->GetView();
@@ -196,7 +250,15 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 solderMaskDirty = true;
             }
 
-            if( !( aCommitFlags & SKIP_TEARDROPS ) )
+            bool teardropsDirty = !( aCommitFlags & SKIP_TEARDROPS );
+
+            if( teardropsDirty && ( ent.m_type & CHT_TYPE ) == CHT_MODIFY )
+            {
+                teardropsDirty = teardropAnchorsChanged( boardItem,
+                                                         dynamic_cast<BOARD_ITEM*>( ent.m_copy ) );
+            }
+
+            if( teardropsDirty )
             {
                 if( boardItem->Type() == PCB_FOOTPRINT_T )
                 {
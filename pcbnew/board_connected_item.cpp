@@ -31,6 +31,8 @@
 #include <i18n_utility.h>
 #include <netinfo.h>
 
+#include <array>
+
 using namespace std::placeholders;
 
 BOARD_CONNECTED_ITEM::BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype ) :
@@ -41,6 +43,18 @@ BOARD_CONNECTED_ITEM::BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype
 }
 
 
+std::mutex& BOARD_CONNECTED_ITEM::itemMutex( const BOARD_CONNECTED_ITEM* aItem, ITEM_LOCK aLock )
+{
+    static constexpr size_t MUTEX_COUNT = 64;
+    static std::array<std::array<std::mutex, MUTEX_COUNT>, (size_t) ITEM_LOCK::COUNT> s_mutexes;
+
+    // Items are heap-allocated, so the lowest bits of their addresses carry no information
+    size_t slot = ( reinterpret_cast<uintptr_t>( aItem ) >> 4 ) % MUTEX_COUNT;
+
+    return s_mutexes[ (size_t) aLock ][ slot ];
+}
+
+
 bool BOARD_CONNECTED_ITEM::SetNetCode( int aNetCode, bool aNoAssert )
 {
     if( !IsOnCopperLayer() )
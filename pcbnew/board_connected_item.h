@@ -29,6 +29,8 @@
 #include <board_item.h>
 #include <teardrop/teardrop_parameters.h>
 
+#include <mutex>
+
 class NETCLASS;
 class NETINFO_ITEM;
 class PAD;
@@ -203,6 +205,25 @@ public:
     void SetTeardropMaxTrackWidth( double aRatio ) { m_teardropParams.m_WidthtoSizeFilterRatio = aRatio; }
     double GetTeardropMaxTrackWidth() const { return m_teardropParams.m_WidthtoSizeFilterRatio; }
 
+protected:
+    /// The per-item caches guarded by itemMutex()
+    enum class ITEM_LOCK
+    {
+        ZONE_LAYER_OVERRIDES,
+        SHAPES,
+        POLYGONS,
+        COUNT
+    };
+
+    /**
+     * Return the mutex guarding one of the caches of \a aItem.
+     *
+     * A std::mutex is 40 bytes, which adds up over the pads and vias of a large board, so items
+     * share a fixed set of mutexes instead.  Each kind of cache has its own set, so an item can
+     * hold the locks of two of its caches at once.
+     */
+    static std::mutex& itemMutex( const BOARD_CONNECTED_ITEM* aItem, ITEM_LOCK aLock );
+
 protected:
     /// Store all information about the net that item belongs to.
     NETINFO_ITEM* m_netinfo;
@@ -26,6 +26,7 @@
 #include <board_design_settings.h>
 #include <board.h>
 #include <i18n_utility.h>       // For _HKI definition
+#include <fmt/core.h>
 #include "stackup_predefined_prms.h"
 
 
@@ -680,7 +681,8 @@ void BOARD_STACKUP::FormatBoardStackup( OUTPUTFORMATTER* aFormatter,
                                    aFormatter->Quotew( item->GetMaterial( idx ) ).c_str() );
 
             if( item->HasEpsilonRValue() && item->HasMaterialValue( idx ) )
-                aFormatter->Print( 0, " (epsilon_r %g)", item->GetEpsilonR( idx ) );
+                aFormatter->Print( 0, " (epsilon_r %s)",
+                                   fmt::format( "{:g}", item->GetEpsilonR( idx ) ).c_str() );
 
             if( item->HasLossTangentValue() && item->HasMaterialValue( idx ) )
                 aFormatter->Print( 0, " (loss_tangent %s)",
@@ -438,7 +438,9 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
             {
                 if( IsCopperLayer( layer ) )
                 {
-                    for( int j = 0; j < zone->GetFilledPolysList( layer )->OutlineCount(); j++ )
+                    int outlineCount = zone->GetFilledPolysList( layer )->OutlineCount();
+
+                    for( int j = 0; j < outlineCount; j++ )
                         zitems.push_back( new CN_ZONE_LAYER( zone, layer, j ) );
                 }
             }
@@ -785,9 +787,6 @@ void CN_VISITOR::checkZoneItemConnection( CN_ZONE_LAYER* aZoneLayer, CN_ITEM* aI
 
 void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LAYER* aZoneLayerB )
 {
-    const ZONE* zoneA = static_cast<const ZONE*>( aZoneLayerA->Parent() );
-    const ZONE* zoneB = static_cast<const ZONE*>( aZoneLayerB->Parent() );
-
     const BOX2I& boxA = aZoneLayerA->BBox();
     const BOX2I& boxB = aZoneLayerB->BBox();
 
@@ -799,8 +798,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LA
     if( !boxA.Intersects( boxB ) )
         return;
 
-    const SHAPE_LINE_CHAIN& outline =
-            zoneA->GetFilledPolysList( layer )->COutline( aZoneLayerA->SubpolyIndex() );
+    const SHAPE_LINE_CHAIN& outline = aZoneLayerA->GetOutline();
 
     for( int i = 0; i < outline.PointCount(); i++ )
     {
@@ -815,8 +813,7 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LA
         }
     }
 
-    const SHAPE_LINE_CHAIN& outline2 =
-            zoneB->GetFilledPolysList( layer )->COutline( aZoneLayerB->SubpolyIndex() );
+    const SHAPE_LINE_CHAIN& outline2 = aZoneLayerB->GetOutline();
 
     for( int i = 0; i < outline2.PointCount(); i++ )
     {
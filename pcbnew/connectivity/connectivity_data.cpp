@@ -447,7 +447,8 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
                     if( zone->IsFilled() )
                     {
-                        const SHAPE_POLY_SET*   zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
+                        std::shared_ptr<const SHAPE_POLY_SET> zoneFill =
+                                zone->GetFilledPolysList( ToLAYER_ID( aLayer ) );
                         const SHAPE_LINE_CHAIN& padHull = pad->GetEffectivePolygon( ERROR_INSIDE )->Outline( 0 );
 
                         for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
@@ -471,7 +472,8 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
                     if( zone->IsFilled() )
                     {
-                        const SHAPE_POLY_SET* zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
+                        std::shared_ptr<const SHAPE_POLY_SET> zoneFill =
+                                zone->GetFilledPolysList( ToLAYER_ID( aLayer ) );
                         SHAPE_CIRCLE          viaHull( via->GetCenter(), via->GetWidth() / 2 );
 
                         for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
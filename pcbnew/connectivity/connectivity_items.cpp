@@ -99,9 +99,7 @@ int CN_ZONE_LAYER::AnchorCount() const
     if( !Valid() )
         return 0;
 
-    const ZONE* zone = static_cast<const ZONE*>( Parent() );
-
-    return zone->GetFilledPolysList( m_layer )->COutline( m_subpolyIndex ).PointCount() ? 1 : 0;
+    return m_fillPoly->COutline( m_subpolyIndex ).PointCount() ? 1 : 0;
 }
 
 
@@ -110,9 +108,7 @@ const VECTOR2I CN_ZONE_LAYER::GetAnchor( int n ) const
     if( !Valid() )
         return VECTOR2I();
 
-    const ZONE* zone = static_cast<const ZONE*>( Parent() );
-
-    return zone->GetFilledPolysList( m_layer )->COutline( m_subpolyIndex ).CPoint( 0 );
+    return m_fillPoly->COutline( m_subpolyIndex ).CPoint( 0 );
 }
 
 
@@ -225,7 +221,7 @@ CN_ITEM* CN_LIST::Add( PCB_VIA* via )
 
 const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 {
-    const std::shared_ptr<SHAPE_POLY_SET>& polys = zone->GetFilledPolysList( aLayer );
+    std::shared_ptr<const SHAPE_POLY_SET> polys = zone->GetFilledPolysList( aLayer );
 
     std::vector<CN_ITEM*> rv;
 
@@ -235,7 +231,7 @@ const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 
         zitem->BuildRTree();
 
-        for( const VECTOR2I& pt : zone->GetFilledPolysList( aLayer )->COutline( j ).CPoints() )
+        for( const VECTOR2I& pt : polys->COutline( j ).CPoints() )
             zitem->AddAnchor( pt );
 
         rv.push_back( Add( zitem ) );
@@ -124,11 +124,11 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
                 if( m_drcEngine->IsErrorLimitExceeded( DRCE_ISOLATED_COPPER ) )
                     break;
 
-                std::shared_ptr<SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
+                std::shared_ptr<const SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
 
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_ISOLATED_COPPER );
                 drcItem->SetItems( zone );
-                reportViolation( drcItem, poly->Outline( polyIdx ).CPoint( 0 ), layer );
+                reportViolation( drcItem, poly->COutline( polyIdx ).CPoint( 0 ), layer );
             }
         }
     }
@@ -1280,8 +1280,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                     continue;
 
                 // Examine a candidate zone: compare zoneB to zoneA
-                SHAPE_POLY_SET* polyA = m_board->m_DRCCopperZones[ia]->GetFill( layer );
-                SHAPE_POLY_SET* polyB = m_board->m_DRCCopperZones[ia2]->GetFill( layer );
+                std::shared_ptr<const SHAPE_POLY_SET> polyA = zoneA->GetFilledPolysList( layer );
+                std::shared_ptr<const SHAPE_POLY_SET> polyB = zoneB->GetFilledPolysList( layer );
 
                 if( !polyA->BBoxFromCaches().Intersects( polyB->BBoxFromCaches() ) )
                     continue;
@@ -152,10 +152,7 @@ bool DRC_TEST_PROVIDER_DISALLOW::Run()
 
                 PTR_PTR_LAYER_CACHE_KEY key = { ruleArea, copperZone, UNDEFINED_LAYER };
 
-                {
-                    std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                    board->m_IntersectsAreaCache[ key ] = isInside;
-                }
+                board->m_IntersectsAreaCache.Set( key, isInside );
 
                 done.fetch_add( 1 );
 
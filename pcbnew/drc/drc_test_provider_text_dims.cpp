@@ -153,9 +153,10 @@ bool DRC_TEST_PROVIDER_TEXT_DIMS::Run()
                     if( !constraint.Value().HasMin() )
                         return true;
 
-                    auto* glyphs = text->GetRenderCache( font, text->GetShownText( true ) );
-                    bool  collapsedStroke = false;
-                    bool  collapsedArea = false;
+                    VECTOR2I pos;    // outline sizes don't depend on where the text is
+                    auto*    glyphs = text->GetRenderCache( font, text->GetShownText( true ), pos );
+                    bool     collapsedStroke = false;
+                    bool     collapsedArea = false;
 
                     for( const std::unique_ptr<KIFONT::GLYPH>& glyph : *glyphs )
                     {
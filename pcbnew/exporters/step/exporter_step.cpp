@@ -48,7 +48,9 @@
 
 #include <wx/crt.h>
 #include <wx/log.h>
+#include <mutex>
 #include <core/profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <core/thread_pool.h>
 
 #define OCC_VERSION_MIN 0x070500
 
@@ -59,6 +61,10 @@
 
 void ReportMessage( const wxString& aMessage )
 {
+    // Shapes are built on the thread pool, so serialize the output
+    static std::mutex s_reportMutex;
+    std::lock_guard<std::mutex> lock( s_reportMutex );
+
     wxPrintf( aMessage );
     fflush( stdout ); // Force immediate printing (needed on mingw)
 }
@@ -169,16 +175,15 @@ bool EXPORTER_STEP::buildFootprint3DShapes( FOOTPRINT* aFootprint, VECTOR2D aOri
 {
     bool hasdata = false;
 
-    // Dump the pad holes into the PCB
+    // Queue the pad holes (and copper) for the PCB.  They are built together with the tracks
+    // and vias in buildBoard3DShapes().  A pad counts as data as soon as it is queued: an OCC
+    // failure building it is only known later, and is reported by AddCopperItemShapes().
     for( PAD* pad : aFootprint->Pads() )
     {
-        if( m_pcbModel->AddPadHole( pad, aOrigin ) )
-            hasdata = true;
-
-        if( ExportTracksAndVias() )
+        if( pad->GetDrillSize().x || ExportTracksAndVias() )
         {
-            if( m_pcbModel->AddPadShape( pad, aOrigin ) )
-                hasdata = true;
+            m_copperItems.push_back( pad );
+            hasdata = true;
         }
     }
 
@@ -294,7 +299,8 @@ bool EXPORTER_STEP::buildTrack3DShape( PCB_TRACK* aTrack, VECTOR2D aOrigin )
 {
     if( aTrack->Type() == PCB_VIA_T )
     {
-        return m_pcbModel->AddViaShape( static_cast<const PCB_VIA*>( aTrack ), aOrigin );
+        m_copperItems.push_back( aTrack );
+        return true;
     }
 
     PCB_LAYER_ID pcblayer = aTrack->GetLayer();
@@ -312,7 +318,9 @@ bool EXPORTER_STEP::buildTrack3DShape( PCB_TRACK* aTrack, VECTOR2D aOrigin )
             aTrack->TransformShapeToPolygon( m_bottom_copper_shapes, pcblayer, 0, maxError, ERROR_INSIDE );
     }
     else
-        m_pcbModel->AddTrackSegment( aTrack, aOrigin );
+    {
+        m_copperItems.push_back( aTrack );
+    }
 
     return true;
 }
@@ -320,20 +328,39 @@ bool EXPORTER_STEP::buildTrack3DShape( PCB_TRACK* aTrack, VECTOR2D aOrigin )
 
 void EXPORTER_STEP::buildZones3DShape( VECTOR2D aOrigin )
 {
+    std::vector<std::pair<ZONE*, PCB_LAYER_ID>> zoneLayers;
+
     for( ZONE* zone : m_board->Zones() )
     {
         for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
         {
             if( layer == F_Cu || layer == B_Cu )
-            {
-                SHAPE_POLY_SET copper_shape;
-                zone->TransformSolidAreasShapesToPolygon( layer, copper_shape );
-                copper_shape.Unfracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-
-                m_pcbModel->AddCopperPolygonShapes( &copper_shape, layer == F_Cu, aOrigin, false );
-            }
+                zoneLayers.emplace_back( zone, layer );
         }
     }
+
+    std::vector<SHAPE_POLY_SET> copper_shapes( zoneLayers.size() );
+    std::vector<bool>           onTop( zoneLayers.size() );
+    thread_pool&                tp = GetKiCadThreadPool();
+
+    // Unfracturing is expensive for large fills, so do it in parallel too
+    tp.push_loop( zoneLayers.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    const auto& [ zone, layer ] = zoneLayers[ii];
+
+                    zone->TransformSolidAreasShapesToPolygon( layer, copper_shapes[ii] );
+                    copper_shapes[ii].Unfracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                }
+            } );
+    tp.wait_for_tasks();
+
+    for( size_t ii = 0; ii < zoneLayers.size(); ++ii )
+        onTop[ii] = zoneLayers[ii].second == F_Cu;
+
+    m_pcbModel->AddCopperZoneShapes( copper_shapes, onTop, aOrigin );
 }
 
 
@@ -407,6 +434,7 @@ bool EXPORTER_STEP::buildBoard3DShapes()
     m_pcbModel->OCCSetMergeMaxDistance( OCC_MAX_DISTANCE_TO_MERGE_POINTS );
 
     m_pcbModel->SetMaxError( m_board->GetDesignSettings().m_MaxError );
+    m_pcbModel->SetFastBoardHoles( m_params.m_fastBoardHoles );
 
     // For copper layers, only pads and tracks are added, because adding everything on copper
     // generate unreasonable file sizes and take a unreasonable calculation time.
@@ -422,6 +450,10 @@ bool EXPORTER_STEP::buildBoard3DShapes()
             buildGraphic3DShape( item, origin );
     }
 
+    // Build the queued pad, via and track shapes across all cores
+    m_pcbModel->AddCopperItemShapes( m_copperItems, origin, ExportTracksAndVias() );
+    m_copperItems.clear();
+
     m_pcbModel->AddCopperPolygonShapes( &m_top_copper_shapes, true, origin, true );
     m_pcbModel->AddCopperPolygonShapes( &m_bottom_copper_shapes, false, origin, true );
 
@@ -56,6 +56,7 @@ public:
             m_boardOnly( false ),
             m_exportTracks( false ),
             m_exportZones( false ),
+            m_fastBoardHoles( false ),
             m_format( FORMAT::STEP )
     {};
 
@@ -79,6 +80,7 @@ public:
     bool     m_boardOnly;
     bool     m_exportTracks;
     bool     m_exportZones;
+    bool     m_fastBoardHoles;  ///< Cut board body holes in 2D (see STEP_PCB_MODEL)
     FORMAT   m_format;
 
     wxString GetDefaultExportExtension();
@@ -130,6 +132,9 @@ private:
     SHAPE_POLY_SET  m_top_copper_shapes;
     SHAPE_POLY_SET  m_bottom_copper_shapes;
 
+    /// Pads, vias and track segments waiting for their 3D shapes to be built
+    std::vector<const BOARD_ITEM*> m_copperItems;
+
     KIGFX::COLOR4D  m_solderMaskColor;
     KIGFX::COLOR4D  m_copperColor;
 };
@@ -24,9 +24,13 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <wx/filename.h>
 #include <wx/filefn.h>
@@ -43,6 +47,7 @@
 #include <string_utils.h>
 #include <build_version.h>
 #include <geometry/shape_segment.h>
+#include <core/thread_pool.h>
 
 #include "step_pcb_model.h"
 #include "streamwrapper.h"
@@ -71,6 +76,7 @@
 #include <BRep_Tool.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepBuilderAPI.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
 #include <BRepBuilderAPI_GTransform.hxx>
@@ -104,6 +110,114 @@
 
 #include <macros.h>
 
+/**
+ * Documents read from STEP/IGES model files, kept across exports so that re-exporting a board
+ * only re-reads the models which have changed.
+ *
+ * Entries are keyed by file name and only handed out while the file's modification time and
+ * size match those it was read at.  At most MAX_DOCS documents are kept; the least recently
+ * used ones are dropped first, and closed once no export is using them any more.
+ */
+class IMPORTED_DOC_CACHE
+{
+public:
+    static IMPORTED_DOC_CACHE& Instance()
+    {
+        static IMPORTED_DOC_CACHE s_instance;
+        return s_instance;
+    }
+
+    Handle( TDocStd_Document ) Find( const std::string& aFileName, const std::string& aStamp )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_index.find( aFileName );
+
+        if( it == m_index.end() )
+            return Handle( TDocStd_Document )();
+
+        if( it->second->m_stamp != aStamp )
+        {
+            // The file has changed since it was read
+            drop( it->second );
+            return Handle( TDocStd_Document )();
+        }
+
+        m_lru.splice( m_lru.begin(), m_lru, it->second );
+        return it->second->m_doc;
+    }
+
+    void Store( const std::string& aFileName, const std::string& aStamp,
+                const Handle( TDocStd_Document )& aDoc )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_index.find( aFileName );
+
+        if( it != m_index.end() )
+            drop( it->second );
+
+        m_lru.push_front( { aFileName, aStamp, aDoc } );
+        m_index[ aFileName ] = m_lru.begin();
+
+        while( m_lru.size() > MAX_DOCS )
+            drop( std::prev( m_lru.end() ) );
+
+        closeDropped();
+    }
+
+    /**
+     * Close the dropped documents which are no longer used.  Called by exports once they have
+     * released their documents.
+     */
+    void CloseUnused()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        closeDropped();
+    }
+
+private:
+    static constexpr size_t MAX_DOCS = 128;
+
+    struct ENTRY
+    {
+        std::string                m_fileName;
+        std::string                m_stamp;
+        Handle( TDocStd_Document ) m_doc;
+    };
+
+    void drop( std::list<ENTRY>::iterator aEntry )
+    {
+        m_dropped.push_back( aEntry->m_doc );
+        m_index.erase( aEntry->m_fileName );
+        m_lru.erase( aEntry );
+    }
+
+    void closeDropped()
+    {
+        for( auto it = m_dropped.begin(); it != m_dropped.end(); )
+        {
+            // Exports hold their documents until they are done; a document only held here
+            // isn't used any more.
+            if( ( *it )->GetRefCount() == 1 )
+            {
+                ( *it )->Close();
+                it = m_dropped.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    std::mutex                                                  m_mutex;
+    std::list<ENTRY>                                            m_lru;
+    std::unordered_map<std::string, std::list<ENTRY>::iterator> m_index;
+    std::vector<Handle( TDocStd_Document )>                     m_dropped;
+};
+
+
 static constexpr double USER_PREC = 1e-4;
 static constexpr double USER_ANGLE_PREC = 1e-6;
 
@@ -195,6 +309,7 @@ STEP_PCB_MODEL::STEP_PCB_MODEL( const wxString& aPcbName )
     m_assy = XCAFDoc_DocumentTool::ShapeTool( m_doc->Main() );
     m_assy_label = m_assy->NewShape();
     m_hasPCB = false;
+    m_fastBoardHoles = false;
     m_components = 0;
     m_precision = USER_PREC;
     m_angleprec = USER_ANGLE_PREC;
@@ -210,10 +325,21 @@ STEP_PCB_MODEL::STEP_PCB_MODEL( const wxString& aPcbName )
 
 STEP_PCB_MODEL::~STEP_PCB_MODEL()
 {
+    // The imported documents belong to IMPORTED_DOC_CACHE, which closes them once dropped
+    m_importedDocs.clear();
+    IMPORTED_DOC_CACHE::Instance().CloseUnused();
+
     m_doc->Close();
 }
 
 bool STEP_PCB_MODEL::AddPadShape( const PAD* aPad, const VECTOR2D& aOrigin )
+{
+    return addPadShape( aPad, aOrigin, m_board_copper_pads );
+}
+
+
+bool STEP_PCB_MODEL::addPadShape( const PAD* aPad, const VECTOR2D& aOrigin,
+                                  std::vector<TopoDS_Shape>& aPadShapes )
 {
     const std::shared_ptr<SHAPE_POLY_SET>& pad_shape = aPad->GetEffectivePolygon( ERROR_INSIDE );
     bool success = true;
@@ -237,12 +363,11 @@ bool STEP_PCB_MODEL::AddPadShape( const PAD* aPad, const VECTOR2D& aOrigin )
                                               -pcbIUScale.IUTomm( pos.y - aOrigin.y ),
                                               Zpos ) );
                 BRepBuilderAPI_Transform round_shape( curr_shape, shift );
-                m_board_copper_pads.push_back( round_shape.Shape() );
+                aPadShapes.push_back( round_shape.Shape() );
             }
             else
             {
-                success = MakeShapes( m_board_copper_pads, *pad_shape, m_copperThickness, Zpos,
-                                      aOrigin );
+                success = MakeShapes( aPadShapes, *pad_shape, m_copperThickness, Zpos, aOrigin );
             }
         }
 
@@ -258,6 +383,14 @@ bool STEP_PCB_MODEL::AddPadShape( const PAD* aPad, const VECTOR2D& aOrigin )
 
 
 bool STEP_PCB_MODEL::AddViaShape( const PCB_VIA* aVia, const VECTOR2D& aOrigin )
+{
+    return addViaShape( aVia, aOrigin, m_cutouts, m_holes2D, m_board_copper_pads );
+}
+
+
+bool STEP_PCB_MODEL::addViaShape( const PCB_VIA* aVia, const VECTOR2D& aOrigin,
+                                  std::vector<TopoDS_Shape>& aCutouts, SHAPE_POLY_SET& aHoles2D,
+                                  std::vector<TopoDS_Shape>& aPadShapes )
 {
     // A via is very similar to a round pad. So, for now, used AddPadHole() to
     // create a via+hole shape
@@ -267,9 +400,9 @@ bool STEP_PCB_MODEL::AddViaShape( const PCB_VIA* aVia, const VECTOR2D& aOrigin )
     dummy.SetPosition( aVia->GetStart() );
     dummy.SetSize( VECTOR2I( aVia->GetWidth(), aVia->GetWidth() ) );
 
-    if( AddPadHole( &dummy, aOrigin ) )
+    if( addPadHole( &dummy, aOrigin, aCutouts, aHoles2D ) )
     {
-        if( !AddPadShape( &dummy, aOrigin ) )
+        if( !addPadShape( &dummy, aOrigin, aPadShapes ) )
             return false;
     }
 
@@ -278,6 +411,13 @@ bool STEP_PCB_MODEL::AddViaShape( const PCB_VIA* aVia, const VECTOR2D& aOrigin )
 
 
 bool STEP_PCB_MODEL::AddTrackSegment( const PCB_TRACK* aTrack, const VECTOR2D& aOrigin )
+{
+    return addTrackSegment( aTrack, aOrigin, m_board_copper_tracks );
+}
+
+
+bool STEP_PCB_MODEL::addTrackSegment( const PCB_TRACK* aTrack, const VECTOR2D& aOrigin,
+                                      std::vector<TopoDS_Shape>& aTrackShapes )
 {
     PCB_LAYER_ID pcblayer = aTrack->GetLayer();
 
@@ -292,7 +432,7 @@ bool STEP_PCB_MODEL::AddTrackSegment( const PCB_TRACK* aTrack, const VECTOR2D& a
                                             zposition, aOrigin );
 
     if( success )
-        m_board_copper_tracks.push_back( shape );
+        aTrackShapes.push_back( shape );
 
     return success;
 }
@@ -319,11 +459,164 @@ bool STEP_PCB_MODEL::AddCopperPolygonShapes( const SHAPE_POLY_SET* aPolyShapes,
 }
 
 
+bool STEP_PCB_MODEL::AddCopperItemShapes( const std::vector<const BOARD_ITEM*>& aItems,
+                                          const VECTOR2D& aOrigin, bool aWithCopper )
+{
+    // Each task builds the shapes of a contiguous range of items into its own lists.  The
+    // lists are then appended in range order so the resulting model does not depend on the
+    // scheduling of the tasks.
+    struct ITEM_SHAPES
+    {
+        std::vector<TopoDS_Shape> m_cutouts;
+        SHAPE_POLY_SET            m_holes2D;
+        std::vector<TopoDS_Shape> m_pads;
+        std::vector<TopoDS_Shape> m_tracks;
+        bool                      m_success = true;
+    };
+
+    auto buildRange =
+            [&]( const size_t aStart, const size_t aEnd ) -> ITEM_SHAPES
+            {
+                ITEM_SHAPES shapes;
+
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    const BOARD_ITEM* item = aItems[ii];
+
+                    try
+                    {
+                        switch( item->Type() )
+                        {
+                        case PCB_PAD_T:
+                        {
+                            const PAD* pad = static_cast<const PAD*>( item );
+
+                            addPadHole( pad, aOrigin, shapes.m_cutouts, shapes.m_holes2D );
+
+                            if( aWithCopper && !addPadShape( pad, aOrigin, shapes.m_pads ) )
+                                shapes.m_success = false;
+
+                            break;
+                        }
+
+                        case PCB_VIA_T:
+                            if( !addViaShape( static_cast<const PCB_VIA*>( item ), aOrigin,
+                                              shapes.m_cutouts, shapes.m_holes2D, shapes.m_pads ) )
+                            {
+                                shapes.m_success = false;
+                            }
+
+                            break;
+
+                        case PCB_TRACE_T:
+                            if( !addTrackSegment( static_cast<const PCB_TRACK*>( item ), aOrigin,
+                                                  shapes.m_tracks ) )
+                            {
+                                shapes.m_success = false;
+                            }
+
+                            break;
+
+                        default:
+                            wxFAIL_MSG( wxT( "AddCopperItemShapes: unhandled item type" ) );
+                            break;
+                        }
+                    }
+                    catch( const Standard_Failure& e )
+                    {
+                        ReportMessage( wxString::Format( wxT( "OCC exception building item "
+                                                              "shape: %s\n" ),
+                                                         e.GetMessageString() ) );
+                        shapes.m_success = false;
+                    }
+                }
+
+                return shapes;
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         results = tp.parallelize_loop( 0, aItems.size(), buildRange );
+    bool         success = true;
+
+    for( ITEM_SHAPES& shapes : results.get() )
+    {
+        std::move( shapes.m_cutouts.begin(), shapes.m_cutouts.end(),
+                   std::back_inserter( m_cutouts ) );
+        m_holes2D.Append( shapes.m_holes2D );
+        std::move( shapes.m_pads.begin(), shapes.m_pads.end(),
+                   std::back_inserter( m_board_copper_pads ) );
+        std::move( shapes.m_tracks.begin(), shapes.m_tracks.end(),
+                   std::back_inserter( m_board_copper_tracks ) );
+
+        success &= shapes.m_success;
+    }
+
+    return success;
+}
+
+
+bool STEP_PCB_MODEL::AddCopperZoneShapes( const std::vector<SHAPE_POLY_SET>& aPolyShapes,
+                                          const std::vector<bool>& aOnTop,
+                                          const VECTOR2D& aOrigin )
+{
+    wxCHECK( aPolyShapes.size() == aOnTop.size(), false );
+
+    std::vector<std::vector<TopoDS_Shape>> zoneShapes( aPolyShapes.size() );
+    std::vector<uint8_t>                   zoneSuccess( aPolyShapes.size(), 1 );
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.push_loop( aPolyShapes.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    double z_pos = aOnTop[ii] ? m_boardThickness : -m_copperThickness;
+
+                    if( !MakeShapes( zoneShapes[ii], aPolyShapes[ii], m_copperThickness, z_pos,
+                                     aOrigin ) )
+                    {
+                        ReportMessage( wxString::Format(
+                                wxT( "Could not add shape (%d points) to copper layer on %s.\n" ),
+                                aPolyShapes[ii].FullPointCount(),
+                                aOnTop[ii] ? wxT( "top" ) : wxT( "bottom" ) ) );
+
+                        zoneSuccess[ii] = 0;
+                    }
+                }
+            } );
+    tp.wait_for_tasks();
+
+    for( std::vector<TopoDS_Shape>& shapes : zoneShapes )
+    {
+        std::move( shapes.begin(), shapes.end(), std::back_inserter( m_board_copper_zones ) );
+    }
+
+    return std::all_of( zoneSuccess.begin(), zoneSuccess.end(),
+                        []( uint8_t aSuccess )
+                        {
+                            return aSuccess != 0;
+                        } );
+}
+
+
 bool STEP_PCB_MODEL::AddPadHole( const PAD* aPad, const VECTOR2D& aOrigin )
+{
+    return addPadHole( aPad, aOrigin, m_cutouts, m_holes2D );
+}
+
+
+bool STEP_PCB_MODEL::addPadHole( const PAD* aPad, const VECTOR2D& aOrigin,
+                                 std::vector<TopoDS_Shape>& aCutouts, SHAPE_POLY_SET& aHoles2D )
 {
     if( aPad == nullptr || !aPad->GetDrillSize().x )
         return false;
 
+    // The board body holes are cut in 2D; keep an outline which is never smaller than the
+    // real hole.
+    if( m_fastBoardHoles )
+        aPad->TransformHoleToPolygon( aHoles2D, 0, m_maxError, ERROR_OUTSIDE );
+
     VECTOR2I pos = aPad->GetPosition();
     const double margin = 0.01;     // a small margin on the Z axix to be sure the hole
                                     // is bigget than the board with copper
@@ -339,7 +632,7 @@ bool STEP_PCB_MODEL::AddPadHole( const PAD* aPad, const VECTOR2D& aOrigin )
                                       -pcbIUScale.IUTomm( pos.y - aOrigin.y ),
                                       -m_copperThickness - margin ) );
         BRepBuilderAPI_Transform hole( s, shift );
-        m_cutouts.push_back( hole.Shape() );
+        aCutouts.push_back( hole.Shape() );
         return true;
     }
 
@@ -375,7 +668,7 @@ bool STEP_PCB_MODEL::AddPadHole( const PAD* aPad, const VECTOR2D& aOrigin )
                                  width, holeZsize, -m_copperThickness - margin,
                                  aOrigin ) )
     {
-        m_cutouts.push_back( hole );
+        aCutouts.push_back( hole );
     }
     else
     {
@@ -897,14 +1190,38 @@ bool STEP_PCB_MODEL::CreatePCB( SHAPE_POLY_SET& aOutline, VECTOR2D aOrigin )
 
         ReportMessage( wxString::Format( wxT( "Build board main outline %d with %d points.\n" ),
                                          cnt + 1, outline.PointCount() ) );
+    }
 
-        if( !MakeShapes( m_board_outlines, aOutline, m_boardThickness, 0.0, aOrigin ) )
-        {
-            // Error
-            ReportMessage( wxString::Format(
-                    wxT( "OCC error adding main outline polygon %d with %d points.\n" ), cnt + 1,
-                    outline.PointCount() ) );
-        }
+    // MakeShapes() builds one prism per polygon, so all the main outlines are done in one go.
+    bool outlinesOk;
+
+    if( m_fastBoardHoles && m_holes2D.OutlineCount() )
+    {
+        // Every hole goes right through the board body, so removing the holes from the outline
+        // before extrusion gives the same solid as the 3D cut at a tiny fraction of the cost.
+        // The price is that round holes become polygons.
+        ReportMessage( wxString::Format( wxT( "Remove %d hole(s) from board outline.\n" ),
+                                         m_holes2D.OutlineCount() ) );
+
+        SHAPE_POLY_SET outlineWithHoles = aOutline;
+
+        m_holes2D.Simplify( SHAPE_POLY_SET::PM_FAST );
+        outlineWithHoles.BooleanSubtract( m_holes2D, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+        outlinesOk = MakeShapes( m_board_outlines, outlineWithHoles, m_boardThickness, 0.0,
+                                 aOrigin );
+    }
+    else
+    {
+        outlinesOk = MakeShapes( m_board_outlines, aOutline, m_boardThickness, 0.0, aOrigin );
+    }
+
+    if( !outlinesOk )
+    {
+        // Error
+        ReportMessage( wxString::Format( wxT( "OCC error adding main outline polygons (%d "
+                                              "outline(s)).\n" ),
+                                         aOutline.OutlineCount() ) );
     }
 
     // subtract cutouts (if any)
@@ -926,49 +1243,90 @@ bool STEP_PCB_MODEL::CreatePCB( SHAPE_POLY_SET& aOutline, VECTOR2D aOrigin )
 
         bsb.Initialize( holeBoxSet );
 
+        thread_pool& tp = GetKiCadThreadPool();
+
         auto subtractShapes = [&]( const wxString& aWhat, std::vector<TopoDS_Shape>& aShapesList )
         {
-            // Remove holes for each item (board body or bodies, one can have more than one board)
-            int cnt = 0;
-            for( TopoDS_Shape& shape : aShapesList )
-            {
-                Bnd_Box shapeBbox;
-                BRepBndLib::Add( shape, shapeBbox );
-
-                const TColStd_ListOfInteger& indices = bsb.Compare( shapeBbox );
-
-                TopTools_ListOfShape holelist;
-
-                for( const Standard_Integer& index : indices )
-                    holelist.Append( m_cutouts[index] );
+            if( aShapesList.empty() )
+                return;
 
-                if( cnt == 0 )
-                    ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
+            ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
 
-                cnt++;
+            // Gather the candidate holes of each shape first: Bnd_BoundSortBox::Compare()
+            // returns a reference to internal storage, so it can't be queried concurrently.
+            std::vector<TopTools_ListOfShape> holeLists( aShapesList.size() );
 
-                if( cnt % 10 == 0 )
-                    ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), cnt,
-                                                     (int) aShapesList.size(), aWhat ) );
-
-                if( holelist.IsEmpty() )
-                    continue;
-
-                TopTools_ListOfShape cutArgs;
-                cutArgs.Append( shape );
+            for( size_t ii = 0; ii < aShapesList.size(); ++ii )
+            {
+                Bnd_Box shapeBbox;
+                BRepBndLib::Add( aShapesList[ii], shapeBbox );
 
-                BRepAlgoAPI_Cut cut;
-                cut.SetArguments( cutArgs );
+                for( const Standard_Integer& index : bsb.Compare( shapeBbox ) )
+                    holeLists[ii].Append( m_cutouts[index] );
+            }
 
-                cut.SetTools( holelist );
-                cut.Build();
+            // With only a few shapes (typically the board bodies) there is little to spread
+            // across our threads, so let OCC parallelize inside each boolean instead.
+            bool             occParallel = aShapesList.size() < tp.get_thread_count();
+            std::atomic<int> done( 0 );
 
-                shape = cut.Shape();
-            }
+            tp.push_loop( aShapesList.size(),
+                    [&]( const int a, const int b )
+                    {
+                        for( int ii = a; ii < b; ++ii )
+                        {
+                            if( !holeLists[ii].IsEmpty() )
+                            {
+                                try
+                                {
+                                    // Neighbouring shapes share hole tools.  OCC booleans may
+                                    // touch up the topology they are given, so each task cuts
+                                    // with its own copies and leaves its inputs untouched.
+                                    TopTools_ListOfShape cutArgs;
+                                    TopTools_ListOfShape cutTools;
+                                    cutArgs.Append( aShapesList[ii] );
+
+                                    for( const TopoDS_Shape& hole : holeLists[ii] )
+                                        cutTools.Append( BRepBuilderAPI_Copy( hole ).Shape() );
+
+                                    BRepAlgoAPI_Cut cut;
+                                    cut.SetRunParallel( occParallel );
+                                    cut.SetNonDestructive( Standard_True );
+                                    cut.SetArguments( cutArgs );
+                                    cut.SetTools( cutTools );
+                                    cut.Build();
+
+                                    if( cut.IsDone() )
+                                        aShapesList[ii] = cut.Shape();
+                                }
+                                catch( const Standard_Failure& e )
+                                {
+                                    ReportMessage( wxString::Format( wxT( "Cutting %s: OCC "
+                                                                          "exception: %s\n" ),
+                                                                     aWhat,
+                                                                     e.GetMessageString() ) );
+                                }
+                            }
+
+                            int count = ++done;
+
+                            if( count % 100 == 0 )
+                            {
+                                ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), count,
+                                                                 (int) aShapesList.size(),
+                                                                 aWhat ) );
+                            }
+                        }
+                    } );
+            tp.wait_for_tasks();
         };
 
         subtractShapes( _( "pads" ), m_board_copper_pads );
-        subtractShapes( _( "shapes" ), m_board_outlines );
+
+        // In fast mode the board body holes were already removed in 2D
+        if( !m_fastBoardHoles )
+            subtractShapes( _( "shapes" ), m_board_outlines );
+
         subtractShapes( _( "tracks" ), m_board_copper_tracks );
         subtractShapes( _( "zones" ), m_board_copper_zones );
     }
@@ -1167,7 +1525,6 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
     aLabel.Nullify();
 
     Handle( TDocStd_Document )  doc;
-    m_app->NewDocument( "MDTV-XCAF", doc );
 
     wxString fileName( wxString::FromUTF8( aFileNameUTF8.c_str() ) );
     MODEL3D_FORMAT_TYPE modelFmt = fileType( aFileNameUTF8.c_str() );
@@ -1175,22 +1532,50 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
     switch( modelFmt )
     {
     case FMT_IGES:
-        if( !readIGES( doc, aFileNameUTF8.c_str() ) )
+    case FMT_STEP:
+    {
+        // A model used at several scales is only looked up once per export
+        auto cachedDoc = m_importedDocs.find( aFileNameUTF8 );
+
+        if( cachedDoc != m_importedDocs.end() )
+        {
+            doc = cachedDoc->second;
+            break;
+        }
+
+        // Documents are kept across exports, so re-exporting a board only re-reads the models
+        // which have changed
+        wxFileName  modelFile( fileName );
+        std::string stamp = std::to_string( modelFile.GetModificationTime().GetTicks() ) + "_"
+                            + modelFile.GetSize().ToString().ToStdString();
+
+        doc = IMPORTED_DOC_CACHE::Instance().Find( aFileNameUTF8, stamp );
+
+        if( !doc.IsNull() )
+        {
+            m_importedDocs[ aFileNameUTF8 ] = doc;
+            break;
+        }
+
+        m_app->NewDocument( "MDTV-XCAF", doc );
+
+        if( modelFmt == FMT_IGES && !readIGES( doc, aFileNameUTF8.c_str() ) )
         {
             ReportMessage( wxString::Format( wxT( "readIGES() failed on filename '%s'.\n" ),
                                              fileName ) );
             return false;
         }
-        break;
-
-    case FMT_STEP:
-        if( !readSTEP( doc, aFileNameUTF8.c_str() ) )
+        else if( modelFmt == FMT_STEP && !readSTEP( doc, aFileNameUTF8.c_str() ) )
         {
             ReportMessage( wxString::Format( wxT( "readSTEP() failed on filename '%s'.\n" ),
                                              fileName ) );
             return false;
         }
+
+        IMPORTED_DOC_CACHE::Instance().Store( aFileNameUTF8, stamp, doc );
+        m_importedDocs[ aFileNameUTF8 ] = doc;
         break;
+    }
 
     case FMT_STEPZ:
     {
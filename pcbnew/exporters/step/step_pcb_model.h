@@ -67,6 +67,7 @@ static constexpr double COPPER_THICKNESS_DEFAULT_MM = 0.035;
 // Max error to approximate an arc by segments (in mm)
 static constexpr double ARC_TO_SEGMENT_MAX_ERROR_MM = 0.005;
 
+class BOARD_ITEM;
 class PAD;
 
 typedef std::pair< std::string, TDF_Label > MODEL_DATUM;
@@ -96,6 +97,27 @@ public:
     bool AddCopperPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, bool aOnTop,
                                  const VECTOR2D& aOrigin, bool aTrack );
 
+    /**
+     * Add the holes and copper shapes of many pads, vias and track segments, building the
+     * OCC shapes on the thread pool.
+     *
+     * The result is the same as calling AddPadHole() (and AddPadShape() if \a aWithCopper),
+     * AddViaShape() or AddTrackSegment() on each item in order.
+     *
+     * @param aItems is a list of PADs, PCB_VIAs and (non-arc) PCB_TRACKs.
+     * @param aWithCopper is true to build pad copper as well as pad holes.
+     * @return false if any shape could not be built.
+     */
+    bool AddCopperItemShapes( const std::vector<const BOARD_ITEM*>& aItems,
+                              const VECTOR2D& aOrigin, bool aWithCopper );
+
+    /**
+     * Add zone copper polygons, building the OCC shapes for each polygon set on the thread
+     * pool.  \a aOnTop gives the side of each entry of \a aPolyShapes.
+     */
+    bool AddCopperZoneShapes( const std::vector<SHAPE_POLY_SET>& aPolyShapes,
+                              const std::vector<bool>& aOnTop, const VECTOR2D& aOrigin );
+
     // add a component at the given position and orientation
     bool AddComponent( const std::string& aFileName, const std::string& aRefDes, bool aBottom,
                        VECTOR2D aPosition, double aRotation, VECTOR3D aOffset,
@@ -116,6 +138,14 @@ public:
 
     void SetMaxError( int aMaxError ) { m_maxError = aMaxError; }
 
+    /**
+     * Remove the holes from the board body outline in 2D, before extrusion, instead of cutting
+     * them from the extruded body.  This is dramatically faster on boards with many holes,
+     * but round holes in the board body become polygonal.  Must be set before any hole is
+     * added.
+     */
+    void SetFastBoardHoles( bool aEnable ) { m_fastBoardHoles = aEnable; }
+
     // create the PCB model using the current outlines and drill holes
     bool CreatePCB( SHAPE_POLY_SET& aOutline, VECTOR2D aOrigin );
 
@@ -197,9 +227,24 @@ private:
      */
     bool createOneBoard( int aIdx, SHAPE_POLY_SET& aOutline, VECTOR2D aOrigin );
 
+    // Implementations of the Add*() functions which append to the given lists rather than to
+    // the model's, so they can run concurrently.
+    bool addPadHole( const PAD* aPad, const VECTOR2D& aOrigin,
+                     std::vector<TopoDS_Shape>& aCutouts, SHAPE_POLY_SET& aHoles2D );
+    bool addPadShape( const PAD* aPad, const VECTOR2D& aOrigin,
+                      std::vector<TopoDS_Shape>& aPadShapes );
+    bool addViaShape( const PCB_VIA* aVia, const VECTOR2D& aOrigin,
+                      std::vector<TopoDS_Shape>& aCutouts, SHAPE_POLY_SET& aHoles2D,
+                      std::vector<TopoDS_Shape>& aPadShapes );
+    bool addTrackSegment( const PCB_TRACK* aTrack, const VECTOR2D& aOrigin,
+                          std::vector<TopoDS_Shape>& aTrackShapes );
+
     /**
      * Load a 3D model data.
      *
+     * STEP and IGES files are read once per process and the imported documents are reused
+     * by later exports as long as the file's modification time and size are unchanged.
+     *
      * @param aFileNameUTF8 is the filename encoded UTF8 (different formats allowed)
      * but for WRML files a model data can be loaded instead of the vrml data,
      * not suitable in a step file.
@@ -240,9 +285,18 @@ private:
     double                          m_mergeOCCMaxDist;  // minimum distance (mm) below which two
                                                         // points are considered coincident by OCC
 
+    // STEP/IGES documents used by this export, keyed by file name.  They are shared with
+    // later exports through IMPORTED_DOC_CACHE; holding them here keeps them open until the
+    // export is done.
+    std::map<std::string, Handle( TDocStd_Document )> m_importedDocs;
+
     // Holes in main outlines (more than one board)
     std::vector<TopoDS_Shape>       m_cutouts;
 
+    // 2D outlines of the same holes, used when m_fastBoardHoles is set
+    SHAPE_POLY_SET                  m_holes2D;
+    bool                            m_fastBoardHoles;
+
     // Main outlines (more than one board)
     std::vector<TopoDS_Shape> m_board_outlines;
     std::vector<TopoDS_Shape> m_board_copper_zones;
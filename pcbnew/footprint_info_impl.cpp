@@ -40,6 +40,13 @@
 #include <wx/txtstrm.h>
 #include <wx/wfstream.h>
 
+#include <optional>
+#include <set>
+
+
+/// First line of the fp-info-cache file.  Bump when the layout changes.
+static const wxString FP_INFO_CACHE_VERSION = wxS( "#fp-info-cache 2" );
+
 
 void FOOTPRINT_INFO_IMPL::load()
 {
@@ -118,31 +125,80 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
 
     m_progress_reporter = aProgressReporter;
 
-    if( m_progress_reporter )
-    {
-        m_progress_reporter->SetMaxProgress( m_queue_in.size() );
-        m_progress_reporter->Report( _( "Fetching footprint libraries..." ) );
-    }
-
     m_cancelled = false;
     m_lib_table = aTable;
 
     // Clear data before reading files
     m_errors.clear();
-    m_list.clear();
     m_queue_in.clear();
     m_queue_out.clear();
 
+    std::vector<wxString>         nicknames;
+    std::map<wxString, long long> libTimestamps;
+    std::set<wxString>            unchangedLibs;
+    bool                          needsCLocale = false;
+
     if( aNickname )
-    {
-        m_queue_in.push( *aNickname );
-    }
+        nicknames.push_back( *aNickname );
     else
+        nicknames = aTable->GetLogicalLibs();
+
+    for( const wxString& nickname : nicknames )
     {
-        for( const wxString& nickname : aTable->GetLogicalLibs() )
+        long long libTimestamp = 0;
+
+        // A library we can't timestamp is simply re-read; any real error will be reported
+        // when it is loaded.
+        try
+        {
+            libTimestamp = aTable->GenerateTimestamp( &nickname );
+        }
+        catch( ... )
+        {
+        }
+
+        auto it = m_lib_timestamps.find( nickname );
+
+        // When reading a single library the list is replaced wholesale, so only the full
+        // read can reuse entries.
+        if( !aNickname && libTimestamp && it != m_lib_timestamps.end()
+                && it->second == libTimestamp )
+        {
+            unchangedLibs.insert( nickname );
+        }
+        else
+        {
             m_queue_in.push( nickname );
+            needsCLocale |= !aTable->IsLocaleIndependent( nickname );
+        }
+
+        libTimestamps[ nickname ] = libTimestamp;
     }
 
+    // Keep the entries of unchanged libraries; everything else gets re-read below.
+    FPILIST keep;
+
+    for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : m_list )
+    {
+        if( unchangedLibs.count( fpinfo->GetLibNickname() ) )
+            keep.push_back( std::move( fpinfo ) );
+    }
+
+    m_list = std::move( keep );
+
+    if( m_progress_reporter )
+    {
+        m_progress_reporter->SetMaxProgress( m_queue_in.size() );
+        m_progress_reporter->Report( _( "Fetching footprint libraries..." ) );
+    }
+
+    // The KiCad plugin parses numbers without help from the C locale, but the others still
+    // switch it while they work.  The locale is GLOBAL: it is only thread safe to set it before
+    // the workers start and restore it after they all finish, so only do so if it's needed.
+    std::optional<LOCALE_IO> toggle_locale;
+
+    if( needsCLocale )
+        toggle_locale.emplace();
 
     loadLibs();
 
@@ -162,9 +218,15 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
     }
 
     if( m_cancelled )
+    {
         m_list_timestamp = 0;       // God knows what we got before we were canceled
+        m_lib_timestamps.clear();
+    }
     else
+    {
         m_list_timestamp = generatedTimestamp;
+        m_lib_timestamps = std::move( libTimestamps );
+    }
 
     return m_errors.empty();
 }
@@ -219,15 +281,6 @@ void FOOTPRINT_LIST_IMPL::loadLibs()
 
 void FOOTPRINT_LIST_IMPL::loadFootprints()
 {
-    LOCALE_IO toggle_locale;
-
-    // Parse the footprints in parallel. WARNING! This requires changing the locale, which is
-    // GLOBAL. It is only thread safe to construct the LOCALE_IO before the threads are created,
-    // destroy it after they finish, and block the main (GUI) thread while they work. Any deviation
-    // from this will cause nasal demons.
-    //
-    // TODO: blast LOCALE_IO into the sun
-
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
     thread_pool&                                tp = GetKiCadThreadPool();
     size_t                                      num_elements = m_queue_out.size();
@@ -317,7 +370,18 @@ void FOOTPRINT_LIST_IMPL::WriteCacheToFile( const wxString& aFilePath )
         return;
     }
 
+    // The per-library timestamps let a later session re-read only the libraries which have
+    // changed.  Older readers will fail to parse the version line as a timestamp and so will
+    // discard the file.
+    txtStream << FP_INFO_CACHE_VERSION << endl;
     txtStream << wxString::Format( wxT( "%lld" ), m_list_timestamp ) << endl;
+    txtStream << wxString::Format( wxT( "%zu" ), m_lib_timestamps.size() ) << endl;
+
+    for( const std::pair<const wxString, long long>& libTimestamp : m_lib_timestamps )
+    {
+        txtStream << libTimestamp.first << endl;
+        txtStream << wxString::Format( wxT( "%lld" ), libTimestamp.second ) << endl;
+    }
 
     for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : m_list )
     {
@@ -351,12 +415,26 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
 
     m_list_timestamp = 0;
     m_list.clear();
+    m_lib_timestamps.clear();
 
     try
     {
-        if( cacheFile.Exists() && cacheFile.Open() )
+        if( cacheFile.Exists() && cacheFile.Open()
+                && cacheFile.GetFirstLine() == FP_INFO_CACHE_VERSION )
         {
-            cacheFile.GetFirstLine().ToLongLong( &m_list_timestamp );
+            cacheFile.GetNextLine().ToLongLong( &m_list_timestamp );
+
+            unsigned long libCount = 0;
+            cacheFile.GetNextLine().ToULong( &libCount );
+
+            for( unsigned long ii = 0; ii < libCount; ++ii )
+            {
+                wxString  libNickname = cacheFile.GetNextLine();
+                long long libTimestamp = 0;
+
+                cacheFile.GetNextLine().ToLongLong( &libTimestamp );
+                m_lib_timestamps[ libNickname ] = libTimestamp;
+            }
 
             while( cacheFile.GetCurrentLine() + 6 < cacheFile.GetLineCount() )
             {
@@ -386,6 +464,9 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
     if( m_list.size() == 0 )
         m_list_timestamp = 0;
 
+    if( m_list_timestamp == 0 )
+        m_lib_timestamps.clear();
+
     if( cacheFile.IsOpened() )
         cacheFile.Close();
 }
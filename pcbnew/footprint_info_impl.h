@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -108,6 +109,10 @@ private:
     SYNC_QUEUE<wxString>     m_queue_in;
     SYNC_QUEUE<wxString>     m_queue_out;
     long long                m_list_timestamp;
+
+    /// Timestamp of each library at the time its entries in m_list were read.  Libraries
+    /// whose timestamp hasn't changed are not re-read by ReadFootprintFiles().
+    std::map<wxString, long long> m_lib_timestamps;
     PROGRESS_REPORTER*       m_progress_reporter;
     std::atomic_bool         m_cancelled;
     std::mutex               m_join;
@@ -34,15 +34,25 @@
 #include <board_design_settings.h>
 #include <netinfo.h>
 #include <footprint.h>
+#include <fp_lib_table.h>
+#include <locale_io.h>
 #include <pad.h>
 #include <pcb_track.h>
 #include <zone.h>
 #include <string_utils.h>
 #include <pcbnew_settings.h>
 #include <pcb_edit_frame.h>
+#include <project_pcb.h>
 #include <netlist_reader/pcb_netlist.h>
 #include <connectivity/connectivity_data.h>
 #include <reporter.h>
+#include <trace_helpers.h>
+#include <core/profile.h>
+#include <core/thread_pool.h>
+
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "board_netlist_updater.h"
 
@@ -65,6 +75,24 @@ BOARD_NETLIST_UPDATER::BOARD_NETLIST_UPDATER( PCB_EDIT_FRAME* aFrame, BOARD* aBo
 }
 
 
+BOARD_NETLIST_UPDATER::BOARD_NETLIST_UPDATER( TOOL_MANAGER* aToolManager, BOARD* aBoard ) :
+    m_frame( nullptr ),
+    m_commit( aToolManager ),
+    m_board( aBoard )
+{
+    m_reporter = &NULL_REPORTER::GetInstance();
+
+    m_deleteUnusedFootprints = false;
+    m_isDryRun = false;
+    m_replaceFootprints = true;
+    m_lookupByTimestamp = false;
+
+    m_warningCount = 0;
+    m_errorCount = 0;
+    m_newFootprintsCount = 0;
+}
+
+
 BOARD_NETLIST_UPDATER::~BOARD_NETLIST_UPDATER()
 {
 }
@@ -131,6 +159,141 @@ VECTOR2I BOARD_NETLIST_UPDATER::estimateFootprintInsertionPosition()
 }
 
 
+void BOARD_NETLIST_UPDATER::loadFootprintPrototypes( const std::set<LIB_ID>& aFPIDs )
+{
+    if( !m_frame )
+        return;
+
+    FP_LIB_TABLE* fptbl = PROJECT_PCB::PcbFootprintLibs( &m_frame->Prj() );
+
+    wxCHECK( fptbl, /* void */ );
+
+    // A library's footprints all go through its plugin (and its cache), so each library is
+    // read by a single worker.  Footprints without a library nickname are searched for in
+    // every library, so those are left to instantiateFootprint() on this thread.
+    std::map<wxString, size_t>       libraryIndex;
+    std::vector<std::vector<LIB_ID>> libraries;
+    bool                             needsCLocale = false;
+
+    for( const LIB_ID& fpid : aFPIDs )
+    {
+        if( fpid.GetLibNickname().empty() || m_footprintPrototypes.count( fpid ) )
+            continue;
+
+        auto [it, inserted] = libraryIndex.emplace( fpid.GetLibNickname(), libraries.size() );
+
+        if( inserted )
+        {
+            libraries.emplace_back();
+            needsCLocale |= !fptbl->IsLocaleIndependent( fpid.GetLibNickname() );
+        }
+
+        libraries[it->second].push_back( fpid );
+    }
+
+    if( libraries.empty() )
+        return;
+
+    std::vector<std::vector<FOOTPRINT*>> loaded( libraries.size() );
+
+    for( size_t ii = 0; ii < libraries.size(); ++ii )
+        loaded[ii].resize( libraries[ii].size(), nullptr );
+
+    auto loadLibraries =
+            [&]( size_t aFirst, size_t aLast )
+            {
+                for( size_t ii = aFirst; ii < aLast; ++ii )
+                {
+                    for( size_t jj = 0; jj < libraries[ii].size(); ++jj )
+                    {
+                        try
+                        {
+                            loaded[ii][jj] = fptbl->FootprintLoadWithOptionalNickname(
+                                                                    libraries[ii][jj], false );
+                        }
+                        catch( const IO_ERROR& )
+                        {
+                        }
+                    }
+                }
+            };
+
+    PROF_TIMER timer;
+
+    {
+        // Only the KiCad plugin parses without help from the C locale.  The others switch it,
+        // and it is global: it must be set before the workers start and restored once they're
+        // done.
+        std::optional<LOCALE_IO> toggle;
+
+        if( needsCLocale )
+            toggle.emplace();
+
+        GetKiCadThreadPool().parallelize_loop( 0, libraries.size(), loadLibraries,
+                                               libraries.size() ).wait();
+    }
+
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    int                    count = 0;
+
+    for( size_t ii = 0; ii < libraries.size(); ++ii )
+    {
+        for( size_t jj = 0; jj < libraries[ii].size(); ++jj )
+        {
+            FOOTPRINT* footprint = loaded[ii][jj];
+
+            // Same clean-up as PCB_BASE_FRAME::LoadFootprint()
+            if( footprint )
+            {
+                footprint->ClearAllNets();
+                footprint->ApplyDefaultSettings( *m_board, bds.m_StyleFPFields,
+                                                 bds.m_StyleFPText, bds.m_StyleFPShapes );
+                count++;
+            }
+
+            m_footprintPrototypes[ libraries[ii][jj] ].reset( footprint );
+        }
+    }
+
+    wxLogTrace( traceBoardNetlistUpdater, wxS( "Loaded %d footprints from %d libraries: %.1f ms" ),
+                count, (int) libraries.size(), timer.msecs() );
+}
+
+
+void BOARD_NETLIST_UPDATER::SetFootprintPrototype( const LIB_ID& aFPID,
+                                                   std::unique_ptr<FOOTPRINT> aFootprint )
+{
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+    // Same clean-up as loadFootprintPrototypes()
+    if( aFootprint )
+    {
+        aFootprint->ClearAllNets();
+        aFootprint->ApplyDefaultSettings( *m_board, bds.m_StyleFPFields, bds.m_StyleFPText,
+                                          bds.m_StyleFPShapes );
+    }
+
+    m_footprintPrototypes[ aFPID ] = std::move( aFootprint );
+}
+
+
+FOOTPRINT* BOARD_NETLIST_UPDATER::instantiateFootprint( const LIB_ID& aFPID )
+{
+    auto it = m_footprintPrototypes.find( aFPID );
+
+    if( it == m_footprintPrototypes.end() )
+    {
+        FOOTPRINT* prototype = m_frame ? m_frame->LoadFootprint( aFPID ) : nullptr;
+        it = m_footprintPrototypes.emplace( aFPID, prototype ).first;
+    }
+
+    if( !it->second )
+        return nullptr;
+
+    return static_cast<FOOTPRINT*>( it->second->Duplicate() );
+}
+
+
 FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent )
 {
     wxString msg;
@@ -145,7 +308,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent )
         return nullptr;
     }
 
-    FOOTPRINT* footprint = m_frame->LoadFootprint( aComponent->GetFPID() );
+    FOOTPRINT* footprint = instantiateFootprint( aComponent->GetFPID() );
 
     if( footprint == nullptr )
     {
@@ -171,7 +334,11 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent )
         for( PAD* pad : footprint->Pads() )
         {
             // Set the pads ratsnest settings to the global settings
-            pad->SetLocalRatsnestVisible( m_frame->GetPcbNewSettings()->m_Display.m_ShowGlobalRatsnest );
+            if( m_frame )
+            {
+                pad->SetLocalRatsnestVisible(
+                        m_frame->GetPcbNewSettings()->m_Display.m_ShowGlobalRatsnest );
+            }
 
             // Pads in the library all have orphaned nets.  Replace with Default.
             pad->SetNetCode( 0 );
@@ -215,7 +382,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::replaceFootprint( NETLIST& aNetlist, FOOTPRINT
         return nullptr;
     }
 
-    FOOTPRINT* newFootprint = m_frame->LoadFootprint( aNewComponent->GetFPID() );
+    FOOTPRINT* newFootprint = instantiateFootprint( aNewComponent->GetFPID() );
 
     if( newFootprint == nullptr )
     {
@@ -254,14 +421,15 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::replaceFootprint( NETLIST& aNetlist, FOOTPRINT
 
 
 bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
-                                                       COMPONENT* aNetlistComponent )
+                                                       COMPONENT* aNetlistComponent,
+                                                       bool aCheckOnly )
 {
     wxString msg;
 
     // Create a copy only if the footprint has not been added during this update
     FOOTPRINT* copy = nullptr;
 
-    if( !m_commit.GetStatus( aPcbFootprint ) )
+    if( !aCheckOnly && !m_commit.GetStatus( aPcbFootprint ) )
     {
         copy = static_cast<FOOTPRINT*>( aPcbFootprint->Clone() );
         copy->SetParentGroup( nullptr );
@@ -272,6 +440,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
     // Test for reference designator field change.
     if( aPcbFootprint->GetReference() != aNetlistComponent->GetReference() )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             msg.Printf( _( "Change %s reference designator to %s." ),
@@ -294,6 +465,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
     // Test for value field change.
     if( aPcbFootprint->GetValue() != aNetlistComponent->GetValue() )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             msg.Printf( _( "Change %s value from %s to %s." ),
@@ -320,8 +494,19 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
     if( ( m_replaceFootprints || ( aPcbFootprint->GetAttributes() & FP_JUST_ADDED ) )
         && !m_isDryRun )
     {
-        aPcbFootprint->Footprint().SetText(
-                aNetlistComponent->GetFields()[GetCanonicalFieldName( FOOTPRINT_FIELD )] );
+        const nlohmann::ordered_map<wxString, wxString>& fields = aNetlistComponent->GetFields();
+        auto it = fields.find( GetCanonicalFieldName( FOOTPRINT_FIELD ) );
+        wxString fpName = it != fields.end() ? it->second : wxString();
+
+        if( aCheckOnly )
+        {
+            if( fpName != aPcbFootprint->Footprint().GetText() )
+                return true;
+        }
+        else
+        {
+            aPcbFootprint->Footprint().SetText( fpName );
+        }
     }
 
     // Test for time stamp change.
@@ -332,6 +517,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
 
     if( aPcbFootprint->GetPath() != new_path )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             msg.Printf( _( "Update %s symbol association from %s to %s." ),
@@ -386,6 +574,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
 
     if( !same )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             msg.Printf( _( "Update %s fields." ), aPcbFootprint->GetReference() );
@@ -486,6 +677,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
 
     if( sheetname != aPcbFootprint->GetSheetname() )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             msg.Printf( _( "Update %s sheetname to '%s'." ),
@@ -505,6 +699,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
 
     if( sheetfile != aPcbFootprint->GetSheetfile() )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             msg.Printf( _( "Update %s sheetfile to '%s'." ),
@@ -524,6 +721,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
 
     if( fpFilters != aPcbFootprint->GetFilters() )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             msg.Printf( _( "Update %s footprint filters to '%s'." ),
@@ -544,6 +744,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
     if( ( aNetlistComponent->GetProperties().count( wxT( "exclude_from_bom" ) ) > 0 )
             != ( ( aPcbFootprint->GetAttributes() & FP_EXCLUDE_FROM_BOM ) > 0 ) )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             if( aNetlistComponent->GetProperties().count( wxT( "exclude_from_bom" ) ) )
@@ -584,6 +787,9 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
     if( ( aNetlistComponent->GetProperties().count( wxT( "dnp" ) ) > 0 )
             != ( ( aPcbFootprint->GetAttributes() & FP_DNP ) > 0 ) )
     {
+        if( aCheckOnly )
+            return true;
+
         if( m_isDryRun )
         {
             if( aNetlistComponent->GetProperties().count( wxT( "dnp" ) ) )
@@ -626,19 +832,20 @@ bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
     else if( copy )
         delete copy;
 
-    return true;
+    return changed;
 }
 
 
 bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint,
-                                                           COMPONENT* aNewComponent )
+                                                           COMPONENT* aNewComponent,
+                                                           bool aCheckOnly )
 {
     wxString msg;
 
     // Create a copy only if the footprint has not been added during this update
     FOOTPRINT* copy = nullptr;
 
-    if( !m_commit.GetStatus( aFootprint ) )
+    if( !aCheckOnly && !m_commit.GetStatus( aFootprint ) )
     {
         copy = static_cast<FOOTPRINT*>( aFootprint->Clone() );
         copy->SetParentGroup( nullptr );
@@ -667,12 +874,20 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
             pinType = net.GetPinType();
         }
 
-        if( !m_isDryRun )
+        // A pad left without a net (pads not on copper layers have no net) has no pin function
+        wxString newPinFunction = pad->IsOnCopperLayer() ? pinFunction : wxString();
+
+        if( aCheckOnly )
         {
-            if( pad->GetPinFunction() != pinFunction )
+            if( pad->GetPinFunction() != newPinFunction || pad->GetPinType() != pinType )
+                return true;
+        }
+        else if( !m_isDryRun )
+        {
+            if( pad->GetPinFunction() != newPinFunction )
             {
                 changed = true;
-                pad->SetPinFunction( pinFunction );
+                pad->SetPinFunction( newPinFunction );
             }
 
             if( pad->GetPinType() != pinType )
@@ -689,6 +904,18 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
         // Test if new footprint pad has no net (pads not on copper layers have no net).
         if( !net.IsValid() || !pad->IsOnCopperLayer() )
         {
+            if( aCheckOnly )
+            {
+                // A pad to disconnect, or one to warn about
+                if( !pad->GetNetname().IsEmpty() || pad->GetNetCode() != NETINFO_LIST::UNCONNECTED
+                        || ( pad->IsOnCopperLayer() && !pad->GetNumber().IsEmpty() ) )
+                {
+                    return true;
+                }
+
+                continue;
+            }
+
             if( !pad->GetNetname().IsEmpty() )
             {
                 if( m_isDryRun )
@@ -719,14 +946,11 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
 
             if( !m_isDryRun )
             {
-                changed = true;
-                pad->SetNetCode( NETINFO_LIST::UNCONNECTED );
-
-                // If the pad has no net from netlist (i.e. not in netlist
-                // it cannot have a pin function
-                if( pad->GetNetname().IsEmpty() )
-                    pad->SetPinFunction( wxEmptyString );
-
+                if( pad->GetNetCode() != NETINFO_LIST::UNCONNECTED )
+                {
+                    changed = true;
+                    pad->SetNetCode( NETINFO_LIST::UNCONNECTED );
+                }
             }
             else
             {
@@ -743,6 +967,14 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
                     netName = wxString::Format( wxS( "%s_%d" ), net.GetNetName(), jj );
             }
 
+            if( aCheckOnly )
+            {
+                if( pad->GetNetname() != netName )
+                    return true;
+
+                continue;
+            }
+
             NETINFO_ITEM* netinfo = m_board->FindNet( netName );
 
             if( netinfo && !m_isDryRun )
@@ -833,7 +1065,7 @@ bool BOARD_NETLIST_UPDATER::updateComponentPadConnections( FOOTPRINT* aFootprint
     else if( copy )
         delete copy;
 
-    return true;
+    return changed;
 }
 
 
@@ -1020,10 +1252,20 @@ bool BOARD_NETLIST_UPDATER::updateCopperZoneNets( NETLIST& aNetlist )
                     PCB_LAYER_ID layer = zone->GetLayer();
                     VECTOR2I     pos = zone->GetPosition();
 
+                    auto formatCoord =
+                            [&]( int aValue ) -> wxString
+                            {
+                                if( m_frame )
+                                    return m_frame->MessageTextFromValue( aValue );
+
+                                return EDA_UNIT_UTILS::UI::MessageTextFromValue(
+                                        pcbIUScale, EDA_UNITS::MILLIMETRES, aValue );
+                            };
+
                     msg.Printf( _( "Copper zone on layer %s at (%s, %s) has no pads connected." ),
                                 m_board->GetLayerName( layer ),
-                                m_frame->MessageTextFromValue( pos.x ),
-                                m_frame->MessageTextFromValue( pos.y ) );
+                                formatCoord( pos.x ),
+                                formatCoord( pos.y ) );
                 }
 
                 m_reporter->Report( msg, RPT_SEVERITY_WARNING );
@@ -1087,7 +1329,6 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
 
 bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 {
-    FOOTPRINT* lastPreexistingFootprint = nullptr;
     COMPONENT* component = nullptr;
     wxString   msg;
 
@@ -1097,9 +1338,6 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     std::map<COMPONENT*, FOOTPRINT*> footprintMap;
 
-    if( !m_board->Footprints().empty() )
-        lastPreexistingFootprint = m_board->Footprints().back();
-
     cacheCopperZoneConnections();
 
     // First mark all nets (except <no net>) as stale; we'll update those which are current
@@ -1111,9 +1349,133 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
             net->SetIsCurrent( net->GetNetCode() == 0 );
     }
 
+    PROF_TIMER timer;
+
+    // Index the footprints already on the board by the key components are matched with
+    auto footprintKey =
+            [&]( const FOOTPRINT* aFootprint ) -> wxString
+            {
+                if( m_lookupByTimestamp )
+                    return aFootprint->GetPath().AsString();
+                else
+                    return aFootprint->GetReference().Lower();
+            };
+
+    std::vector<FOOTPRINT*>                            preexistingFootprints;
+    std::unordered_map<wxString, std::vector<size_t>> footprintIndex;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        footprintIndex[ footprintKey( footprint ) ].push_back( preexistingFootprints.size() );
+        preexistingFootprints.push_back( footprint );
+    }
+
+    // Find the footprints matching each component, and whether they need to be updated.  This
+    // only reads the board and the netlist, so it runs on the thread pool; the board is then
+    // updated one component at a time, skipping the footprints which are already up to date.
+    struct FOOTPRINT_MATCH
+    {
+        FOOTPRINT* m_Footprint;
+        bool       m_NeedsUpdate;
+    };
+
+    std::vector<std::vector<FOOTPRINT_MATCH>> matches( aNetlist.GetCount() );
+
+    auto diffComponents =
+            [&]( size_t aFirst, size_t aLast )
+            {
+                for( size_t ii = aFirst; ii < aLast; ++ii )
+                {
+                    COMPONENT*          comp = aNetlist.GetComponent( ii );
+                    std::vector<size_t> found;
+
+                    if( comp->GetProperties().count( wxT( "exclude_from_board" ) ) )
+                        continue;
+
+                    auto lookup =
+                            [&]( const wxString& aKey )
+                            {
+                                auto it = footprintIndex.find( aKey );
+
+                                if( it != footprintIndex.end() )
+                                {
+                                    found.insert( found.end(), it->second.begin(),
+                                                  it->second.end() );
+                                }
+                            };
+
+                    if( m_lookupByTimestamp )
+                    {
+                        for( const KIID& uuid : comp->GetKIIDs() )
+                        {
+                            KIID_PATH base = comp->GetPath();
+                            base.push_back( uuid );
+
+                            lookup( base.AsString() );
+                        }
+
+                        // Keep the board order
+                        std::sort( found.begin(), found.end() );
+                    }
+                    else
+                    {
+                        lookup( comp->GetReference().Lower() );
+                    }
+
+                    for( size_t idx : found )
+                    {
+                        FOOTPRINT* footprint = preexistingFootprints[idx];
+                        bool       needsUpdate = m_replaceFootprints
+                                                 && comp->GetFPID() != footprint->GetFPID();
+
+                        needsUpdate = needsUpdate
+                                      || updateFootprintParameters( footprint, comp, true )
+                                      || updateComponentPadConnections( footprint, comp, true );
+
+                        matches[ii].push_back( { footprint, needsUpdate } );
+                    }
+                }
+            };
+
+    GetKiCadThreadPool().parallelize_loop( 0, aNetlist.GetCount(), diffComponents ).wait();
+
+    wxLogTrace( traceBoardNetlistUpdater, wxS( "Matched and compared %d symbols: %.1f ms" ),
+                (int) aNetlist.GetCount(), timer.msecs() );
+    timer.Start();
+
+    // Load the footprints which are going to be added or exchanged, each of them once
+    std::set<LIB_ID> neededFPIDs;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        if( component->GetFPID().empty()
+                || component->GetProperties().count( wxT( "exclude_from_board" ) ) )
+        {
+            continue;
+        }
+
+        if( matches[i].empty() )
+            neededFPIDs.insert( component->GetFPID() );
+
+        for( const FOOTPRINT_MATCH& match : matches[i] )
+        {
+            if( m_replaceFootprints && component->GetFPID() != match.m_Footprint->GetFPID() )
+                neededFPIDs.insert( component->GetFPID() );
+        }
+    }
+
+    loadFootprintPrototypes( neededFPIDs );
+    timer.Start();
+
     // Next go through the netlist updating all board footprints which have matching component
     // entries and adding new footprints for those that don't.
     //
+    // A footprint matched by several components must be updated each time, as it no longer
+    // is what it was compared with.
+    std::unordered_set<FOOTPRINT*> updatedFootprints;
+
     for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
     {
         component = aNetlist.GetComponent( i );
@@ -1126,57 +1488,29 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
                     component->GetFPID().Format().wx_str() );
         m_reporter->Report( msg, RPT_SEVERITY_INFO );
 
-        int matchCount = 0;
-
-        for( FOOTPRINT* footprint : m_board->Footprints() )
+        for( const FOOTPRINT_MATCH& match : matches[i] )
         {
-            bool match = false;
+            FOOTPRINT* footprint = match.m_Footprint;
+            FOOTPRINT* tmp = footprint;
+            bool       needsUpdate = match.m_NeedsUpdate || updatedFootprints.count( footprint );
 
-            if( m_lookupByTimestamp )
-            {
-                for( const KIID& uuid : component->GetKIIDs() )
-                {
-                    KIID_PATH base = component->GetPath();
-                    base.push_back( uuid );
-
-                    if( footprint->GetPath() == base )
-                    {
-                        match = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
-            }
+            if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
+                tmp = replaceFootprint( aNetlist, footprint, component );
 
-            if( match )
+            if( tmp )
             {
-                FOOTPRINT* tmp = footprint;
+                footprintMap[ component ] = tmp;
 
-                if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
-                    tmp = replaceFootprint( aNetlist, footprint, component );
-
-                if( tmp )
+                if( needsUpdate )
                 {
-                    footprintMap[ component ] = tmp;
-
                     updateFootprintParameters( tmp, component );
                     updateComponentPadConnections( tmp, component );
+                    updatedFootprints.insert( tmp );
                 }
-
-                matchCount++;
-            }
-
-            if( footprint == lastPreexistingFootprint )
-            {
-                // No sense going through the newly-created footprints: end of loop
-                break;
             }
         }
 
-        if( matchCount == 0 )
+        if( matches[i].empty() )
         {
             FOOTPRINT* footprint = addNewFootprint( component );
 
@@ -1188,7 +1522,7 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
                 updateComponentPadConnections( footprint, component );
             }
         }
-        else if( matchCount > 1 )
+        else if( matches[i].size() > 1 )
         {
             msg.Printf( _( "Multiple footprints found for '%s'." ), component->GetReference() );
             m_reporter->Report( msg, RPT_SEVERITY_ERROR );
@@ -1196,8 +1530,36 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         }
     }
 
+    wxLogTrace( traceBoardNetlistUpdater, wxS( "Updated %d footprints, added %d: %.1f ms" ),
+                (int) updatedFootprints.size(), (int) m_addedFootprints.size(), timer.msecs() );
+    timer.Start();
+
     updateCopperZoneNets( aNetlist );
 
+    // Index the components as NETLIST::GetComponentByPath() and GetComponentByReference()
+    // would find them (the first one wins)
+    std::unordered_map<wxString, COMPONENT*> componentIndex;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        COMPONENT* comp = aNetlist.GetComponent( i );
+
+        if( m_lookupByTimestamp )
+        {
+            for( const KIID& uuid : comp->GetKIIDs() )
+            {
+                KIID_PATH path = comp->GetPath();
+                path.push_back( uuid );
+
+                componentIndex.emplace( path.AsString(), comp );
+            }
+        }
+        else
+        {
+            componentIndex.emplace( comp->GetReference(), comp );
+        }
+    }
+
     // Finally go through the board footprints and update all those that *don't* have matching
     // component entries.
     //
@@ -1209,10 +1571,9 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         if( ( footprint->GetAttributes() & FP_BOARD_ONLY ) > 0 )
             doDelete = false;
 
-        if( m_lookupByTimestamp )
-            component = aNetlist.GetComponentByPath( footprint->GetPath() );
-        else
-            component = aNetlist.GetComponentByReference( footprint->GetReference() );
+        auto it = componentIndex.find( m_lookupByTimestamp ? footprint->GetPath().AsString()
+                                                           : footprint->GetReference() );
+        component = it != componentIndex.end() ? it->second : nullptr;
 
         if( component && component->GetProperties().count( wxT( "exclude_from_board" ) ) == 0 )
             matched = true;
@@ -1262,6 +1623,10 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         }
     }
 
+    wxLogTrace( traceBoardNetlistUpdater, wxS( "Updated zone nets and unused footprints: %.1f ms" ),
+                timer.msecs() );
+    timer.Start();
+
     if( !m_isDryRun )
     {
         m_board->BuildConnectivity();
@@ -1289,7 +1654,11 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
         // Although m_commit will probably also set this, it's not guaranteed, and we need to make
         // sure any modification to netclasses gets persisted to project settings through a save.
-        m_frame->OnModify();
+        if( m_frame )
+            m_frame->OnModify();
+
+        wxLogTrace( traceBoardNetlistUpdater, wxS( "Checked connectivity and committed: %.1f ms" ),
+                    timer.msecs() );
     }
 
     if( m_isDryRun )
@@ -35,8 +35,13 @@ class NETLIST;
 class COMPONENT;
 class FOOTPRINT;
 class PCB_EDIT_FRAME;
+class TOOL_MANAGER;
 
 #include <board_commit.h>
+#include <lib_id.h>
+
+#include <memory>
+#include <set>
 
 /**
  * Update the #BOARD with a new netlist.
@@ -66,6 +71,15 @@ class BOARD_NETLIST_UPDATER
 {
 public:
     BOARD_NETLIST_UPDATER( PCB_EDIT_FRAME* aFrame, BOARD* aBoard );
+
+    /**
+     * Create an updater with no editor frame (e.g. for QA tests).
+     *
+     * Without a frame no footprints can be loaded from the libraries, so components that
+     * are missing from the board or need a different footprint are reported as errors unless
+     * their footprint is given through SetFootprintPrototype().
+     */
+    BOARD_NETLIST_UPDATER( TOOL_MANAGER* aToolManager, BOARD* aBoard );
     ~BOARD_NETLIST_UPDATER();
 
     /**
@@ -91,6 +105,12 @@ public:
 
     std::vector<FOOTPRINT*> GetAddedFootprints() const { return m_addedFootprints; }
 
+    /**
+     * Use \a aFootprint for every component assigned \a aFPID instead of loading it from the
+     * footprint libraries.  It is cleaned up the same way as a footprint loaded from a library.
+     */
+    void SetFootprintPrototype( const LIB_ID& aFPID, std::unique_ptr<FOOTPRINT> aFootprint );
+
 private:
     void cacheNetname( PAD* aPad, const wxString& aNetname );
     wxString getNetname( PAD* aPad );
@@ -100,14 +120,48 @@ private:
 
     VECTOR2I estimateFootprintInsertionPosition();
 
+    /**
+     * Load each footprint in \a aFPIDs once, ahead of the board update.  Each library is read
+     * by its own worker; addNewFootprint() and replaceFootprint() then clone the loaded
+     * footprints rather than going back to the library table for every component.
+     */
+    void loadFootprintPrototypes( const std::set<LIB_ID>& aFPIDs );
+
+    /**
+     * @return a new footprint for \a aFPID, copied (with new UUIDs) from its prototype if one
+     * was loaded, or else loaded from the library (and kept as its prototype).  nullptr if the
+     * footprint cannot be found.
+     */
+    FOOTPRINT* instantiateFootprint( const LIB_ID& aFPID );
+
     FOOTPRINT* addNewFootprint( COMPONENT* aComponent );
 
     FOOTPRINT* replaceFootprint( NETLIST& aNetlist, FOOTPRINT* aFootprint,
                                  COMPONENT* aNewComponent );
 
-    bool updateFootprintParameters( FOOTPRINT* aPcbFootprint, COMPONENT* aNetlistComponent );
+    /**
+     * Update the reference, value, fields, symbol association and attributes of
+     * \a aPcbFootprint from \a aNetlistComponent.
+     *
+     * @param aCheckOnly only find out whether there is anything to update or report.  Nothing
+     *                   is modified, reported or added to the commit, so this may be called
+     *                   from worker threads.
+     * @return true if the footprint was changed, or with \a aCheckOnly if anything would be
+     *         changed or reported.
+     */
+    bool updateFootprintParameters( FOOTPRINT* aPcbFootprint, COMPONENT* aNetlistComponent,
+                                    bool aCheckOnly = false );
 
-    bool updateComponentPadConnections( FOOTPRINT* aFootprint, COMPONENT* aNewComponent );
+    /**
+     * Update the nets, pin functions and pin types of the pads of \a aFootprint from
+     * \a aNewComponent.
+     *
+     * @param aCheckOnly see updateFootprintParameters().
+     * @return true if the footprint was changed, or with \a aCheckOnly if anything would be
+     *         changed or reported.
+     */
+    bool updateComponentPadConnections( FOOTPRINT* aFootprint, COMPONENT* aNewComponent,
+                                        bool aCheckOnly = false );
 
     void cacheCopperZoneConnections();
 
@@ -127,6 +181,9 @@ private:
     std::vector<FOOTPRINT*>            m_addedFootprints;
     std::map<wxString, NETINFO_ITEM*>  m_addedNets;
 
+    ///< Footprints loaded by loadFootprintPrototypes(); nullptr for those not found
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> m_footprintPrototypes;
+
     bool m_deleteUnusedFootprints;
     bool m_isDryRun;
     bool m_replaceFootprints;
@@ -422,7 +422,7 @@ int PAD::GetBoundingRadius() const
 
 void PAD::BuildEffectiveShapes( PCB_LAYER_ID aLayer ) const
 {
-    std::lock_guard<std::mutex> RAII_lock( m_shapesBuildingLock );
+    std::lock_guard<std::mutex> RAII_lock( itemMutex( this, ITEM_LOCK::SHAPES ) );
 
     // If we had to wait for the lock then we were probably waiting for someone else to
     // finish rebuilding the shapes.  So check to see if they're clean now.
@@ -597,7 +597,7 @@ void PAD::BuildEffectiveShapes( PCB_LAYER_ID aLayer ) const
 
 void PAD::BuildEffectivePolygon( ERROR_LOC aErrorLoc ) const
 {
-    std::lock_guard<std::mutex> RAII_lock( m_polyBuildingLock );
+    std::lock_guard<std::mutex> RAII_lock( itemMutex( this, ITEM_LOCK::POLYGONS ) );
 
     // If we had to wait for the lock then we were probably waiting for someone else to
     // finish rebuilding the shapes.  So check to see if they're clean now.
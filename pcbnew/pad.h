@@ -716,7 +716,8 @@ public:
 
     void SetZoneLayerOverride( PCB_LAYER_ID aLayer, ZONE_LAYER_OVERRIDE aOverride )
     {
-        std::unique_lock<std::mutex> cacheLock( m_zoneLayerOverridesMutex );
+        std::mutex&                  mutex = itemMutex( this, ITEM_LOCK::ZONE_LAYER_OVERRIDES );
+        std::unique_lock<std::mutex> cacheLock( mutex );
         m_zoneLayerOverrides.at( aLayer ) = aOverride;
     }
 
@@ -754,13 +755,11 @@ private:
 
     // Must be set to true to force rebuild shapes to draw (after geometry change for instance)
     mutable bool                              m_shapesDirty;
-    mutable std::mutex                        m_shapesBuildingLock;
     mutable BOX2I                             m_effectiveBoundingBox;
     mutable std::shared_ptr<SHAPE_COMPOUND>   m_effectiveShape;
     mutable std::shared_ptr<SHAPE_SEGMENT>    m_effectiveHoleShape;
 
     mutable bool                              m_polyDirty[2];
-    mutable std::mutex                        m_polyBuildingLock;
     mutable std::shared_ptr<SHAPE_POLY_SET>   m_effectivePolygon[2];
     mutable int                               m_effectiveBoundingRadius;
 
@@ -840,7 +839,6 @@ private:
                                                 //   while 90° will produce a +.
     int                 m_thermalGap;
 
-    std::mutex                                     m_zoneLayerOverridesMutex;
     std::array<ZONE_LAYER_OVERRIDE, MAX_CU_LAYERS> m_zoneLayerOverrides;
 };
 
@@ -53,6 +53,8 @@ PCB_BASE_EDIT_FRAME::PCB_BASE_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent,
                                           const wxString& aFrameName ) :
         PCB_BASE_FRAME( aKiway, aParent, aFrameType, aTitle, aPos, aSize, aStyle, aFrameName ),
         m_undoRedoBlocked( false ),
+        m_undoMemory( 0 ),
+        m_redoMemory( 0 ),
         m_selectionFilterPanel( nullptr ),
         m_appearancePanel( nullptr ),
         m_tabbedPanel( nullptr )
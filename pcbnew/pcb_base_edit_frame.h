@@ -191,8 +191,18 @@ public:
     /* full undo redo management : */
 
     // use EDA_BASE_FRAME::ClearUndoRedoList()
-    // use EDA_BASE_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
-    // use EDA_BASE_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aItem )
+
+    /**
+     * Add a command to the undo list, then drop the oldest commands if the list has grown
+     * past its count limit or past ADVANCED_CFG::m_UndoMemoryBudget.
+     */
+    void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem ) override;
+
+    ///< @copydoc PushCommandToUndoList()
+    void PushCommandToRedoList( PICKED_ITEMS_LIST* aItem ) override;
+
+    PICKED_ITEMS_LIST* PopCommandFromUndoList() override;
+    PICKED_ITEMS_LIST* PopCommandFromRedoList() override;
 
     /**
      * Free the undo or redo list from List element.
@@ -225,6 +235,18 @@ public:
                                 wxArrayString* aTokens );
 
 protected:
+    /**
+     * Remove the oldest commands from \a aList until the memory it holds (as far as it can be
+     * estimated) fits the undo memory budget.  The newest command is always kept.
+     */
+    void enforceUndoMemoryBudget( UNDO_REDO_LIST aList );
+
+    ///< The memory held by the undo or redo list, i.e. the sum of its commands' memory sizes
+    size_t& undoMemory( UNDO_REDO_LIST aList )
+    {
+        return aList == UNDO_LIST ? m_undoMemory : m_redoMemory;
+    }
+
     /**
      * Prompts a user to select global or project library tables
      *
@@ -250,6 +272,8 @@ protected:
 
 protected:
     bool                    m_undoRedoBlocked;
+    size_t                  m_undoMemory;
+    size_t                  m_redoMemory;
 
     PANEL_SELECTION_FILTER* m_selectionFilterPanel;
     APPEARANCE_CONTROLS*    m_appearancePanel;
@@ -498,8 +498,15 @@ PCB_EDIT_FRAME::~PCB_EDIT_FRAME()
 
     // Shutdown all running tools
     if( m_toolManager )
+    {
         m_toolManager->ShutdownAllTools();
 
+        // The router follows the board's commits; detach it while the board is still alive, as
+        // the tools outlive it
+        if( ROUTER_TOOL* router = m_toolManager->GetTool<ROUTER_TOOL>() )
+            router->Reset( TOOL_BASE::MODEL_RELOAD );
+    }
+
     if( GetBoard() )
         GetBoard()->RemoveAllListeners();
 
@@ -2102,15 +2102,19 @@ void PCB_PAINTER::draw( const PCB_TEXT* aText, int aLayer )
             attrs.m_Halign = static_cast<GR_TEXT_H_ALIGN_T>( -attrs.m_Halign );
         }
 
-        std::vector<std::unique_ptr<KIFONT::GLYPH>>* cache = nullptr;
+        const KIFONT::GLYPH_RUN* cache = nullptr;
+        VECTOR2I                 cachePos;
 
         if( font->IsOutline() )
-            cache = aText->GetRenderCache( font, resolvedText );
+            cache = aText->GetRenderCache( font, resolvedText, cachePos );
 
         if( cache )
         {
             m_gal->SetLineWidth( attrs.m_StrokeWidth );
+            m_gal->Save();
+            m_gal->Translate( cachePos );
             m_gal->DrawGlyphs( *cache );
+            m_gal->Restore();
         }
         else
         {
@@ -2234,15 +2238,19 @@ void PCB_PAINTER::draw( const PCB_TEXTBOX* aTextBox, int aLayer )
         #endif
     }
 
-    std::vector<std::unique_ptr<KIFONT::GLYPH>>* cache = nullptr;
+    const KIFONT::GLYPH_RUN* cache = nullptr;
+    VECTOR2I                 cachePos;
 
     if( font->IsOutline() )
-        cache = aTextBox->GetRenderCache( font, resolvedText );
+        cache = aTextBox->GetRenderCache( font, resolvedText, cachePos );
 
     if( cache )
     {
         m_gal->SetLineWidth( attrs.m_StrokeWidth );
+        m_gal->Save();
+        m_gal->Translate( cachePos );
         m_gal->DrawGlyphs( *cache );
+        m_gal->Restore();
     }
     else
     {
@@ -2466,7 +2474,7 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_FRACTURE_BORDERS
                 || displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION ) )
     {
-        const std::shared_ptr<SHAPE_POLY_SET>& polySet = aZone->GetFilledPolysList( layer );
+        std::shared_ptr<const SHAPE_POLY_SET> polySet = aZone->GetFilledPolysList( layer );
 
         if( polySet->OutlineCount() == 0 )  // Nothing to draw
             return;
@@ -2491,7 +2499,7 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
         // draw the polygon solid shape on Opengl.  GLU tessellation is much slower,
         // so currently we are using our tessellation.
         if( m_gal->IsOpenGlEngine() && !polySet->IsTriangulationUpToDate() )
-            polySet->CacheTriangulation( true, true );
+            aZone->CacheTriangulation( layer );
 
         m_gal->DrawPolygon( *polySet, displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION );
     }
@@ -2551,15 +2559,21 @@ void PCB_PAINTER::draw( const PCB_DIMENSION_BASE* aDimension, int aLayer )
     else
         attrs.m_StrokeWidth = getLineThickness( aDimension->GetEffectiveTextPenWidth() );
 
-    std::vector<std::unique_ptr<KIFONT::GLYPH>>* cache = nullptr;
+    const KIFONT::GLYPH_RUN* cache = nullptr;
+    VECTOR2I                 cachePos;
 
     if( aDimension->GetFont() && aDimension->GetFont()->IsOutline() )
-        cache = aDimension->GetRenderCache( aDimension->GetFont(), resolvedText );
+        cache = aDimension->GetRenderCache( aDimension->GetFont(), resolvedText, cachePos );
 
     if( cache )
     {
+        m_gal->Save();
+        m_gal->Translate( cachePos );
+
         for( const std::unique_ptr<KIFONT::GLYPH>& glyph : *cache )
             m_gal->DrawGlyph( *glyph.get() );
+
+        m_gal->Restore();
     }
     else
     {
@@ -23,6 +23,7 @@
 
 #include <board_design_settings.h>
 #include <charconv>
+#include <fmt/core.h>
 #include <layer_ids.h>
 #include <string_utils.h>
 #include <math/util.h> // for KiROUND
@@ -205,8 +206,10 @@ void PCB_PLOT_PARAMS::Format( OUTPUTFORMATTER* aFormatter,
     if( m_gerberPrecision != gbrDefaultPrecision )
         aFormatter->Print( aNestLevel+1, "(gerberprecision %d)\n", m_gerberPrecision );
 
-    aFormatter->Print( aNestLevel+1, "(dashed_line_dash_ratio %f)\n", GetDashedLineDashRatio() );
-    aFormatter->Print( aNestLevel+1, "(dashed_line_gap_ratio %f)\n", GetDashedLineGapRatio() );
+    aFormatter->Print( aNestLevel+1, "(dashed_line_dash_ratio %s)\n",
+                       fmt::format( "{:f}", GetDashedLineDashRatio() ).c_str() );
+    aFormatter->Print( aNestLevel+1, "(dashed_line_gap_ratio %s)\n",
+                       fmt::format( "{:f}", GetDashedLineGapRatio() ).c_str() );
 
     // SVG options
     aFormatter->Print( aNestLevel+1, "(svgprecision %d)\n", m_svgPrecision );
@@ -219,7 +222,8 @@ void PCB_PLOT_PARAMS::Format( OUTPUTFORMATTER* aFormatter,
     // HPGL options
     aFormatter->Print( aNestLevel+1, "(hpglpennumber %d)\n", m_HPGLPenNum );
     aFormatter->Print( aNestLevel+1, "(hpglpenspeed %d)\n", m_HPGLPenSpeed );
-    aFormatter->Print( aNestLevel+1, "(hpglpendiameter %f)\n", m_HPGLPenDiam );
+    aFormatter->Print( aNestLevel+1, "(hpglpendiameter %s)\n",
+                       fmt::format( "{:f}", m_HPGLPenDiam ).c_str() );
 
     // PDF options
     aFormatter->Print( aNestLevel+1, "(%s %s)\n", getTokenName( T_pdf_front_fp_property_popups ),
@@ -585,7 +585,8 @@ public:
 
     void SetZoneLayerOverride( PCB_LAYER_ID aLayer, ZONE_LAYER_OVERRIDE aOverride )
     {
-        std::unique_lock<std::mutex> cacheLock( m_zoneLayerOverridesMutex );
+        std::mutex&                  mutex = itemMutex( this, ITEM_LOCK::ZONE_LAYER_OVERRIDES );
+        std::unique_lock<std::mutex> cacheLock( mutex );
         m_zoneLayerOverrides.at( aLayer ) = aOverride;
     }
 
@@ -610,7 +611,6 @@ private:
     bool         m_keepStartEndLayer;        ///< Keep the start and end annular rings
     bool         m_isFree;                   ///< "Free" vias don't get their nets auto-updated
 
-    std::mutex                                     m_zoneLayerOverridesMutex;
     std::array<ZONE_LAYER_OVERRIDE, MAX_CU_LAYERS> m_zoneLayerOverrides;
 };
 
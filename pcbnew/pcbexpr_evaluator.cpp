@@ -57,29 +57,24 @@ public:
         // in the ENUM_MAP: one for the canonical layer name and one for the user layer name.
         // We need to check against both.
 
-        wxPGChoices&                 layerMap = ENUM_MAP<PCB_LAYER_ID>::Instance().Choices();
-        const wxString&              layerName = b->AsString();
-        BOARD*                       board = static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard();
-        std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-        auto                         i = board->m_LayerExpressionCache.find( layerName );
-        LSET                         mask;
-
-        if( i == board->m_LayerExpressionCache.end() )
-        {
-            for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
-            {
-                wxPGChoiceEntry& entry = layerMap[ii];
+        wxPGChoices&    layerMap = ENUM_MAP<PCB_LAYER_ID>::Instance().Choices();
+        const wxString& layerName = b->AsString();
+        BOARD*          board = static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard();
+        LSET            mask = board->m_LayerExpressionCache.GetOrCompute( layerName,
+                [&]()
+                {
+                    LSET layers;
 
-                if( entry.GetText().Matches( layerName ) )
-                    mask.set( ToLAYER_ID( entry.GetValue() ) );
-            }
+                    for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
+                    {
+                        wxPGChoiceEntry& entry = layerMap[ii];
 
-            board->m_LayerExpressionCache[ layerName ] = mask;
-        }
-        else
-        {
-            mask = i->second;
-        }
+                        if( entry.GetText().Matches( layerName ) )
+                            layers.set( ToLAYER_ID( entry.GetValue() ) );
+                    }
+
+                    return layers;
+                } );
 
         return mask.Contains( m_layer );
     }
@@ -164,12 +159,12 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     PCBEXPR_CONTEXT* context = static_cast<PCBEXPR_CONTEXT*>( aCtx );
 
     if( m_itemIndex == 2 )
-        return new PCBEXPR_LAYER_VALUE( context->GetLayer() );
+        return aCtx->StoreValue( new PCBEXPR_LAYER_VALUE( context->GetLayer() ) );
 
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
     auto it = m_matchingTypes.find( TYPE_HASH( *item ) );
 
@@ -179,20 +174,25 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
         // simpler "A.Via_Type == 'buried'" is perfectly clear.  Instead, return an undefined
         // value when the property doesn't appear on a particular object.
 
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
     }
     else
     {
         if( m_type == LIBEVAL::VT_NUMERIC )
-            return new LIBEVAL::VALUE( (double) item->Get<int>( it->second ) );
+        {
+            LIBEVAL::VALUE* value = aCtx->AllocValue();
+            value->Set( (double) item->Get<int>( it->second ) );
+            return value;
+        }
         else
         {
             wxString str;
 
             if( !m_isEnum )
             {
-                str = item->Get<wxString>( it->second );
-                return new LIBEVAL::VALUE( str );
+                LIBEVAL::VALUE* value = aCtx->AllocValue();
+                value->Set( item->Get<wxString>( it->second ) );
+                return value;
             }
             else
             {
@@ -204,18 +204,23 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
                         || it->second->Name() == wxT( "Layer Bottom" ) )
                 {
                     if( any.GetAs<PCB_LAYER_ID>( &layer ) )
-                        return new PCBEXPR_LAYER_VALUE( layer );
+                        return aCtx->StoreValue( new PCBEXPR_LAYER_VALUE( layer ) );
                     else if( any.GetAs<wxString>( &str ) )
-                        return new PCBEXPR_LAYER_VALUE( context->GetBoard()->GetLayerID( str ) );
+                        return aCtx->StoreValue( new PCBEXPR_LAYER_VALUE(
+                                context->GetBoard()->GetLayerID( str ) ) );
                 }
                 else
                 {
                     if( any.GetAs<wxString>( &str ) )
-                        return new LIBEVAL::VALUE( str );
+                    {
+                        LIBEVAL::VALUE* value = aCtx->AllocValue();
+                        value->Set( str );
+                        return value;
+                    }
                 }
             }
 
-            return new LIBEVAL::VALUE();
+            return aCtx->AllocValue();
         }
     }
 }
@@ -226,9 +231,9 @@ LIBEVAL::VALUE* PCBEXPR_NETCLASS_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NETCLASS_VALUE( item );
+    return aCtx->StoreValue( new PCBEXPR_NETCLASS_VALUE( item ) );
 }
 
 
@@ -237,9 +242,9 @@ LIBEVAL::VALUE* PCBEXPR_NETNAME_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NET_VALUE( item );
+    return aCtx->StoreValue( new PCBEXPR_NET_VALUE( item ) );
 }
 
 
@@ -248,9 +253,11 @@ LIBEVAL::VALUE* PCBEXPR_TYPE_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new LIBEVAL::VALUE( ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
+    LIBEVAL::VALUE* value = aCtx->AllocValue();
+    value->Set( ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
+    return value;
 }
 
 
@@ -135,26 +135,21 @@ static void existsOnLayerFunc( LIBEVAL::CONTEXT* aCtx, void *self )
                      */
 
                     BOARD* board = item->GetBoard();
-                    std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                    auto i = board->m_LayerExpressionCache.find( layerName );
-                    LSET mask;
+                    LSET   mask = board->m_LayerExpressionCache.GetOrCompute( layerName,
+                            [&]()
+                            {
+                                LSET layers;
 
-                    if( i == board->m_LayerExpressionCache.end() )
-                    {
-                        for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
-                        {
-                            wxPGChoiceEntry& entry = layerMap[ ii ];
+                                for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
+                                {
+                                    wxPGChoiceEntry& entry = layerMap[ ii ];
 
-                            if( entry.GetText().Matches( layerName ) )
-                                mask.set( ToLAYER_ID( entry.GetValue() ) );
-                        }
+                                    if( entry.GetText().Matches( layerName ) )
+                                        layers.set( ToLAYER_ID( entry.GetValue() ) );
+                                }
 
-                        board->m_LayerExpressionCache[ layerName ] = mask;
-                    }
-                    else
-                    {
-                        mask = i->second;
-                    }
+                                return layers;
+                            } );
 
                     if( ( item->GetLayerSet() & mask ).any() )
                         return 1.0;
@@ -271,22 +266,20 @@ static void intersectsCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
+                            PTR_PTR_CACHE_KEY key = { fp, item };
+                            bool              res;
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                auto i = board->m_IntersectsCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsCourtyardCache.end() )
-                                    return i->second;
+                                if( board->m_IntersectsCourtyardCache.Get( key, res ) )
+                                    return res;
                             }
 
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu )
+                            res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu )
                                     || collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsCourtyardCache[ key ] = res;
+                                board->m_IntersectsCourtyardCache.Set( key, res );
 
                             return res;
                         } ) )
@@ -331,21 +324,19 @@ static void intersectsFrontCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
+                            PTR_PTR_CACHE_KEY key = { fp, item };
+                            bool              res;
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                auto i = board->m_IntersectsFCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsFCourtyardCache.end() )
-                                    return i->second;
+                                if( board->m_IntersectsFCourtyardCache.Get( key, res ) )
+                                    return res;
                             }
 
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu );
+                            res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsFCourtyardCache[ key ] = res;
+                                board->m_IntersectsFCourtyardCache.Set( key, res );
 
                             return res;
                         } ) )
@@ -390,21 +381,19 @@ static void intersectsBackCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
+                            PTR_PTR_CACHE_KEY key = { fp, item };
+                            bool              res;
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                auto i = board->m_IntersectsBCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsBCourtyardCache.end() )
-                                    return i->second;
+                                if( board->m_IntersectsBCourtyardCache.Get( key, res ) )
+                                    return res;
                             }
 
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
+                            res = collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsBCourtyardCache[ key ] = res;
+                                board->m_IntersectsBCourtyardCache.Set( key, res );
 
                             return res;
                         } ) )
@@ -426,10 +415,24 @@ bool collidesWithArea( BOARD_ITEM* aItem, PCBEXPR_CONTEXT* aCtx, ZONE* aArea )
     // Collisions include touching, so we need to deflate outline by enough to exclude it.
     // This is particularly important for detecting copper fills as they will be exactly
     // touching along the entire exclusion border.
-    SHAPE_POLY_SET areaOutline = aArea->Outline()->CloneDropTriangulation();
-    areaOutline.ClearArcs();
-    areaOutline.Deflate( board->GetDesignSettings().GetDRCEpsilon(),
-                         CORNER_STRATEGY::ALLOW_ACUTE_CORNERS, ARC_LOW_DEF );
+    //
+    // The deflated outline is shared between threads, so it is triangulated up front rather
+    // than lazily inside Collide().
+    std::shared_ptr<SHAPE_POLY_SET> deflatedOutline =
+            board->m_DeflatedAreaOutlineCache.GetOrCompute( aArea,
+                    [&]()
+                    {
+                        auto outline = std::make_shared<SHAPE_POLY_SET>(
+                                aArea->Outline()->CloneDropTriangulation() );
+
+                        outline->ClearArcs();
+                        outline->Deflate( board->GetDesignSettings().GetDRCEpsilon(),
+                                          CORNER_STRATEGY::ALLOW_ACUTE_CORNERS, ARC_LOW_DEF );
+                        outline->CacheTriangulation( false );
+                        return outline;
+                    } );
+
+    SHAPE_POLY_SET& areaOutline = *deflatedOutline;
 
     if( aItem->GetFlags() & HOLE_PROXY )
     {
@@ -504,10 +507,14 @@ bool collidesWithArea( BOARD_ITEM* aItem, PCBEXPR_CONTEXT* aCtx, ZONE* aArea )
         if( !zone->IsFilled() )
             return false;
 
-        DRC_RTREE* zoneRTree = board->m_CopperZoneRTreeCache[ zone ].get();
+        // The rtree cache is filled before DRC starts, so it can be read without locking
+        // (but must not be inserted into)
+        auto rtreeIt = board->m_CopperZoneRTreeCache.find( zone );
 
-        if( zoneRTree )
+        if( rtreeIt != board->m_CopperZoneRTreeCache.end() && rtreeIt->second )
         {
+            DRC_RTREE* zoneRTree = rtreeIt->second.get();
+
             for( PCB_LAYER_ID layer : aArea->GetLayerSet().Seq() )
             {
                 if( aCtx->GetLayer() == layer || aCtx->GetLayer() == UNDEFINED_LAYER )
@@ -573,27 +580,36 @@ bool searchAreas( BOARD* aBoard, const wxString& aArg, PCBEXPR_CONTEXT* aCtx,
     }
     else  // Match on zone name
     {
-        for( ZONE* area : aBoard->Zones() )
-        {
-            if( area->GetZoneName().Matches( aArg ) )
-            {
-                // Many zones can match the name; exit only when we find an "inside"
-                if( aFunc( area ) )
-                    return true;
-            }
-        }
+        // Wildcard-matching every zone name on every evaluation adds up on boards with many
+        // rule areas, so the matches for each pattern are cached.
+        std::shared_ptr<std::vector<ZONE*>> areas = aBoard->m_RuleAreaNameCache.GetOrCompute( aArg,
+                [&]()
+                {
+                    auto matches = std::make_shared<std::vector<ZONE*>>();
 
-        for( FOOTPRINT* footprint : aBoard->Footprints() )
+                    for( ZONE* area : aBoard->Zones() )
+                    {
+                        if( area->GetZoneName().Matches( aArg ) )
+                            matches->push_back( area );
+                    }
+
+                    for( FOOTPRINT* footprint : aBoard->Footprints() )
+                    {
+                        for( ZONE* area : footprint->Zones() )
+                        {
+                            if( area->GetZoneName().Matches( aArg ) )
+                                matches->push_back( area );
+                        }
+                    }
+
+                    return matches;
+                } );
+
+        for( ZONE* area : *areas )
         {
-            for( ZONE* area : footprint->Zones() )
-            {
-                // Many zones can match the name; exit only when we find an "inside"
-                if( area->GetZoneName().Matches( aArg ) )
-                {
-                    if( aFunc( area ) )
-                        return true;
-                }
-            }
+            // Many zones can match the name; exit only when we find an "inside"
+            if( aFunc( area ) )
+                return true;
         }
 
         return false;
@@ -648,9 +664,8 @@ static void intersectsAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             if( !aArea->GetBoundingBox().Intersects( itemBBox ) )
                                 return false;
 
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                            LSET                         testLayers;
-                            PTR_PTR_LAYER_CACHE_KEY      key;
+                            LSET                    testLayers;
+                            PTR_PTR_LAYER_CACHE_KEY key;
 
                             if( aLayer != UNDEFINED_LAYER )
                                 testLayers.set( aLayer );
@@ -661,18 +676,18 @@ static void intersectsAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             {
                                 if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                                 {
-                                    key = { aArea, item, layer };
+                                    bool cached = false;
 
-                                    auto i = board->m_IntersectsAreaCache.find( key );
+                                    key = { aArea, item, layer };
 
-                                    if( i != board->m_IntersectsAreaCache.end() && i->second )
+                                    if( board->m_IntersectsAreaCache.Get( key, cached ) && cached )
                                         return true;
                                 }
 
                                 bool collides = collidesWithArea( item, context, aArea );
 
                                 if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                    board->m_IntersectsAreaCache[ key ] = collides;
+                                    board->m_IntersectsAreaCache.Set( key, collides );
 
                                 if( collides )
                                     return true;
@@ -732,19 +747,16 @@ static void enclosedByAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             if( !aArea->GetBoundingBox().Intersects( itemBBox ) )
                                 return false;
 
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                            PTR_PTR_LAYER_CACHE_KEY      key = { aArea, item, layer };
+                            PTR_PTR_LAYER_CACHE_KEY key = { aArea, item, layer };
+                            bool                    enclosedByArea;
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                auto i = board->m_EnclosedByAreaCache.find( key );
-
-                                if( i != board->m_EnclosedByAreaCache.end() )
-                                    return i->second;
+                                if( board->m_EnclosedByAreaCache.Get( key, enclosedByArea ) )
+                                    return enclosedByArea;
                             }
 
                             SHAPE_POLY_SET itemShape;
-                            bool           enclosedByArea;
 
                             item->TransformShapeToPolygon( itemShape, layer, 0, maxError,
                                                            ERROR_OUTSIDE );
@@ -763,7 +775,7 @@ static void enclosedByAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             }
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_EnclosedByAreaCache[ key ] = enclosedByArea;
+                                board->m_EnclosedByAreaCache.Set( key, enclosedByArea );
 
                             return enclosedByArea;
                         } ) )
@@ -37,6 +37,7 @@
 #include <jobs/job_export_pcb_svg.h>
 #include <jobs/job_export_pcb_3d.h>
 #include <jobs/job_pcb_drc.h>
+#include <jobs/job_pcb_render.h>
 #include <cli/exit_codes.h>
 #include <exporters/place_file_exporter.h>
 #include <exporters/step/exporter_step.h>
@@ -62,6 +63,12 @@
 #include <reporter.h>
 #include <wildcards_and_files_ext.h>
 #include <export_vrml.h>
+#include <project_pcb.h>
+#include <settings/settings_manager.h>
+#include <3d_rendering/raytracing/render_3d_raytrace.h>
+#include <3d_rendering/track_ball.h>
+#include <3d_viewer/eda_3d_viewer_settings.h>
+#include <wx/image.h>
 
 #include "pcbnew_scripting_helpers.h"
 
@@ -84,6 +91,7 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER()
     Register( "fpsvg",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportFpSvg, this, std::placeholders::_1 ) );
     Register( "drc", std::bind( &PCBNEW_JOBS_HANDLER::JobExportDrc, this, std::placeholders::_1 ) );
+    Register( "render", std::bind( &PCBNEW_JOBS_HANDLER::JobRender, this, std::placeholders::_1 ) );
 }
 
 
@@ -145,6 +153,7 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
         EXPORTER_STEP_PARAMS params;
         params.m_exportTracks = aStepJob->m_exportTracks;
         params.m_exportZones = aStepJob->m_exportZones;
+        params.m_fastBoardHoles = aStepJob->m_fastBoardHoles;
         params.m_includeUnspecified = aStepJob->m_includeUnspecified;
         params.m_includeDNP = aStepJob->m_includeDNP;
         params.m_BoardOutlinesChainingEpsilon = aStepJob->m_BoardOutlinesChainingEpsilon;
@@ -742,21 +751,32 @@ int PCBNEW_JOBS_HANDLER::JobExportFpUpgrade( JOB* aJob )
     {
         fpLib.Load();
     }
-    catch(...)
+    catch( const IO_ERROR& ioe )
     {
-        m_reporter->Report( _( "Unable to load library\n" ), RPT_SEVERITY_ERROR );
+        m_reporter->Report( _( "Unable to load library\n" ) + ioe.What() + wxS( "\n" ),
+                            RPT_SEVERITY_ERROR );
         return CLI::EXIT_CODES::ERR_UNKNOWN;
     }
 
     bool shouldSave = upgradeJob->m_force;
 
-    for( const auto& footprint : fpLib.GetFootprints() )
+    try
     {
-        if( footprint.second->GetFootprint()->GetFileFormatVersionAtLoad() < SEXPR_BOARD_FILE_VERSION )
+        // Footprints are parsed on first access, so read errors surface here.
+        for( const auto& footprint : fpLib.GetFootprints() )
         {
-            shouldSave = true;
+            if( footprint.second->GetFootprint()->GetFileFormatVersionAtLoad() < SEXPR_BOARD_FILE_VERSION )
+            {
+                shouldSave = true;
+            }
         }
     }
+    catch( const IO_ERROR& ioe )
+    {
+        m_reporter->Report( _( "Unable to load library\n" ) + ioe.What() + wxS( "\n" ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    }
 
     if( shouldSave )
     {
@@ -803,9 +823,10 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
     {
         fpLib.Load();
     }
-    catch( ... )
+    catch( const IO_ERROR& ioe )
     {
-        m_reporter->Report( _( "Unable to load library\n" ), RPT_SEVERITY_ERROR );
+        m_reporter->Report( _( "Unable to load library\n" ) + ioe.What() + wxS( "\n" ),
+                            RPT_SEVERITY_ERROR );
         return CLI::EXIT_CODES::ERR_UNKNOWN;
     }
 
@@ -823,10 +844,10 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
     for( FP_CACHE_FOOTPRINT_MAP::iterator it = footprintMap.begin(); it != footprintMap.end();
          ++it )
     {
-        const FOOTPRINT* fp = it->second->GetFootprint();
         if( !svgJob->m_footprint.IsEmpty() )
         {
-            if( fp->GetFPID().GetLibItemName().wx_str() != svgJob->m_footprint )
+            // Compare against the map key so that skipped footprints never get parsed
+            if( it->first != svgJob->m_footprint )
             {
                 // skip until we find the right footprint
                 continue;
@@ -837,6 +858,18 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
             }
         }
 
+        const FOOTPRINT* fp = nullptr;
+
+        try
+        {
+            fp = it->second->GetFootprint();
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            m_reporter->Report( ioe.What() + wxS( "\n" ), RPT_SEVERITY_ERROR );
+            continue;
+        }
+
         exitCode = doFpExportSvg( svgJob, fp );
         if( exitCode != CLI::EXIT_CODES::OK )
             break;
@@ -1026,6 +1059,153 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 }
 
 
+int PCBNEW_JOBS_HANDLER::JobRender( JOB* aJob )
+{
+    JOB_PCB_RENDER* renderJob = dynamic_cast<JOB_PCB_RENDER*>( aJob );
+
+    if( renderJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
+
+    BOARD* brd = LoadBoard( renderJob->m_filename );
+    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
+
+    if( renderJob->m_outputFile.IsEmpty() )
+    {
+        wxFileName fn = brd->GetFileName();
+        fn.SetName( fn.GetName() );
+
+        if( renderJob->m_format == JOB_PCB_RENDER::FORMAT::JPEG )
+            fn.SetExt( JpegFileExtension );
+        else
+            fn.SetExt( PngFileExtension );
+
+        renderJob->m_outputFile = fn.GetFullName();
+    }
+
+    EDA_3D_VIEWER_SETTINGS* cfg =
+            Pgm().GetSettingsManager().GetAppSettings<EDA_3D_VIEWER_SETTINGS>();
+
+    // The render options are tweaked in place; put the 3D viewer's own back when done
+    EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS savedRender = cfg->m_Render;
+
+    cfg->m_Render.engine = RENDER_ENGINE::RAYTRACING;
+
+    if( renderJob->m_quality == JOB_PCB_RENDER::QUALITY::BASIC )
+    {
+        cfg->m_Render.raytrace_anti_aliasing = false;
+        cfg->m_Render.raytrace_post_processing = false;
+        cfg->m_Render.raytrace_procedural_textures = false;
+        cfg->m_Render.raytrace_reflections = false;
+        cfg->m_Render.raytrace_refractions = false;
+        cfg->m_Render.raytrace_shadows = true;
+        cfg->m_Render.raytrace_backfloor = false;
+    }
+    else if( renderJob->m_quality == JOB_PCB_RENDER::QUALITY::HIGH )
+    {
+        cfg->m_Render.raytrace_anti_aliasing = true;
+        cfg->m_Render.raytrace_post_processing = true;
+        cfg->m_Render.raytrace_procedural_textures = true;
+        cfg->m_Render.raytrace_reflections = true;
+        cfg->m_Render.raytrace_refractions = true;
+        cfg->m_Render.raytrace_shadows = true;
+        cfg->m_Render.raytrace_backfloor = false;
+    }
+
+    if( renderJob->m_floor )
+        cfg->m_Render.raytrace_backfloor = true;
+
+    BOARD_ADAPTER boardAdapter;
+
+    boardAdapter.SetBoard( brd );
+    boardAdapter.m_Cfg = cfg;
+    boardAdapter.Set3dCacheManager( PROJECT_PCB::Get3DCacheManager( brd->GetProject() ) );
+
+    TRACK_BALL camera( 2 * RANGE_SCALE_3D );
+
+    camera.SetProjection( renderJob->m_perspective ? PROJECTION_TYPE::PERSPECTIVE
+                                                   : PROJECTION_TYPE::ORTHO );
+    camera.SetCurWindowSize( wxSize( renderJob->m_width, renderJob->m_height ) );
+
+    // Without a canvas the raytracer never touches OpenGL; it renders into a plain buffer
+    RENDER_3D_RAYTRACE raytrace( nullptr, boardAdapter, camera );
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Building 3D scene\n" ), RPT_SEVERITY_INFO );
+
+    raytrace.Reload( nullptr, nullptr, false );
+
+    // Same camera placements as EDA_3D_CANVAS::SetView3D()
+    camera.Reset();
+
+    switch( renderJob->m_side )
+    {
+    case JOB_PCB_RENDER::SIDE::TOP:
+        break;
+
+    case JOB_PCB_RENDER::SIDE::BOTTOM:
+        camera.RotateY( glm::radians( 180.0f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::LEFT:
+        camera.RotateZ( glm::radians( 90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::RIGHT:
+        camera.RotateZ( glm::radians( -90.0f ) );
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::FRONT:
+        camera.RotateX( glm::radians( -90.0f ) );
+        break;
+
+    case JOB_PCB_RENDER::SIDE::BACK:
+        camera.RotateX( glm::radians( -90.0f ) );
+        camera.RotateZ( glm::radians( 180.0f ) );
+        break;
+    }
+
+    camera.Zoom( static_cast<float>( renderJob->m_zoom ) );
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Rendering\n" ), RPT_SEVERITY_INFO );
+
+    wxImage image;
+    bool    rendered = raytrace.RenderToImage( wxSize( renderJob->m_width, renderJob->m_height ),
+                                               image, nullptr );
+
+    cfg->m_Render = savedRender;
+
+    if( !rendered )
+    {
+        m_reporter->Report( _( "Failed to render the board, the image may be too small\n" ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    }
+
+    wxBitmapType type = renderJob->m_format == JOB_PCB_RENDER::FORMAT::JPEG ? wxBITMAP_TYPE_JPEG
+                                                                            : wxBITMAP_TYPE_PNG;
+
+    if( !image.SaveFile( renderJob->m_outputFile, type ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to save image file '%s'\n" ),
+                                              renderJob->m_outputFile ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    m_reporter->Report( wxString::Format( _( "Successfully rendered board to %s\n" ),
+                                          renderJob->m_outputFile ),
+                        RPT_SEVERITY_INFO );
+
+    return CLI::EXIT_CODES::OK;
+}
+
+
 DS_PROXY_VIEW_ITEM* PCBNEW_JOBS_HANDLER::getDrawingSheetProxyView( BOARD* aBrd )
 {
     DS_PROXY_VIEW_ITEM* drawingSheet = new DS_PROXY_VIEW_ITEM( pcbIUScale,
@@ -2150,7 +2150,7 @@ void CADSTAR_PCB_ARCHIVE_LOADER::loadCoppers()
 
             if( pouredZone->HasFilledPolysForLayer( getKiCadLayer( csCopper.LayerID ) ) )
             {
-                fill.BooleanAdd( *pouredZone->GetFill( getKiCadLayer( csCopper.LayerID ) ),
+                fill.BooleanAdd( *pouredZone->GetFilledPolysList( getKiCadLayer( csCopper.LayerID ) ),
                                  SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
             }
 
@@ -55,7 +55,6 @@
 #include <plugins/kicad/pcb_plugin.h>
 #include <pcb_plot_params_parser.h>
 #include <pcb_plot_params.h>
-#include <locale_io.h>
 #include <zones.h>
 #include <plugins/kicad/pcb_parser.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
@@ -746,8 +745,6 @@ FP_3DMODEL* PCB_PARSER::parse3DModel()
 
 bool PCB_PARSER::IsValidBoardHeader()
 {
-    LOCALE_IO       toggle;
-
     m_groupInfos.clear();
 
     // See Parse() - FOOTPRINTS can be prefixed with an initial block of single line comments,
@@ -768,7 +765,6 @@ BOARD_ITEM* PCB_PARSER::Parse()
 {
     T               token;
     BOARD_ITEM*     item;
-    LOCALE_IO       toggle;
 
     m_groupInfos.clear();
 
@@ -5925,7 +5921,7 @@ ZONE* PCB_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
             SHAPE_POLY_SET layerFill;
 
             if( zone->HasFilledPolysForLayer( layer ) )
-                layerFill = SHAPE_POLY_SET( *zone->GetFill( layer ) );
+                layerFill = SHAPE_POLY_SET( *zone->GetFilledPolysList( layer ) );
 
             for( const auto& seg : segments )
             {
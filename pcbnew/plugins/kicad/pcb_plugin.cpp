@@ -29,7 +29,6 @@
 #include <convert_basic_shapes_to_polygon.h> // for enum RECT_CHAMFER_POSITIONS definition
 #include <string_utils.h>
 #include <kiface_base.h>
-#include <locale_io.h>
 #include <macros.h>
 #include <fmt/core.h>
 #include <callback_gal.h>
@@ -46,6 +45,7 @@
 #include <pcb_track.h>
 #include <zone.h>
 #include <pcbnew_settings.h>
+#include <core/thread_pool.h>
 #include <pgm_base.h>
 #include <plugins/kicad/pcb_plugin.h>
 #include <plugins/kicad/pcb_parser.h>
@@ -63,16 +63,170 @@
 #include <wx/mstream.h>
 #include <filter_reader.h>
 
+#include <mutex>
+#include <unordered_map>
+
 
 using namespace PCB_KEYS_T;
 
 
+/**
+ * Process-wide registry of parsed library footprints.
+ *
+ * Every #PCB_PLUGIN instance (and so every #FP_LIB_TABLE row, KIWAY player and job handler in
+ * the process) has its own #FP_CACHE, but they all look here before parsing a footprint file.
+ * Entries are keyed by file path and are only handed out while the file timestamp matches the
+ * one the footprint was read at, so an edited file is simply re-read.  Only weak references are
+ * held: a footprint lives as long as at least one cache uses it.
+ *
+ * The footprints are shared between caches and threads, so they are const; whatever needs to
+ * change one works on a copy (see PCB_PLUGIN::FootprintLoad()).
+ */
+class FP_SHARED_CACHE
+{
+public:
+    static FP_SHARED_CACHE& Instance()
+    {
+        static FP_SHARED_CACHE s_instance;
+        return s_instance;
+    }
+
+    std::shared_ptr<const FOOTPRINT> Find( const wxString& aPath, long long aTimestamp )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_entries.find( aPath );
+
+        if( it == m_entries.end() || it->second.m_timestamp != aTimestamp )
+            return nullptr;
+
+        return it->second.m_footprint.lock();
+    }
+
+    void Store( const wxString& aPath, long long aTimestamp,
+                const std::shared_ptr<const FOOTPRINT>& aFootprint )
+    {
+        // A zero timestamp means the file doesn't exist; there's nothing to validate against.
+        if( aTimestamp == 0 )
+            return;
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        m_entries[ aPath ] = { aTimestamp, aFootprint };
+
+        // Sweep out footprints nobody holds any more once the map has grown enough to make
+        // it worthwhile.
+        if( m_entries.size() > m_sweepThreshold )
+        {
+            for( auto it = m_entries.begin(); it != m_entries.end(); )
+            {
+                if( it->second.m_footprint.expired() )
+                    it = m_entries.erase( it );
+                else
+                    ++it;
+            }
+
+            m_sweepThreshold = std::max<size_t>( 1024, 2 * m_entries.size() );
+        }
+    }
+
+private:
+    FP_SHARED_CACHE() :
+            m_sweepThreshold( 1024 )
+    { }
+
+    struct ENTRY
+    {
+        long long                m_timestamp;
+        std::weak_ptr<const FOOTPRINT> m_footprint;
+    };
+
+    std::mutex                          m_mutex;
+    std::unordered_map<wxString, ENTRY> m_entries;
+    size_t                              m_sweepThreshold;
+};
+
+
 FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
         m_filename( aFileName ),
-        m_footprint( aFootprint )
+        m_footprint( aFootprint ),
+        m_fileTimestamp( 0 )
 { }
 
 
+FP_CACHE_ITEM::FP_CACHE_ITEM( const WX_FILENAME& aFileName ) :
+        m_filename( aFileName ),
+        m_fileTimestamp( 0 )
+{ }
+
+
+void FP_CACHE_ITEM::ShareFootprint( const wxString& aFullPath )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( m_footprint )
+        FP_SHARED_CACHE::Instance().Store( aFullPath, m_fileTimestamp, m_footprint );
+}
+
+
+const FOOTPRINT* FP_CACHE_ITEM::GetFootprint() const
+{
+    // Library caches are read from worker threads (e.g. the footprint list loader), so only
+    // one of them gets to parse the file
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( m_footprint )
+        return m_footprint.get();
+
+    // Don't keep re-reading a file we already know to be broken.
+    if( !m_parseError.IsEmpty() )
+        THROW_IO_ERROR( m_parseError );
+
+    // Fetch the timestamp before reading so that a write racing with the parse marks the
+    // item as stale rather than current.
+    wxString  fullPath = m_filename.GetFullPath();
+    long long timestamp = m_filename.GetTimestamp();
+
+    std::shared_ptr<const FOOTPRINT> shared = FP_SHARED_CACHE::Instance().Find( fullPath, timestamp );
+
+    if( shared )
+    {
+        m_footprint = std::move( shared );
+        m_fileTimestamp = timestamp;
+        return m_footprint.get();
+    }
+
+    try
+    {
+        FILE_LINE_READER reader( fullPath );
+        PCB_PARSER       parser( &reader, nullptr, nullptr );
+
+        std::unique_ptr<BOARD_ITEM> item( parser.Parse() );
+        FOOTPRINT*                  footprint = dynamic_cast<FOOTPRINT*>( item.get() );
+
+        if( !footprint )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ), fullPath ) );
+        }
+
+        item.release();
+        footprint->SetFPID( LIB_ID( wxEmptyString, m_filename.GetName() ) );
+
+        m_footprint.reset( footprint );
+        m_fileTimestamp = timestamp;
+
+        FP_SHARED_CACHE::Instance().Store( fullPath, timestamp, m_footprint );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        m_parseError = ioe.What();
+        throw;
+    }
+
+    return m_footprint.get();
+}
+
+
 FP_CACHE::FP_CACHE( PCB_PLUGIN* aOwner, const wxString& aLibraryPath )
 {
     m_owner = aOwner;
@@ -101,7 +255,9 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
 
     for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        if( aFootprint && aFootprint != it->second->GetFootprint() )
+        // An item which hasn't been parsed yet can't be the footprint we were asked to save,
+        // so don't force it to be read just to compare against it.
+        if( aFootprint && ( !it->second->IsLoaded() || aFootprint != it->second->GetFootprint() ) )
             continue;
 
         WX_FILENAME fn = it->second->GetFileName();
@@ -121,7 +277,7 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
             FILE_OUTPUTFORMATTER formatter( tempFileName );
 
             m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( (BOARD_ITEM*) it->second->GetFootprint() );
+            m_owner->Format( it->second->GetFootprint() );
         }
 
 #ifdef USE_TMP_FILE
@@ -142,7 +298,14 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
             THROW_IO_ERROR( msg );
         }
 #endif
-        m_cache_timestamp += fn.GetTimestamp();
+        long long fileTimestamp = fn.GetTimestamp();
+
+        it->second->SetFileTimestamp( fileTimestamp );
+        m_cache_timestamp += fileTimestamp;
+
+        // Publish the saved footprint so that other caches of this library pick it up
+        // without re-reading the file.
+        it->second->ShareFootprint( fn.GetFullPath() );
     }
 
     m_cache_timestamp += m_lib_path.GetModificationTime().GetValue().GetValue();
@@ -174,45 +337,32 @@ void FP_CACHE::Load()
     // the filename thereafter.
     WX_FILENAME fn( m_lib_raw_path, wxT( "dummyName" ) );
 
+    // Footprints parsed by an earlier Load() are carried over if their files are unchanged;
+    // everything else is only enumerated here and parsed on first access.
+    FP_CACHE_FOOTPRINT_MAP previous;
+    previous.transfer( m_footprints );
+
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
-        wxString cacheError;
-
         do
         {
             fn.SetFullName( fullName );
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
-            {
-                FILE_LINE_READER reader( fn.GetFullPath() );
-                PCB_PARSER       parser( &reader, nullptr, nullptr );
+            wxString                         fpName = fn.GetName();
+            FP_CACHE_FOOTPRINT_MAP::iterator it = previous.find( fpName );
 
-                FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
-                wxString fpName = fn.GetName();
-
-                if( !footprint )
-                {
-                    THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
-                                                      fn.GetFullPath() ) );
-                }
-
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
+            if( it != previous.end() && it->second->IsLoaded()
+                    && it->second->GetFileTimestamp() == fn.GetTimestamp() )
+            {
+                m_footprints.transfer( it, previous );
             }
-            catch( const IO_ERROR& ioe )
+            else
             {
-                if( !cacheError.IsEmpty() )
-                    cacheError += wxT( "\n\n" );
-
-                cacheError += ioe.What();
+                m_footprints.insert( fpName, new FP_CACHE_ITEM( fn ) );
             }
         } while( dir.GetNext( &fullName ) );
 
         m_cache_timestamp = GetTimestamp( m_lib_raw_path );
-
-        if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
     }
 }
 
@@ -294,8 +444,6 @@ bool PCB_PLUGIN::CanReadBoard( const wxString& aFileName ) const
 void PCB_PLUGIN::SaveBoard( const wxString& aFileName, BOARD* aBoard,
                             const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     wxString sanityResult = aBoard->GroupsSanityCheck();
 
     if( sanityResult != wxEmptyString && m_queryUserCallback )
@@ -354,8 +502,6 @@ BOARD_ITEM* PCB_PLUGIN::Parse( const wxString& aClipboardSourceInput )
 
 void PCB_PLUGIN::Format( const BOARD_ITEM* aItem, int aNestLevel ) const
 {
-    LOCALE_IO   toggle;     // public API function, perform anything convenient for caller
-
     switch( aItem->Type() )
     {
     case PCB_T:
@@ -514,9 +660,10 @@ void PCB_PLUGIN::formatPolyPts( const SHAPE_LINE_CHAIN& outline, int aNestLevel,
 
 void PCB_PLUGIN::formatRenderCache( const EDA_TEXT* aText, int aNestLevel ) const
 {
-    wxString resolvedText( aText->GetShownText( true ) );
-    std::vector<std::unique_ptr<KIFONT::GLYPH>>* cache = aText->GetRenderCache( aText->GetFont(),
-                                                                                resolvedText );
+    wxString                 resolvedText( aText->GetShownText( true ) );
+    VECTOR2I                 cachePos;
+    const KIFONT::GLYPH_RUN* cache = aText->GetRenderCache( aText->GetFont(), resolvedText,
+                                                            cachePos );
 
     m_out->Print( aNestLevel, "(render_cache %s %s\n",
                   m_out->Quotew( resolvedText ).c_str(),
@@ -528,8 +675,12 @@ void PCB_PLUGIN::formatRenderCache( const EDA_TEXT* aText, int aNestLevel ) cons
             // Polygon callback
             [&]( const SHAPE_LINE_CHAIN& aPoly )
             {
+                // The cached glyphs are shared and laid out at the origin
+                SHAPE_LINE_CHAIN poly( aPoly );
+                poly.Move( cachePos );
+
                 m_out->Print( aNestLevel + 1, "(polygon\n" );
-                formatPolyPts( aPoly, aNestLevel + 1, true );
+                formatPolyPts( poly, aNestLevel + 1, true );
                 m_out->Print( aNestLevel + 1, ")\n" );
             } );
 
@@ -792,15 +943,12 @@ void PCB_PLUGIN::format( const BOARD* aBoard, int aNestLevel ) const
     formatHeader( aBoard, aNestLevel );
 
     // Save the footprints.
-    for( BOARD_ITEM* footprint : sorted_footprints )
-    {
-        Format( footprint, aNestLevel );
-        m_out->Print( 0, "\n" );
-    }
+    formatItems( std::vector<BOARD_ITEM*>( sorted_footprints.begin(), sorted_footprints.end() ),
+                 aNestLevel, true );
 
     // Save the graphical items on the board (not owned by a footprint)
-    for( BOARD_ITEM* item : sorted_drawings )
-        Format( item, aNestLevel );
+    formatItems( std::vector<BOARD_ITEM*>( sorted_drawings.begin(), sorted_drawings.end() ),
+                 aNestLevel, false );
 
     if( sorted_drawings.size() )
         m_out->Print( 0, "\n" );
@@ -808,15 +956,15 @@ void PCB_PLUGIN::format( const BOARD* aBoard, int aNestLevel ) const
     // Do not save PCB_MARKERs, they can be regenerated easily.
 
     // Save the tracks and vias.
-    for( PCB_TRACK* track : sorted_tracks )
-        Format( track, aNestLevel );
+    formatItems( std::vector<BOARD_ITEM*>( sorted_tracks.begin(), sorted_tracks.end() ),
+                 aNestLevel, false );
 
     if( sorted_tracks.size() )
         m_out->Print( 0, "\n" );
 
     // Save the polygon (which are the newer technology) zones.
-    for( auto zone : sorted_zones )
-        Format( zone, aNestLevel );
+    formatItems( std::vector<BOARD_ITEM*>( sorted_zones.begin(), sorted_zones.end() ),
+                 aNestLevel, false );
 
     // Save the groups
     for( BOARD_ITEM* group : sorted_groups )
@@ -828,6 +976,61 @@ void PCB_PLUGIN::format( const BOARD* aBoard, int aNestLevel ) const
 }
 
 
+void PCB_PLUGIN::formatItems( const std::vector<BOARD_ITEM*>& aItems, int aNestLevel,
+                              bool aNewlineAfterEach ) const
+{
+    if( aItems.size() < 2 )
+    {
+        for( BOARD_ITEM* item : aItems )
+        {
+            Format( item, aNestLevel );
+
+            if( aNewlineAfterEach )
+                m_out->Print( 0, "\n" );
+        }
+
+        return;
+    }
+
+    // Each block is formatted by its own plugin into its own string, and the strings are
+    // written out in the original order so the file is the same as a serial save.
+    auto formatBlock =
+            [&]( size_t aStart, size_t aEnd ) -> std::string
+            {
+                PCB_PLUGIN worker( m_ctl );
+
+                worker.m_board = m_board;
+                *worker.m_mapping = *m_mapping;
+
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    worker.Format( aItems[ii], aNestLevel );
+
+                    if( aNewlineAfterEach )
+                        worker.m_out->Print( 0, "\n" );
+                }
+
+                return worker.GetStringOutput( true );
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       blocks = std::min<size_t>( aItems.size(), tp.get_thread_count() * 4 );
+    auto         results = tp.parallelize_loop( 0, aItems.size(), formatBlock, blocks );
+
+    try
+    {
+        for( size_t ii = 0; ii < results.size(); ++ii )
+            m_out->Write( results[ii].get() );
+    }
+    catch( ... )
+    {
+        // Don't leave workers running on items the caller may be about to free
+        results.wait();
+        throw;
+    }
+}
+
+
 void PCB_PLUGIN::format( const PCB_DIMENSION_BASE* aDimension, int aNestLevel ) const
 {
     const PCB_DIM_ALIGNED*    aligned = dynamic_cast<const PCB_DIM_ALIGNED*>( aDimension );
@@ -1045,7 +1248,8 @@ void PCB_PLUGIN::format( const PCB_REFERENCE_IMAGE* aBitmap, int aNestLevel ) co
     formatLayer( aBitmap->GetLayer() );
 
     if( aBitmap->GetImage()->GetScale() != 1.0 )
-        m_out->Print( 0, " (scale %g)", aBitmap->GetImage()->GetScale() );
+        m_out->Print( 0, " (scale %s)",
+                      fmt::format( "{:g}", aBitmap->GetImage()->GetScale() ).c_str() );
 
     m_out->Print( 0, "\n" );
 
@@ -1317,7 +1521,8 @@ void PCB_PLUGIN::format( const FOOTPRINT* aFootprint, int aNestLevel ) const
                           bs3D->m_Show ? "" : " hide" );
 
             if( bs3D->m_Opacity != 1.0 )
-                m_out->Print( aNestLevel+2, "(opacity %0.4f)", bs3D->m_Opacity );
+                m_out->Print( aNestLevel+2, "(opacity %s)",
+                              fmt::format( "{:.4f}", bs3D->m_Opacity ).c_str() );
 
             m_out->Print( aNestLevel+2, "(offset (xyz %s %s %s))\n",
                           FormatDouble2Str( bs3D->m_Offset.x ).c_str(),
@@ -2371,7 +2576,7 @@ void PCB_PLUGIN::format( const ZONE* aZone, int aNestLevel ) const
     // Save the PolysList (filled areas)
     for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
     {
-        const std::shared_ptr<SHAPE_POLY_SET>& fv = aZone->GetFilledPolysList( layer );
+        std::shared_ptr<const SHAPE_POLY_SET> fv = aZone->GetFilledPolysList( layer );
 
         for( int ii = 0; ii < fv->OutlineCount(); ++ii )
         {
@@ -2487,20 +2692,24 @@ void PCB_PLUGIN::init( const STRING_UTF8_MAP* aProperties )
 
 void PCB_PLUGIN::validateCache( const wxString& aLibraryPath, bool checkModified )
 {
-    if( !m_cache || !m_cache->IsPath( aLibraryPath ) || ( checkModified && m_cache->IsModified() ) )
+    if( !m_cache || !m_cache->IsPath( aLibraryPath ) )
     {
         // a spectacular episode in memory management:
         delete m_cache;
         m_cache = new FP_CACHE( this, aLibraryPath );
         m_cache->Load();
     }
+    else if( checkModified && m_cache->IsModified() )
+    {
+        // Re-enumerate, keeping any already-parsed footprints whose files haven't changed.
+        m_cache->Load();
+    }
 }
 
 
 void PCB_PLUGIN::FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibPath,
                                      bool aBestEfforts, const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
     wxDir     dir( aLibPath );
     wxString  errorMsg;
 
@@ -2519,7 +2728,21 @@ void PCB_PLUGIN::FootprintEnumerate( wxArrayString& aFootprintNames, const wxStr
     // the library.
 
     for( const auto& footprint : m_cache->GetFootprints() )
+    {
+        // Files which failed to parse on first use
+        wxString parseError = footprint.second->GetParseError();
+
+        if( !parseError.IsEmpty() )
+        {
+            if( !errorMsg.IsEmpty() )
+                errorMsg += wxT( "\n\n" );
+
+            errorMsg += parseError;
+            continue;
+        }
+
         aFootprintNames.Add( footprint.first );
+    }
 
     if( !errorMsg.IsEmpty() && !aBestEfforts )
         THROW_IO_ERROR( errorMsg );
@@ -2531,8 +2754,6 @@ const FOOTPRINT* PCB_PLUGIN::getFootprint( const wxString& aLibraryPath,
                                            const STRING_UTF8_MAP* aProperties,
                                            bool checkModified )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     try
@@ -2622,8 +2843,6 @@ FOOTPRINT* PCB_PLUGIN::FootprintLoad( const wxString& aLibraryPath,
 void PCB_PLUGIN::FootprintSave( const wxString& aLibraryPath, const FOOTPRINT* aFootprint,
                                 const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     // In this public PLUGIN API function, we can safely assume it was
@@ -2719,8 +2938,6 @@ void PCB_PLUGIN::FootprintSave( const wxString& aLibraryPath, const FOOTPRINT* a
 void PCB_PLUGIN::FootprintDelete( const wxString& aLibraryPath, const wxString& aFootprintName,
                                   const STRING_UTF8_MAP* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     validateCache( aLibraryPath );
@@ -2750,8 +2967,6 @@ void PCB_PLUGIN::FootprintLibCreate( const wxString& aLibraryPath, const STRING_
                                           aLibraryPath.GetData() ) );
     }
 
-    LOCALE_IO   toggle;
-
     init( aProperties );
 
     delete m_cache;
@@ -2839,8 +3054,6 @@ bool PCB_PLUGIN::FootprintLibDelete( const wxString& aLibraryPath, const STRING_
 
 bool PCB_PLUGIN::IsFootprintLibWritable( const wxString& aLibraryPath )
 {
-    LOCALE_IO   toggle;
-
     init( nullptr );
 
     validateCache( aLibraryPath );
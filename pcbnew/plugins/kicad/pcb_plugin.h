@@ -27,6 +27,7 @@
 
 #include <io_mgr.h>
 #include <richio.h>
+#include <mutex>
 #include <string>
 #include <layer_ids.h>
 #include <boost/ptr_container/ptr_map.hpp>
@@ -184,15 +185,65 @@ class PCB_PLUGIN;   // forward decl
  */
 class FP_CACHE_ITEM
 {
-    WX_FILENAME                m_filename;
-    std::unique_ptr<FOOTPRINT> m_footprint;
+    mutable WX_FILENAME                      m_filename;
+    mutable std::shared_ptr<const FOOTPRINT> m_footprint;      // May be shared with other caches
+    mutable long long                        m_fileTimestamp;  // File mod time when parsed/saved
+    mutable wxString                         m_parseError;     // Sticky error from a failed parse
+    mutable std::mutex                       m_mutex;          // Guards the lazy parse
 
 public:
     FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
+    /**
+     * Create an item for a footprint file which has been enumerated but not yet parsed.
+     * The file is parsed the first time GetFootprint() is called.
+     */
+    FP_CACHE_ITEM( const WX_FILENAME& aFileName );
+
     const WX_FILENAME& GetFileName() const { return m_filename; }
     void               SetFilePath( const wxString& aFilePath ) { m_filename.SetPath( aFilePath ); }
-    const FOOTPRINT*   GetFootprint() const { return m_footprint.get(); }
+
+    /**
+     * Return the footprint, parsing its file first if it has not been read yet.
+     *
+     * Parsed footprints are shared process-wide with every other cache of the same file (see
+     * FP_SHARED_CACHE), so a library used by several tables, frames or jobs is read once.
+     * The returned footprint is therefore const: clone it to make changes.
+     *
+     * @throw IO_ERROR if the file cannot be read or parsed.
+     */
+    const FOOTPRINT*   GetFootprint() const;
+
+    /**
+     * @return true if the footprint has already been parsed (or was created in memory).
+     */
+    bool               IsLoaded() const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_footprint != nullptr;
+    }
+
+    /**
+     * @return the error from a failed attempt to parse the footprint file, or an empty string.
+     */
+    wxString           GetParseError() const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_parseError;
+    }
+
+    /**
+     * @return the modification time of the footprint file at the time it was last parsed or
+     *         saved, or 0 if it has not been parsed yet.
+     */
+    long long          GetFileTimestamp() const { return m_fileTimestamp; }
+    void               SetFileTimestamp( long long aTimestamp ) { m_fileTimestamp = aTimestamp; }
+
+    /**
+     * Make the (already loaded) footprint available to other caches of \a aFullPath at the
+     * current file timestamp.
+     */
+    void               ShareFootprint( const wxString& aFullPath );
 };
 
 typedef boost::ptr_map<wxString, FP_CACHE_ITEM> FP_CACHE_FOOTPRINT_MAP;
@@ -231,6 +282,16 @@ public:
      */
     void Save( FOOTPRINT* aFootprint = nullptr );
 
+    /**
+     * Enumerate the footprint files in the library.
+     *
+     * Footprint files are not read here; each one is parsed on first access through
+     * FP_CACHE_ITEM::GetFootprint(), which is also where a broken file is reported.
+     * Footprints which were already parsed by a previous Load() and whose files have not
+     * changed since are kept rather than re-read.
+     *
+     * @throw IO_ERROR if the library can't be read.
+     */
     void Load();
 
     void Remove( const wxString& aFootprintName );
@@ -428,6 +489,14 @@ private:
 
     void format( const ZONE* aZone, int aNestLevel = 0 ) const;
 
+    /**
+     * Format a run of top level board items in order, spreading the work over the thread pool.
+     *
+     * @param aNewlineAfterEach true to emit a blank line after each item (as for footprints).
+     */
+    void formatItems( const std::vector<BOARD_ITEM*>& aItems, int aNestLevel,
+                      bool aNewlineAfterEach ) const;
+
     void formatPolyPts( const SHAPE_LINE_CHAIN& outline, int aNestLevel, bool aCompact,
                         const FOOTPRINT* aParentFP = nullptr ) const;
 
@@ -79,6 +79,8 @@ HANDLE_EXCEPTIONS(BOARD::TracksInNetBetweenPoints)
 %ignore BOARD::m_IntersectsAreaCache;
 %ignore BOARD::m_EnclosedByAreaCache;
 %ignore BOARD::m_LayerExpressionCache;
+%ignore BOARD::m_DeflatedAreaOutlineCache;
+%ignore BOARD::m_RuleAreaNameCache;
 %ignore BOARD::m_CopperZoneRTreeCache;
 %ignore BOARD::m_CopperItemRTreeCache;
 %ignore BOARD::m_DRCZones;
@@ -29,6 +29,7 @@
 
 #include "pns_line.h"
 #include "pns_linked_item.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -37,6 +38,8 @@ class NODE;
 class ARC : public LINKED_ITEM
 {
 public:
+    PNS_POOLED_ITEM( ARC )
+
     ARC() :
         LINKED_ITEM( ARC_T )
     {}
@@ -0,0 +1,130 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_HULL_CACHE_H
+#define __PNS_HULL_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <geometry/shape_line_chain.h>
+
+namespace PNS {
+
+/**
+ * Remembers the last few hulls built for an item.
+ *
+ * The walkaround and shove algorithms ask the same obstacles for their hull over and over,
+ * nearly always with the same clearance and line width.  Items with costly hulls (pads made
+ * of several primitives, which need a polygon union) keep them here, keyed by clearance,
+ * walkaround thickness and one more value of the owner's choosing, which must capture
+ * everything else the hull depends on.  The owner must call Clear() whenever its geometry
+ * changes.
+ *
+ * Hulls are copied in and out under a lock, so an item may be queried from several threads.
+ */
+class HULL_CACHE
+{
+public:
+    HULL_CACHE() = default;
+
+    // A copied item may get new geometry, so the copy starts out empty
+    HULL_CACHE( const HULL_CACHE& ) {}
+    HULL_CACHE& operator=( const HULL_CACHE& )
+    {
+        Clear();
+        return *this;
+    }
+
+    /**
+     * Return the cached hull for the given parameters, calling \a aBuild to create (and cache)
+     * it if there is none.
+     *
+     * @param aKey is whatever else, beside the clearance and thickness, the hull depends on.
+     */
+    template <typename FUNC>
+    SHAPE_LINE_CHAIN Get( int aClearance, int aWalkaroundThickness, int aKey, FUNC&& aBuild )
+    {
+        {
+            std::lock_guard<std::mutex> lock( mutexFor( this ) );
+
+            for( const ENTRY& entry : m_entries )
+            {
+                if( entry.m_clearance == aClearance
+                        && entry.m_walkaroundThickness == aWalkaroundThickness
+                        && entry.m_key == aKey )
+                {
+                    return entry.m_hull;
+                }
+            }
+        }
+
+        SHAPE_LINE_CHAIN hull = aBuild();
+
+        std::lock_guard<std::mutex> lock( mutexFor( this ) );
+
+        if( m_entries.size() < MAX_ENTRIES )
+        {
+            m_entries.push_back( { aClearance, aWalkaroundThickness, aKey, hull } );
+        }
+        else
+        {
+            m_entries[m_next] = { aClearance, aWalkaroundThickness, aKey, hull };
+            m_next = ( m_next + 1 ) % MAX_ENTRIES;
+        }
+
+        return hull;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock( mutexFor( this ) );
+
+        m_entries.clear();
+        m_next = 0;
+    }
+
+private:
+    static constexpr size_t MAX_ENTRIES = 4;
+
+    struct ENTRY
+    {
+        int              m_clearance;
+        int              m_walkaroundThickness;
+        int              m_key;
+        SHAPE_LINE_CHAIN m_hull;
+    };
+
+    // A mutex per item would double the size of small items; share a fixed set of them instead
+    static std::mutex& mutexFor( const HULL_CACHE* aCache )
+    {
+        static std::array<std::mutex, 64> s_mutexes;
+
+        return s_mutexes[ ( reinterpret_cast<uintptr_t>( aCache ) >> 4 ) % s_mutexes.size() ];
+    }
+
+    std::vector<ENTRY> m_entries;
+    size_t             m_next = 0;
+};
+
+}
+
+#endif
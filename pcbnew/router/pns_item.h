@@ -23,6 +23,7 @@
 #ifndef __PNS_ITEM_H
 #define __PNS_ITEM_H
 
+#include <atomic>
 #include <memory>
 #include <unordered_set>
 #include <math/vector2d.h>
@@ -123,6 +124,7 @@ public:
         m_isVirtual = false;
         m_isFreePad = false;
         m_isCompoundShapePrimitive = false;
+        m_uid = newUid();
     }
 
     ITEM( const ITEM& aOther )
@@ -139,10 +141,17 @@ public:
         m_isVirtual = aOther.m_isVirtual;
         m_isFreePad = aOther.m_isFreePad;
         m_isCompoundShapePrimitive = aOther.m_isCompoundShapePrimitive;
+        m_uid = newUid();
     }
 
     virtual ~ITEM();
 
+    /**
+     * Return a number identifying this item for the lifetime of the process.  Unlike the
+     * item's address it is never handed out again once the item is freed.
+     */
+    uint64_t Uid() const { return m_uid; }
+
     /**
      * Return a deep copy of the item.
      */
@@ -280,6 +289,12 @@ private:
     bool collideSimple( const ITEM* aHead, const NODE* aNode,
                         COLLISION_SEARCH_CONTEXT* aCtx ) const;
 
+    static uint64_t newUid()
+    {
+        static std::atomic<uint64_t> nextUid( 1 );
+        return nextUid.fetch_add( 1, std::memory_order_relaxed );
+    }
+
 protected:
     PnsKind       m_kind;
 
@@ -294,6 +309,9 @@ protected:
     bool          m_isVirtual;
     bool          m_isFreePad;
     bool          m_isCompoundShapePrimitive;
+
+private:
+    uint64_t      m_uid;
 };
 
 template<typename T, typename S>
@@ -0,0 +1,138 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_ITEM_POOL_H
+#define __PNS_ITEM_POOL_H
+
+#include <cstddef>
+#include <new>
+
+namespace PNS {
+
+/**
+ * Recycles the memory of one type of router item.
+ *
+ * Shoving and walking around clone and throw away thousands of segments, arcs, vias and
+ * lines for every mouse move.  Freed blocks are kept on a per-thread free list and handed
+ * out again, so once a route is under way the router rarely goes to the system allocator.
+ *
+ * Only blocks of exactly sizeof( T ) are pooled; larger derived types (such as VVIA) go
+ * straight to the global allocator.  Each block is a separate global allocation, so a block
+ * can safely be freed on a different thread than the one that allocated it.
+ */
+template <typename T>
+class ITEM_POOL
+{
+public:
+    static void* Allocate( size_t aSize )
+    {
+        if( aSize == sizeof( T ) && s_alive )
+        {
+            FREE_LIST& list = freeList();
+
+            if( list.m_head )
+            {
+                FREE_BLOCK* block = list.m_head;
+
+                list.m_head = block->m_next;
+                list.m_count--;
+                return block;
+            }
+        }
+
+        return ::operator new( aSize );
+    }
+
+    static void Free( void* aPtr, size_t aSize )
+    {
+        if( aPtr && aSize == sizeof( T ) && s_alive )
+        {
+            FREE_LIST& list = freeList();
+
+            if( list.m_count < MAX_CACHED_BLOCKS )
+            {
+                FREE_BLOCK* block = static_cast<FREE_BLOCK*>( aPtr );
+
+                block->m_next = list.m_head;
+                list.m_head = block;
+                list.m_count++;
+                return;
+            }
+        }
+
+        ::operator delete( aPtr );
+    }
+
+private:
+    static_assert( sizeof( T ) >= sizeof( void* ), "pooled type too small for a free list link" );
+
+    ///< Upper bound on the memory a thread keeps around for each pooled type
+    static constexpr size_t MAX_CACHED_BLOCKS = 8192;
+
+    struct FREE_BLOCK
+    {
+        FREE_BLOCK* m_next;
+    };
+
+    struct FREE_LIST
+    {
+        ~FREE_LIST()
+        {
+            // Items deleted after this (e.g. by static destructors) bypass the pool
+            s_alive = false;
+
+            while( m_head )
+            {
+                FREE_BLOCK* next = m_head->m_next;
+                ::operator delete( m_head );
+                m_head = next;
+            }
+        }
+
+        FREE_BLOCK* m_head = nullptr;
+        size_t      m_count = 0;
+    };
+
+    static FREE_LIST& freeList()
+    {
+        thread_local FREE_LIST list;
+        return list;
+    }
+
+    // Trivially destructible, so still readable once the thread's free list is gone
+    static inline thread_local bool s_alive = true;
+};
+
+}
+
+/**
+ * Route the allocations of a router item class through ITEM_POOL.  Goes in the public
+ * section of the class declaration.
+ */
+#define PNS_POOLED_ITEM( Type )                                                                    \
+    static void* operator new( size_t aSize )                                                      \
+    {                                                                                              \
+        return PNS::ITEM_POOL<Type>::Allocate( aSize );                                            \
+    }                                                                                              \
+    static void operator delete( void* aPtr, size_t aSize )                                        \
+    {                                                                                              \
+        PNS::ITEM_POOL<Type>::Free( aPtr, aSize );                                                 \
+    }
+
+#endif
@@ -78,11 +78,14 @@ struct CLEARANCE_CACHE_KEY
 {
     const PNS::ITEM*  A;
     const PNS::ITEM*  B;
+    uint64_t          UidA;     // Router items are pooled, so an address alone may be reused
+    uint64_t          UidB;     // by a different item
     bool              Flag;
 
     bool operator==(const CLEARANCE_CACHE_KEY& other) const
     {
-        return A == other.A && B == other.B && Flag == other.Flag;
+        return A == other.A && B == other.B && UidA == other.UidA && UidB == other.UidB
+                && Flag == other.Flag;
     }
 };
 
@@ -139,6 +142,8 @@ private:
     PCB_VIA            m_dummyVias[2];
     int                m_clearanceEpsilon;
 
+    // Dropped whenever a new route or drag starts, as rules, netclasses or rule areas may have
+    // been edited since the last one (deleted items are pruned through ClearCacheForItems())
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_clearanceCache;
 };
 
@@ -459,6 +464,9 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItems( std::vector<const PNS::ITEM*>
    items in the set, as the clearance relation is commutative ( CL[a,b] == CL[b,a] ). The code
    below is a bit ugly, but works in O(n*log(m)) and is run once or twice during ROUTER::Move() call
    - so I hope it still gets better performance than no cache at all */
+    if( remainingItems.empty() )
+        return;
+
     for( auto it = m_clearanceCache.begin(); it != m_clearanceCache.end(); )
     {
         bool dirty = remainingItems.find( it->first.A ) != remainingItems.end();
@@ -486,7 +494,7 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                          bool aUseClearanceEpsilon )
 {
-    CLEARANCE_CACHE_KEY key = { aA, aB, aUseClearanceEpsilon };
+    CLEARANCE_CACHE_KEY key = { aA, aB, aA->Uid(), aB ? aB->Uid() : 0, aUseClearanceEpsilon };
     auto it = m_clearanceCache.find( key );
 
     if( it != m_clearanceCache.end() )
@@ -551,8 +559,8 @@ int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* a
 
 
 /* It makes no sense to put items that have no owning NODE in the cache - they can be allocated on stack
-   and we can't really invalidate them in the cache when they are destroyed. Probably a better idea would be
-   to use a static unique counter in PNS::ITEM constructor to generate the cache keys. */
+   and are mostly thrown away right after.  Items which are freed without being pruned from the cache
+   can't be mistaken for later ones at the same address, as the key includes the items' Uid(). */
     if( aA && aB && aA->Owner() && aB->Owner() )
     {
         m_clearanceCache[ key ] = rv;
@@ -1019,6 +1027,10 @@ PNS_KICAD_IFACE_BASE::PNS_KICAD_IFACE_BASE()
     m_world = nullptr;
     m_debugDecorator = nullptr;
     m_startLayer = -1;
+    m_trackingChanges = false;
+    m_worldValid = false;
+    m_ignoreTrackChanges = false;
+    m_syncedMaxClearance = 0;
 }
 
 
@@ -1033,6 +1045,7 @@ PNS_KICAD_IFACE::PNS_KICAD_IFACE()
 
 PNS_KICAD_IFACE_BASE::~PNS_KICAD_IFACE_BASE()
 {
+    StopTrackingChanges();
 }
 
 
@@ -1493,6 +1506,62 @@ bool PNS_KICAD_IFACE::IsItemVisible( const PNS::ITEM* aItem ) const
 }
 
 
+void PNS_KICAD_IFACE_BASE::syncFootprint( PNS::NODE* aWorld, FOOTPRINT* aFootprint,
+                                          SHAPE_POLY_SET* aBoardOutline, int& aWorstClearance )
+{
+    FOOTPRINT_SYNC& sync = m_syncedFootprints[ aFootprint ];
+
+    sync.m_parents.clear();
+    sync.m_hasEdgeExclusions = false;
+
+    for( PAD* pad : aFootprint->Pads() )
+    {
+        if( std::unique_ptr<PNS::SOLID> solid = syncPad( pad ) )
+            aWorld->Add( std::move( solid ) );
+
+        sync.m_parents.push_back( pad );
+        aWorstClearance = std::max( aWorstClearance, pad->GetLocalClearance() );
+
+        if( pad->GetProperty() == PAD_PROP::CASTELLATED )
+        {
+            std::unique_ptr<SHAPE> hole;
+            hole.reset( pad->GetEffectiveHoleShape()->Clone() );
+            aWorld->AddEdgeExclusion( std::move( hole ) );
+            sync.m_hasEdgeExclusions = true;
+        }
+    }
+
+    syncTextItem( aWorld, &aFootprint->Reference(), aFootprint->Reference().GetLayer() );
+    syncTextItem( aWorld, &aFootprint->Value(), aFootprint->Value().GetLayer() );
+
+    for( ZONE* zone : aFootprint->Zones() )
+    {
+        syncZone( aWorld, zone, aBoardOutline );
+        sync.m_parents.push_back( zone );
+    }
+
+    for( PCB_FIELD* field : aFootprint->Fields() )
+    {
+        syncTextItem( aWorld, static_cast<PCB_TEXT*>( field ), field->GetLayer() );
+        sync.m_parents.push_back( field );
+    }
+
+    for( BOARD_ITEM* item : aFootprint->GraphicalItems() )
+    {
+        if( item->Type() == PCB_SHAPE_T || item->Type() == PCB_TEXTBOX_T )
+        {
+            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( item ) );
+        }
+        else if( item->Type() == PCB_TEXT_T )
+        {
+            syncTextItem( aWorld, static_cast<PCB_TEXT*>( item ), item->GetLayer() );
+        }
+
+        sync.m_parents.push_back( item );
+    }
+}
+
+
 void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
 {
     if( !m_board )
@@ -1504,6 +1573,11 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
     int worstClearance = m_board->GetMaxClearanceValue();
 
     m_world = aWorld;
+    m_syncedMaxClearance = worstClearance;
+    m_dirtyItems.clear();
+    m_removedItems.clear();
+    m_syncedZones.clear();
+    m_syncedFootprints.clear();
 
     for( BOARD_ITEM* gitem : m_board->Drawings() )
     {
@@ -1525,47 +1599,12 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
 
     for( ZONE* zone : m_board->Zones() )
     {
-        syncZone( aWorld, zone, boardOutline );
+        if( syncZone( aWorld, zone, boardOutline ) )
+            m_syncedZones.insert( zone );
     }
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        for( PAD* pad : footprint->Pads() )
-        {
-            if( std::unique_ptr<PNS::SOLID> solid = syncPad( pad ) )
-                aWorld->Add( std::move( solid ) );
-
-            worstClearance = std::max( worstClearance, pad->GetLocalClearance() );
-
-            if( pad->GetProperty() == PAD_PROP::CASTELLATED )
-            {
-                std::unique_ptr<SHAPE> hole;
-                hole.reset( pad->GetEffectiveHoleShape()->Clone() );
-                aWorld->AddEdgeExclusion( std::move( hole ) );
-            }
-        }
-
-        syncTextItem( aWorld, &footprint->Reference(), footprint->Reference().GetLayer() );
-        syncTextItem( aWorld, &footprint->Value(), footprint->Value().GetLayer() );
-
-        for( ZONE* zone : footprint->Zones() )
-            syncZone( aWorld, zone, boardOutline );
-
-        for( PCB_FIELD* field : footprint->Fields() )
-            syncTextItem( aWorld, static_cast<PCB_TEXT*>( field ), field->GetLayer() );
-
-        for( BOARD_ITEM* item : footprint->GraphicalItems() )
-        {
-            if( item->Type() == PCB_SHAPE_T || item->Type() == PCB_TEXTBOX_T )
-            {
-                syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( item ) );
-            }
-            else if( item->Type() == PCB_TEXT_T )
-            {
-                syncTextItem( aWorld, static_cast<PCB_TEXT*>( item ), item->GetLayer() );
-            }
-        }
-    }
+        syncFootprint( aWorld, footprint, boardOutline, worstClearance );
 
     for( PCB_TRACK* t : m_board->Tracks() )
     {
@@ -1588,13 +1627,307 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
         }
     }
 
-    // NB: if this were ever to become a long-lived object we would need to dirty its
-    // clearance cache here....
+    // A new world means new items, so start over with an empty clearance cache.  Incremental
+    // updates (see UpdateWorld()) keep the resolver and prune its cache item by item.
     delete m_ruleResolver;
     m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, this );
 
     aWorld->SetRuleResolver( m_ruleResolver );
     aWorld->SetMaxClearance( worstClearance + m_ruleResolver->ClearanceEpsilon() );
+
+    m_worldValid = m_trackingChanges;
+}
+
+
+bool PNS_KICAD_IFACE_BASE::UpdateWorld( PNS::NODE* aWorld )
+{
+    if( !m_board || !m_worldValid || aWorld != m_world || !m_ruleResolver )
+        return false;
+
+    // Clearance rules have changed; every item's hull may be affected
+    if( m_board->GetMaxClearanceValue() != m_syncedMaxClearance )
+        return false;
+
+    // Rules, netclasses and rule areas can all be edited between routes without any of the
+    // world's items changing, so never carry clearances over from the last route.  (This also
+    // drops entries keyed on freed branch items whose addresses new items could reuse.)
+    m_ruleResolver->ClearCaches();
+
+    if( m_dirtyItems.empty() && m_removedItems.empty() )
+        return true;
+
+    std::unordered_set<const BOARD_ITEM*> staleParents;
+    std::vector<const BOARD_ITEM*>        staleFootprints;
+
+    auto collectStale =
+            [&]( const BOARD_ITEM* aItem ) -> bool
+            {
+                auto it = m_syncedFootprints.find( aItem );
+
+                if( it == m_syncedFootprints.end() )
+                {
+                    staleParents.insert( aItem );
+                    return true;
+                }
+
+                // Edge exclusions can't be taken out of the world again
+                if( it->second.m_hasEdgeExclusions )
+                    return false;
+
+                staleParents.insert( it->second.m_parents.begin(), it->second.m_parents.end() );
+                staleFootprints.push_back( aItem );
+                return true;
+            };
+
+    for( const BOARD_ITEM* item : m_removedItems )
+    {
+        if( !collectStale( item ) )
+            return false;
+    }
+
+    for( const BOARD_ITEM* item : m_dirtyItems )
+    {
+        if( !collectStale( item ) )
+            return false;
+    }
+
+    wxLogTrace( wxT( "PNS" ), wxT( "UpdateWorld: %d changed, %d removed" ),
+                (int) m_dirtyItems.size(), (int) m_removedItems.size() );
+
+    for( PNS::ITEM* item : aWorld->FindItemsByParents( staleParents ) )
+        aWorld->Remove( item );
+
+    for( const BOARD_ITEM* footprint : staleFootprints )
+        m_syncedFootprints.erase( footprint );
+
+    int             worstClearance = m_syncedMaxClearance;
+    SHAPE_POLY_SET  buffer;
+    SHAPE_POLY_SET* boardOutline = nullptr;
+    bool            outlineValid = false;
+
+    for( BOARD_ITEM* item : m_dirtyItems )
+    {
+        switch( item->Type() )
+        {
+        case PCB_TRACE_T:
+            if( std::unique_ptr<PNS::SEGMENT> segment = syncTrack( static_cast<PCB_TRACK*>( item ) ) )
+                aWorld->Add( std::move( segment ) );
+
+            break;
+
+        case PCB_ARC_T:
+            if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( item ) ) )
+                aWorld->Add( std::move( arc ) );
+
+            break;
+
+        case PCB_VIA_T:
+            if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( item ) ) )
+                aWorld->Add( std::move( via ) );
+
+            break;
+
+        case PCB_FOOTPRINT_T:
+            if( !outlineValid )
+            {
+                if( m_board->GetBoardPolygonOutlines( buffer ) )
+                    boardOutline = &buffer;
+
+                outlineValid = true;
+            }
+
+            syncFootprint( aWorld, static_cast<FOOTPRINT*>( item ), boardOutline, worstClearance );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    m_dirtyItems.clear();
+    m_removedItems.clear();
+
+    worstClearance += m_ruleResolver->ClearanceEpsilon();
+
+    if( worstClearance > aWorld->GetMaxClearance() )
+        aWorld->SetMaxClearance( worstClearance );
+
+    return true;
+}
+
+
+void PNS_KICAD_IFACE_BASE::StartTrackingChanges()
+{
+    if( m_trackingChanges || !m_board )
+        return;
+
+    m_board->AddListener( this );
+    m_trackingChanges = true;
+}
+
+
+void PNS_KICAD_IFACE_BASE::StopTrackingChanges( bool aBoardAlive )
+{
+    if( m_trackingChanges && aBoardAlive && m_board )
+        m_board->RemoveListener( this );
+
+    m_trackingChanges = false;
+    invalidateWorld();
+}
+
+
+void PNS_KICAD_IFACE_BASE::invalidateWorld()
+{
+    m_worldValid = false;
+    m_dirtyItems.clear();
+    m_removedItems.clear();
+}
+
+
+void PNS_KICAD_IFACE_BASE::itemChanged( BOARD_ITEM* aItem )
+{
+    // Once a full sync is due there's no point keeping track of anything else
+    if( !m_worldValid )
+        return;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+        // Tracks committed by the router itself are already in the world
+        if( m_ignoreTrackChanges )
+            return;
+
+        m_removedItems.erase( aItem );
+        m_dirtyItems.insert( aItem );
+        break;
+
+    case PCB_FOOTPRINT_T:
+        m_removedItems.erase( aItem );
+        m_dirtyItems.insert( aItem );
+        break;
+
+    case PCB_PAD_T:
+        if( FOOTPRINT* footprint = aItem->GetParentFootprint() )
+            itemChanged( footprint );
+        else
+            invalidateWorld();
+
+        break;
+
+    case PCB_ZONE_T:
+    {
+        ZONE* zone = static_cast<ZONE*>( aItem );
+
+        // Only keepouts are part of the world; refilling copper zones (or teardrops) is not
+        // our concern
+        if( m_syncedZones.count( zone ) || ( zone->GetIsRuleArea() && zone->GetDoNotAllowTracks() ) )
+            invalidateWorld();
+
+        break;
+    }
+
+    case PCB_SHAPE_T:
+    case PCB_TEXT_T:
+    case PCB_TEXTBOX_T:
+    case PCB_FIELD_T:
+        // These may change the board outline, which all keepouts are clipped against
+        invalidateWorld();
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void PNS_KICAD_IFACE_BASE::itemRemoved( BOARD_ITEM* aItem )
+{
+    if( !m_worldValid )
+        return;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+        if( m_ignoreTrackChanges )
+            return;
+
+        m_dirtyItems.erase( aItem );
+        m_removedItems.insert( aItem );
+        break;
+
+    case PCB_FOOTPRINT_T:
+        m_dirtyItems.erase( aItem );
+        m_removedItems.insert( aItem );
+        break;
+
+    case PCB_ZONE_T:
+        if( m_syncedZones.count( static_cast<ZONE*>( aItem ) ) )
+            invalidateWorld();
+
+        break;
+
+    case PCB_PAD_T:
+    case PCB_SHAPE_T:
+    case PCB_TEXT_T:
+    case PCB_TEXTBOX_T:
+    case PCB_FIELD_T:
+        invalidateWorld();
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    itemChanged( aBoardItem );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        itemChanged( item );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    itemRemoved( aBoardItem );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsRemoved( BOARD& aBoard,
+                                                std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        itemRemoved( item );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    itemChanged( aBoardItem );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsChanged( BOARD& aBoard,
+                                                std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        itemChanged( item );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardNetSettingsChanged( BOARD& aBoard )
+{
+    invalidateWorld();
 }
 
 
@@ -1955,7 +2288,9 @@ void PNS_KICAD_IFACE::Commit()
 
     m_fpOffsets.clear();
 
+    m_ignoreTrackChanges = true;
     m_commit->Push( _( "Routing" ), m_commitFlags );
+    m_ignoreTrackChanges = false;
     m_commit = std::make_unique<BOARD_COMMIT>( m_tool );
 }
 
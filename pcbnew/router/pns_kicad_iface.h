@@ -22,14 +22,16 @@
 #ifndef __PNS_KICAD_IFACE_H
 #define __PNS_KICAD_IFACE_H
 
+#include <unordered_map>
 #include <unordered_set>
 
+#include <board.h>
+
 #include "pns_router.h"
 
 class PNS_PCBNEW_RULE_RESOLVER;
 class PNS_PCBNEW_DEBUG_DECORATOR;
 
-class BOARD;
 class BOARD_COMMIT;
 class PCB_TEXT;
 class PCB_DISPLAY_OPTIONS;
@@ -48,7 +50,7 @@ namespace KIGFX
     class VIEW;
 }
 
-class PNS_KICAD_IFACE_BASE : public PNS::ROUTER_IFACE
+class PNS_KICAD_IFACE_BASE : public PNS::ROUTER_IFACE, public BOARD_LISTENER
 {
 public:
     PNS_KICAD_IFACE_BASE();
@@ -57,6 +59,33 @@ public:
     void EraseView() override {};
     void SetBoard( BOARD* aBoard );
     void SyncWorld( PNS::NODE* aWorld ) override;
+    bool UpdateWorld( PNS::NODE* aWorld ) override;
+
+    /**
+     * Listen to the board so that UpdateWorld() can apply its changes to the world instead
+     * of the world being rebuilt from scratch.
+     *
+     * The iface unregisters itself when destroyed, so if the board is deleted first then
+     * StopTrackingChanges() must be called before that.
+     */
+    void StartTrackingChanges();
+
+    /**
+     * Stop listening to the board and forget any pending changes.
+     *
+     * @param aBoardAlive false if the board has been deleted and must not be touched.
+     */
+    void StopTrackingChanges( bool aBoardAlive = true );
+
+    bool IsTrackingChanges() const { return m_trackingChanges; }
+
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardNetSettingsChanged( BOARD& aBoard ) override;
     bool IsAnyLayerVisible( const LAYER_RANGE& aLayer ) const override { return true; };
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, int aLayer ) const override;
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, const LAYER_RANGE& aLayer ) const override;
@@ -103,12 +132,35 @@ protected:
     bool syncTextItem( PNS::NODE* aWorld, PCB_TEXT* aText, PCB_LAYER_ID aLayer );
     bool syncGraphicalItem( PNS::NODE* aWorld, PCB_SHAPE* aItem );
     bool syncZone( PNS::NODE* aWorld, ZONE* aZone, SHAPE_POLY_SET* aBoardOutline );
+    void syncFootprint( PNS::NODE* aWorld, FOOTPRINT* aFootprint, SHAPE_POLY_SET* aBoardOutline,
+                        int& aWorstClearance );
     bool inheritTrackWidth( PNS::ITEM* aItem, int* aInheritedWidth );
 
+    void itemChanged( BOARD_ITEM* aItem );
+    void itemRemoved( BOARD_ITEM* aItem );
+    void invalidateWorld();
+
 protected:
     PNS::NODE* m_world;
     BOARD*     m_board;
     int        m_startLayer;
+
+    struct FOOTPRINT_SYNC
+    {
+        std::vector<const BOARD_ITEM*> m_parents;   ///< Footprint children synced into the world
+        bool                           m_hasEdgeExclusions = false;
+    };
+
+    // Incremental sync state; see StartTrackingChanges()
+    bool                                    m_trackingChanges;
+    bool                                    m_worldValid;  ///< World matches the board apart
+                                                           ///<   from the pending changes
+    bool                                    m_ignoreTrackChanges;
+    int                                     m_syncedMaxClearance;
+    std::unordered_set<BOARD_ITEM*>         m_dirtyItems;   ///< Added or changed items
+    std::unordered_set<const BOARD_ITEM*>   m_removedItems; ///< May already be deleted
+    std::unordered_set<const ZONE*>         m_syncedZones;
+    std::unordered_map<const BOARD_ITEM*, FOOTPRINT_SYNC> m_syncedFootprints;
 };
 
 class PNS_KICAD_IFACE : public PNS_KICAD_IFACE_BASE
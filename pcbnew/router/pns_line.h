@@ -34,6 +34,7 @@
 #include "pns_item.h"
 #include "pns_via.h"
 #include "pns_link_holder.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -60,6 +61,8 @@ class VIA;
 class LINE : public LINK_HOLDER
 {
 public:
+    PNS_POOLED_ITEM( LINE )
+
     /**
      * Makes an empty line.
      */
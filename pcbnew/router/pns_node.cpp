@@ -32,6 +32,8 @@
 
 #include <wx/log.h>
 
+#include <core/thread_pool.h>
+
 #include "pns_arc.h"
 #include "pns_item.h"
 #include "pns_itemset.h"
@@ -52,6 +54,10 @@ namespace PNS {
 static std::unordered_set<const NODE*> allocNodes;
 #endif
 
+///< Number of obstacles above which NearestObstacle() intersects them with the line on
+///< several threads.  Below it, handing the work to the thread pool costs more than it saves.
+static const size_t PARALLEL_NARROW_PHASE_THRESHOLD = 32;
+
 NODE::NODE()
 {
     m_depth = 0;
@@ -307,61 +313,51 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
     if( obstacleList.empty() )
         return OPT_OBSTACLE();
 
-    OBSTACLE nearest;
-    nearest.m_head = nullptr;
-    nearest.m_item = nullptr;
-    nearest.m_distFirst = INT_MAX;
-    nearest.m_maxFanoutWidth = 0;
+    // Narrow phase: intersect the line with the hull of every obstacle and keep the one hit
+    // first along the line.  Clearances are resolved (and cached by the rule resolver) and
+    // hulls are built here, on the calling thread; only the intersection math below may be
+    // spread across threads.
+    struct NARROW_PHASE_ITEM
+    {
+        const OBSTACLE*  m_obstacle;
+        SHAPE_LINE_CHAIN m_hull;
+        SHAPE_LINE_CHAIN m_viaHull;
+    };
 
-    auto updateNearest =
-            [&]( const SHAPE_LINE_CHAIN::INTERSECTION& pt, const OBSTACLE& obstacle )
+    auto makeHull =
+            [&]( const ITEM* aItem, int aClearance, int aLayer )
             {
-                int dist = aLine->CLine().PathLength( pt.p, pt.index_their );
+                SHAPE_LINE_CHAIN hull = aItem->Hull( aClearance, 0, aLayer );
 
-                if( dist < nearest.m_distFirst )
+                if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
                 {
-                    nearest = obstacle;
-                    nearest.m_distFirst = dist;
-                    nearest.m_ipFirst = pt.p;
+                    BOX2I bbox = hull.BBox();
+                    hull.Clear();
+                    hull.Append( bbox.GetLeft(),  bbox.GetTop()    );
+                    hull.Append( bbox.GetRight(), bbox.GetTop()    );
+                    hull.Append( bbox.GetRight(), bbox.GetBottom() );
+                    hull.Append( bbox.GetLeft(),  bbox.GetBottom() );
                 }
+
+                return hull;
             };
 
-    SHAPE_LINE_CHAIN obstacleHull;
-    DEBUG_DECORATOR* debugDecorator = ROUTER::GetInstance()->GetInterface()->GetDebugDecorator();
-    std::vector<SHAPE_LINE_CHAIN::INTERSECTION> intersectingPts;
-    int layer = aLine->Layer();
+    std::vector<NARROW_PHASE_ITEM> candidates;
+    int                            layer = aLine->Layer();
+
+    candidates.reserve( obstacleList.size() );
 
     for( const OBSTACLE& obstacle : obstacleList )
     {
         if( aOpts.m_restrictedSet && !aOpts.m_restrictedSet->empty() && aOpts.m_restrictedSet->count( obstacle.m_item ) == 0 )
             continue;
 
+        NARROW_PHASE_ITEM& candidate = candidates.emplace_back();
         int clearance = GetClearance( obstacle.m_item, aLine, aOpts.m_useClearanceEpsilon )
                             + aLine->Width() / 2;
 
-        obstacleHull = obstacle.m_item->Hull( clearance, 0, layer );
-
-        if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
-        {
-            BOX2I bbox = obstacleHull.BBox();
-            obstacleHull.Clear();
-            obstacleHull.Append( bbox.GetLeft(),  bbox.GetTop()    );
-            obstacleHull.Append( bbox.GetRight(), bbox.GetTop()    );
-            obstacleHull.Append( bbox.GetRight(), bbox.GetBottom() );
-            obstacleHull.Append( bbox.GetLeft(),  bbox.GetBottom() );
-        }
-        //debugDecorator->AddLine( obstacleHull, 2, 40000, "obstacle-hull-test" );
-        //debugDecorator->AddLine( aLine->CLine(), 5, 40000, "obstacle-test-line" );
-
-        intersectingPts.clear();
-        HullIntersection( obstacleHull, aLine->CLine(), intersectingPts );
-
-        for( const auto& ip : intersectingPts )
-        {
-            //debugDecorator->AddPoint( ip.p, ip.valid?3:6, 100000, (const char *) wxString::Format("obstacle-isect-point-%d" ).c_str() );
-            if( ip.valid )
-                updateNearest( ip, obstacle );
-        }
+        candidate.m_obstacle = &obstacle;
+        candidate.m_hull = makeHull( obstacle.m_item, clearance, layer );
 
         if( aLine->EndsWithVia() )
         {
@@ -369,29 +365,88 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
             int viaClearance = GetClearance( obstacle.m_item, &via, aOpts.m_useClearanceEpsilon )
                                + via.Diameter() / 2;
 
-            obstacleHull = obstacle.m_item->Hull( viaClearance, 0, layer );
+            candidate.m_viaHull = makeHull( obstacle.m_item, viaClearance, layer );
+        }
+    }
+
+    struct NEAREST_HIT
+    {
+        int      m_dist = INT_MAX;
+        VECTOR2I m_ip;
+        size_t   m_index = 0;
+    };
 
-            if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
+    // Candidates and intersection points are visited in order and only a strictly closer hit
+    // replaces the current one, so the result doesn't depend on how the work is split
+    auto findNearest =
+            [&]( size_t aStart, size_t aEnd )
             {
-                BOX2I bbox = obstacleHull.BBox();
-                obstacleHull.Clear();
-                obstacleHull.Append( bbox.GetLeft(),  bbox.GetTop()    );
-                obstacleHull.Append( bbox.GetRight(), bbox.GetTop()    );
-                obstacleHull.Append( bbox.GetRight(), bbox.GetBottom() );
-                obstacleHull.Append( bbox.GetLeft(),  bbox.GetBottom() );
-            }
-            //debugDecorator->AddLine( obstacleHull, 3 );
+                NEAREST_HIT                                 nearest;
+                std::vector<SHAPE_LINE_CHAIN::INTERSECTION> intersectingPts;
+
+                auto updateNearest =
+                        [&]( const SHAPE_LINE_CHAIN::INTERSECTION& pt, size_t aIndex )
+                        {
+                            int dist = aLine->CLine().PathLength( pt.p, pt.index_their );
+
+                            if( dist < nearest.m_dist )
+                            {
+                                nearest.m_dist = dist;
+                                nearest.m_ip = pt.p;
+                                nearest.m_index = aIndex;
+                            }
+                        };
+
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    intersectingPts.clear();
+                    HullIntersection( candidates[ii].m_hull, aLine->CLine(), intersectingPts );
 
-            intersectingPts.clear();
-            HullIntersection( obstacleHull, aLine->CLine(), intersectingPts );
+                    for( const SHAPE_LINE_CHAIN::INTERSECTION& ip : intersectingPts )
+                    {
+                        if( ip.valid )
+                            updateNearest( ip, ii );
+                    }
 
-            for( const SHAPE_LINE_CHAIN::INTERSECTION& ip : intersectingPts )
-                updateNearest( ip, obstacle );
+                    if( aLine->EndsWithVia() )
+                    {
+                        intersectingPts.clear();
+                        HullIntersection( candidates[ii].m_viaHull, aLine->CLine(),
+                                          intersectingPts );
+
+                        for( const SHAPE_LINE_CHAIN::INTERSECTION& ip : intersectingPts )
+                            updateNearest( ip, ii );
+                    }
+                }
+
+                return nearest;
+            };
+
+    NEAREST_HIT nearestHit;
+
+    if( candidates.size() >= PARALLEL_NARROW_PHASE_THRESHOLD )
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+        auto         results = tp.parallelize_loop( 0, candidates.size(), findNearest );
+
+        for( const NEAREST_HIT& hit : results.get() )
+        {
+            if( hit.m_dist < nearestHit.m_dist )
+                nearestHit = hit;
         }
     }
+    else
+    {
+        nearestHit = findNearest( 0, candidates.size() );
+    }
+
+    if( nearestHit.m_dist == INT_MAX )
+        return *obstacleList.begin();
+
+    OBSTACLE nearest = *candidates[nearestHit.m_index].m_obstacle;
 
-    if( nearest.m_distFirst == INT_MAX )
-        nearest = (*obstacleList.begin());
+    nearest.m_distFirst = nearestHit.m_dist;
+    nearest.m_ipFirst = nearestHit.m_ip;
 
     return nearest;
 }
@@ -720,16 +775,25 @@ bool NODE::QueryEdgeExclusions( const VECTOR2I& aPos ) const
 }
 
 
+void NODE::addOverride( ITEM* aItem )
+{
+    auto it = std::lower_bound( m_override.begin(), m_override.end(), aItem );
+
+    if( it == m_override.end() || *it != aItem )
+        m_override.insert( it, aItem );
+}
+
+
 void NODE::doRemove( ITEM* aItem )
 {
     // case 1: removing an item that is stored in the root node from any branch:
     // mark it as overridden, but do not remove
     if( aItem->BelongsTo( m_root ) && !isRoot() )
     {
-        m_override.insert( aItem );
+        addOverride( aItem );
 
         if( aItem->HasHole() )
-            m_override.insert( aItem->Hole() );
+            addOverride( aItem->Hole() );
     }
 
     // case 2: the item belongs to this branch or a parent, non-root branch,
@@ -1454,7 +1518,10 @@ void NODE::releaseGarbage()
     for( ITEM* item : m_garbageItems )
     {
         if( !item->BelongsTo( this ) )
+        {
+            cacheCheckItems.push_back( item );
             delete item;
+        }
     }
 
     m_garbageItems.clear();
@@ -1691,4 +1758,40 @@ std::vector<ITEM*> NODE::FindItemsByZone( const ZONE* aParent )
 
     return ret;
 }
+
+
+std::vector<ITEM*> NODE::FindItemsByParents( const std::unordered_set<const BOARD_ITEM*>& aParents )
+{
+    std::vector<ITEM*> ret;
+
+    if( aParents.empty() )
+        return ret;
+
+    for( ITEM* item : *m_index )
+    {
+        // Holes go away together with the pad or via that owns them
+        if( item->OfKind( ITEM::HOLE_T ) )
+            continue;
+
+        if( aParents.count( item->Parent() ) )
+            ret.push_back( item );
+    }
+
+    return ret;
+}
+
+
+void NODE::RemoveVirtualVias()
+{
+    std::vector<ITEM*> vvias;
+
+    for( ITEM* item : *m_index )
+    {
+        if( item->OfKind( ITEM::VIA_T ) && item->IsVirtual() )
+            vvias.push_back( item );
+    }
+
+    for( ITEM* vvia : vvias )
+        Remove( vvia );
+}
 }
@@ -23,9 +23,11 @@
 #ifndef __PNS_NODE_H
 #define __PNS_NODE_H
 
+#include <algorithm>
 #include <vector>
 #include <list>
 #include <set>
+#include <unordered_set>
 #include <core/minoptmax.h>
 
 #include <geometry/shape_line_chain.h>
@@ -435,6 +437,13 @@ public:
 
     std::vector<ITEM*> FindItemsByZone( const ZONE* aParent );
 
+    ///< Find all items (holes excepted) whose parent is one of \a aParents.  The parents are
+    ///< only compared, never dereferenced, so they may already have been deleted.
+    std::vector<ITEM*> FindItemsByParents( const std::unordered_set<const BOARD_ITEM*>& aParents );
+
+    ///< Remove the virtual vias added by FixupVirtualVias().
+    void RemoveVirtualVias();
+
     bool HasChildren() const
     {
         return !m_children.empty();
@@ -448,7 +457,7 @@ public:
     ///< Check if this branch contains an updated version of the m_item from the root branch.
     bool Overrides( ITEM* aItem ) const
     {
-        return m_override.find( aItem ) != m_override.end();
+        return std::binary_search( m_override.begin(), m_override.end(), aItem );
     }
 
     void FixupVirtualVias();
@@ -492,6 +501,7 @@ private:
     void unlinkParent();
     void releaseChildren();
     void releaseGarbage();
+    void addOverride( ITEM* aItem );
     void rebuildJoint( const JOINT* aJoint, const ITEM* aItem );
 
     bool isRoot() const
@@ -524,8 +534,9 @@ private:
     NODE*           m_root;             ///< root node of the whole hierarchy
     std::set<NODE*> m_children;         ///< list of nodes branched from this one
 
-    std::unordered_set<ITEM*> m_override;   ///< hash of root's items that have been changed
-                                            ///< in this node
+    ///< Root's items that have been changed in this node, sorted by address.  A flat table is
+    ///< cheaper than a hash set both to search and to copy into each new branch.
+    std::vector<ITEM*> m_override;
 
     int             m_maxClearance;     ///< worst case item-item clearance
     RULE_RESOLVER*  m_ruleResolver;     ///< Design rules resolver
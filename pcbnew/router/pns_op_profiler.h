@@ -0,0 +1,132 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_OP_PROFILER_H
+#define __PNS_OP_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace PNS {
+
+/**
+ * Collects the latency of the router's expensive operations.
+ *
+ * Nothing is recorded unless a profiler has been installed with SetActive(), so the
+ * instrumentation costs a single pointer test in normal use.  Intended for the qa tools
+ * (benchmarks and batch routing), not for the interactive router.
+ */
+class OP_PROFILER
+{
+public:
+    enum OPERATION
+    {
+        SHOVE_LINES = 0,    ///< SHOVE::ShoveLines()
+        WALKAROUND_ROUTE,   ///< WALKAROUND::Route()
+        OPTIMIZE,           ///< OPTIMIZER::Optimize()
+        OP_COUNT
+    };
+
+    static const char* OperationName( OPERATION aOp )
+    {
+        switch( aOp )
+        {
+        case SHOVE_LINES:      return "SHOVE::ShoveLines";
+        case WALKAROUND_ROUTE: return "WALKAROUND::Route";
+        case OPTIMIZE:         return "OPTIMIZER::Optimize";
+        default:               return "?";
+        }
+    }
+
+    static OP_PROFILER* GetActive() { return s_active; }
+
+    /**
+     * Start collecting samples into \a aProfiler, or stop collecting if it is nullptr.
+     */
+    static void SetActive( OP_PROFILER* aProfiler ) { s_active = aProfiler; }
+
+    void Record( OPERATION aOp, double aUsecs )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_samples[aOp].push_back( aUsecs );
+    }
+
+    /**
+     * @return a copy of the samples recorded so far for \a aOp.
+     */
+    std::vector<double> Samples( OPERATION aOp ) const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_samples[aOp];
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        for( std::vector<double>& samples : m_samples )
+            samples.clear();
+    }
+
+private:
+    static inline std::atomic<OP_PROFILER*> s_active = nullptr;
+
+    ///< Timed operations may run on thread pool workers, so samples are guarded
+    mutable std::mutex                        m_mutex;
+    std::array<std::vector<double>, OP_COUNT> m_samples;
+};
+
+
+/**
+ * Time the enclosing scope and record it with the active OP_PROFILER, if any.
+ */
+class OP_TIMER
+{
+public:
+    OP_TIMER( OP_PROFILER::OPERATION aOp ) :
+            m_profiler( OP_PROFILER::GetActive() ),
+            m_op( aOp )
+    {
+        if( m_profiler )
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~OP_TIMER()
+    {
+        if( m_profiler )
+        {
+            std::chrono::duration<double, std::micro> elapsed =
+                    std::chrono::steady_clock::now() - m_start;
+
+            m_profiler->Record( m_op, elapsed.count() );
+        }
+    }
+
+private:
+    OP_PROFILER*                          m_profiler;
+    OP_PROFILER::OPERATION                m_op;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}
+
+#endif
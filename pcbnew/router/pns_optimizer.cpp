@@ -31,6 +31,7 @@
 #include "pns_node.h"
 #include "pns_solid.h"
 #include "pns_optimizer.h"
+#include "pns_op_profiler.h"
 
 #include "pns_utils.h"
 #include "pns_router.h"
@@ -602,6 +603,7 @@ bool OPTIMIZER::mergeColinear( LINE* aLine )
 
 bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
 {
+    OP_TIMER timer( OP_PROFILER::OPTIMIZE );
     DEBUG_DECORATOR* dbg = ROUTER::GetInstance()->GetInterface()->GetDebugDecorator();
 
     if( aRoot )
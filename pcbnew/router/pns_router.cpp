@@ -95,6 +95,20 @@ ROUTER::~ROUTER()
 
 void ROUTER::SyncWorld()
 {
+    if( m_world )
+    {
+        m_world->KillChildren();
+        m_placer.reset();
+
+        if( m_iface->UpdateWorld( m_world.get() ) )
+        {
+            // Virtual vias depend on the joints around them, so recompute them all
+            m_world->RemoveVirtualVias();
+            m_world->FixupVirtualVias();
+            return;
+        }
+    }
+
     ClearWorld();
 
     m_world = std::make_unique<NODE>( );
@@ -184,6 +198,7 @@ bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM_SET aStartItems, int aDragM
     if( aStartItems.Empty() )
         return false;
 
+    // The world may outlive many drags; rules could have been edited since the last one
     GetRuleResolver()->ClearCaches();
 
     if( aStartItems.Count( ITEM::SOLID_T ) == aStartItems.Size() )
@@ -415,6 +430,7 @@ bool ROUTER::isStartingPointRoutable( const VECTOR2I& aWhere, ITEM* aStartItem,
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    // The world may outlive many routes; rules could have been edited since the last one
     GetRuleResolver()->ClearCaches();
 
     if( !isStartingPointRoutable( aP, aStartItem, aLayer ) )
@@ -90,6 +90,15 @@ enum DRAG_MODE
     virtual ~ROUTER_IFACE() {};
 
     virtual void SyncWorld( NODE* aNode ) = 0;
+
+    /**
+     * Apply the board changes made since the last sync to \a aNode.
+     *
+     * @return false if the changes can't be applied incrementally, in which case the world
+     *         must be rebuilt with SyncWorld().
+     */
+    virtual bool UpdateWorld( NODE* aNode ) { return false; }
+
     virtual void AddItem( ITEM* aItem ) = 0;
     virtual void UpdateItem( ITEM* aItem ) = 0;
     virtual void RemoveItem( ITEM* aItem ) = 0;
@@ -30,6 +30,7 @@
 
 #include "pns_line.h"
 #include "pns_linked_item.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -38,6 +39,8 @@ class NODE;
 class SEGMENT : public LINKED_ITEM
 {
 public:
+    PNS_POOLED_ITEM( SEGMENT )
+
     SEGMENT() :
         LINKED_ITEM( SEGMENT_T )
     {}
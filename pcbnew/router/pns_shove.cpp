@@ -31,6 +31,7 @@
 #include "pns_debug_decorator.h"
 #include "pns_walkaround.h"
 #include "pns_shove.h"
+#include "pns_op_profiler.h"
 #include "pns_solid.h"
 #include "pns_optimizer.h"
 #include "pns_via.h"
@@ -1550,6 +1551,7 @@ OPT_BOX2I SHOVE::totalAffectedArea() const
 
 SHOVE::SHOVE_STATUS SHOVE::ShoveLines( const LINE& aCurrentHead )
 {
+    OP_TIMER timer( OP_PROFILER::SHOVE_LINES );
     SHOVE_STATUS st = SH_OK;
 
     m_multiLineMode = false;
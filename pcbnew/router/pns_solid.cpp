@@ -37,6 +37,20 @@ namespace PNS {
 
 
 const SHAPE_LINE_CHAIN SOLID::Hull( int aClearance, int aWalkaroundThickness, int aLayer ) const
+{
+    if( !m_shape )
+        return SHAPE_LINE_CHAIN();
+
+    // The hull doesn't depend on the layer, so don't cache it once per layer
+    return m_hullCache.Get( aClearance, aWalkaroundThickness, -1,
+                            [&]()
+                            {
+                                return buildHull( aClearance, aWalkaroundThickness );
+                            } );
+}
+
+
+const SHAPE_LINE_CHAIN SOLID::buildHull( int aClearance, int aWalkaroundThickness ) const
 {
     if( !m_shape )
         return SHAPE_LINE_CHAIN();
@@ -85,6 +99,8 @@ void SOLID::SetPos( const VECTOR2I& aCenter )
     if( m_shape )
         m_shape->Move( delta );
 
+    m_hullCache.Clear();
+
     if( m_hole )
         m_hole->Move( delta );
 
@@ -29,6 +29,7 @@
 #include <geometry/shape_line_chain.h>
 
 #include "pns_item.h"
+#include "pns_hull_cache.h"
 
 namespace PNS {
 
@@ -99,6 +100,7 @@ public:
     {
         delete m_shape;
         m_shape = shape;
+        m_hullCache.Clear();
     }
 
     const VECTOR2I& Pos() const { return m_pos; }
@@ -136,6 +138,8 @@ public:
     virtual HOLE *Hole() const override { return m_hole; }
 
 private:
+    const SHAPE_LINE_CHAIN buildHull( int aClearance, int aWalkaroundThickness ) const;
+
     VECTOR2I    m_pos;
     SHAPE*      m_shape;
     VECTOR2I    m_offset;
@@ -143,6 +147,8 @@ private:
     EDA_ANGLE   m_orientation;
     HOLE*       m_hole;
     std::vector<VECTOR2I> m_anchorPoints;
+
+    mutable HULL_CACHE    m_hullCache;
 };
 
 }
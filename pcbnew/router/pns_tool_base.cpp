@@ -70,18 +70,30 @@ TOOL_BASE::~TOOL_BASE()
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
     delete m_gridHelper;
-    delete m_router;
-    delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
 
-    m_iface = new PNS_KICAD_IFACE;
-    m_iface->SetBoard( board() );
-    m_iface->SetView( getView() );
-    m_iface->SetHostTool( this );
-
-    m_router = new ROUTER;
-    m_router->SetInterface( m_iface );
-    m_router->ClearWorld();
-    m_router->SyncWorld();
+    // An iface only keeps tracking changes until the next model reload (see
+    // ROUTER_TOOL::Reset()), so one which still is must be following our current board
+    if( m_iface && m_iface->IsTrackingChanges() )
+    {
+        // The world has been following the board's commits; just bring it up to date
+        m_router->SyncWorld();
+    }
+    else
+    {
+        delete m_router;
+        delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
+
+        m_iface = new PNS_KICAD_IFACE;
+        m_iface->SetBoard( board() );
+        m_iface->SetView( getView() );
+        m_iface->SetHostTool( this );
+        m_iface->StartTrackingChanges();
+
+        m_router = new ROUTER;
+        m_router->SetInterface( m_iface );
+        m_router->ClearWorld();
+        m_router->SyncWorld();
+    }
 
     m_router->UpdateSizes( m_savedSizes );
 
@@ -137,16 +137,24 @@ bool VIA::PushoutForce( NODE* aNode, const VECTOR2I& aDirection, VECTOR2I& aForc
 
 const SHAPE_LINE_CHAIN VIA::Hull( int aClearance, int aWalkaroundThickness, int aLayer ) const
 {
-    int cl = ( aClearance + aWalkaroundThickness / 2 );
     int width = m_diameter;
 
+    // Whether the via is flashed can change without the via itself changing (e.g. when the
+    // tracks connecting to it move), so this must be asked every time rather than cached
     if( m_hole && !ROUTER::GetInstance()->GetInterface()->IsFlashedOnLayer( this, aLayer ) )
         width = m_hole->Radius() * 2;
 
-    // Chamfer = width * ( 1 - sqrt(2)/2 ) for equilateral octagon
-    return OctagonalHull( m_pos - VECTOR2I( width / 2, width / 2 ),
-                          VECTOR2I( width, width ),
-                          cl, ( 2 * cl + width ) * ( 1.0 - M_SQRT1_2 ) );
+    // The hull only depends on the layer through the width
+    return m_hullCache.Get( aClearance, aWalkaroundThickness, width,
+            [&]()
+            {
+                int cl = ( aClearance + aWalkaroundThickness / 2 );
+
+                // Chamfer = width * ( 1 - sqrt(2)/2 ) for equilateral octagon
+                return OctagonalHull( m_pos - VECTOR2I( width / 2, width / 2 ),
+                                      VECTOR2I( width, width ),
+                                      cl, ( 2 * cl + width ) * ( 1.0 - M_SQRT1_2 ) );
+            } );
 }
 
 
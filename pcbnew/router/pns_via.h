@@ -31,6 +31,8 @@
 #include "pns_item.h"
 #include "pns_linked_item.h"
 #include "pns_hole.h"
+#include "pns_hull_cache.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -50,6 +52,8 @@ struct VIA_HANDLE
 class VIA : public LINKED_ITEM
 {
 public:
+    PNS_POOLED_ITEM( VIA )
+
     VIA() :
         LINKED_ITEM( VIA_T ),
         m_hole( nullptr )
@@ -134,6 +138,8 @@ public:
 
         if( m_hole )
             m_hole->SetCenter( aPos );
+
+        m_hullCache.Clear();
     }
 
     VIATYPE ViaType() const { return m_viaType; }
@@ -145,6 +151,7 @@ public:
     {
         m_diameter = aDiameter;
         m_shape.SetRadius( m_diameter / 2 );
+        m_hullCache.Clear();
     }
 
     int Drill() const { return m_drill; }
@@ -155,6 +162,8 @@ public:
 
         if( m_hole )
             m_hole->SetRadius( m_drill / 2 );
+
+        m_hullCache.Clear();
     }
 
     bool IsFree() const { return m_isFree; }
@@ -196,6 +205,7 @@ public:
         m_hole->SetOwner( this );
         m_hole->SetLayers( m_layers ); // fixme: backdrill vias can have hole layer set different
                                        // than copper layer set
+        m_hullCache.Clear();
     }
 
     virtual bool HasHole() const override { return true; }
@@ -211,6 +221,10 @@ private:
     VIATYPE      m_viaType;
     bool         m_isFree;
     HOLE*        m_hole;
+
+    ///< Hulls keyed by the copper width they were built for; the flashed state is looked up
+    ///< on every call since it follows the board's connectivity, not the via.
+    mutable HULL_CACHE m_hullCache;
 };
 
 
@@ -24,6 +24,7 @@
 #include <geometry/shape_line_chain.h>
 
 #include "pns_walkaround.h"
+#include "pns_op_profiler.h"
 #include "pns_optimizer.h"
 #include "pns_router.h"
 #include "pns_debug_decorator.h"
@@ -147,6 +148,7 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath, bool aWinding
 
 const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 {
+    OP_TIMER timer( OP_PROFILER::WALKAROUND_ROUTE );
     LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
     WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
     SHAPE_LINE_CHAIN best_path;
@@ -268,6 +270,7 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath, LINE& aWalkPath,
                                                  bool aOptimize )
 {
+    OP_TIMER timer( OP_PROFILER::WALKAROUND_ROUTE );
     LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
     WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
     SHAPE_LINE_CHAIN best_path;
@@ -571,7 +571,17 @@ void ROUTER_TOOL::Reset( RESET_REASON aReason )
     m_lastTargetLayer = UNDEFINED_LAYER;
 
     if( aReason == RUN )
+    {
         TOOL_BASE::Reset( aReason );
+    }
+    else if( m_iface && ( aReason == MODEL_RELOAD || aReason == SUPERMODEL_RELOAD ) )
+    {
+        // The board may be about to be replaced, or may have changed in ways the resident
+        // world can't follow (rules, layers, ...).  Either way, detach from it now and build
+        // a new world on the next run.  Frames reset their tools before dropping a board, so
+        // the one we are tracking is still alive here.
+        m_iface->StopTrackingChanges();
+    }
 }
 
 // Saves the complete event log and the dump of the PCB, allowing us to
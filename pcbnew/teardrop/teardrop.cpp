@@ -33,11 +33,12 @@
 
 #include <connectivity/connectivity_data.h>
 #include <teardrop/teardrop.h>
-#include <drc/drc_rtree.h>
 #include <geometry/shape_line_chain.h>
-#include <geometry/rtree.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <bezier_curves.h>
+#include <core/thread_pool.h>
+
+#include <unordered_set>
 
 #include <wx/log.h>
 
@@ -103,12 +104,30 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
     std::vector<ZONE*>                 stale_teardrops;
 
+    std::unordered_set<const BOARD_ITEM*> dirtyItems( dirtyPadsAndVias->begin(),
+                                                      dirtyPadsAndVias->end() );
+
     for( ZONE* zone : m_board->Zones() )
     {
-        if( zone->IsTeardropArea() )
-        {
-            bool stale = false;
+        if( !zone->IsTeardropArea() )
+            continue;
 
+        bool stale = false;
+
+        if( zone->GetTeardropAreaType() == TEARDROP_TYPE::TD_TRACKEND )
+        {
+            // Track to track teardrops are only anchored on tracks
+            for( PCB_TRACK* track : connectivity->GetConnectedTracks( zone ) )
+            {
+                if( dirtyTracks->count( track ) )
+                {
+                    stale = true;
+                    break;
+                }
+            }
+        }
+        else
+        {
             std::vector<PAD*>     connectedPads;
             std::vector<PCB_VIA*> connectedVias;
 
@@ -116,7 +135,7 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
 
             for( PAD* pad : connectedPads )
             {
-                if( alg::contains( *dirtyPadsAndVias, pad ) )
+                if( dirtyItems.count( pad ) )
                 {
                     stale = true;
                     break;
@@ -127,17 +146,17 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
             {
                 for( PCB_VIA* via : connectedVias )
                 {
-                    if( alg::contains( *dirtyPadsAndVias, via ) )
+                    if( dirtyItems.count( via ) )
                     {
                         stale = true;
                         break;
                     }
                 }
             }
-
-            if( stale )
-                stale_teardrops.push_back( zone );
         }
+
+        if( stale )
+            stale_teardrops.push_back( zone );
     }
 
     for( ZONE* td : stale_teardrops )
@@ -180,22 +199,52 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
     }
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    std::unordered_set<const BOARD_ITEM*> dirtyItems;
+    std::unordered_set<PCB_TRACK*>        candidates;
+
+    if( !aForceFullUpdate )
+    {
+        // Only the dirty tracks and the tracks ending inside a dirty pad or via can get a new
+        // teardrop; there is no need to look at the other ones
+        dirtyItems.insert( dirtyPadsAndVias->begin(), dirtyPadsAndVias->end() );
+        candidates.insert( dirtyTracks->begin(), dirtyTracks->end() );
+
+        for( BOARD_ITEM* item : *dirtyPadsAndVias )
+        {
+            BOX2I area = item->GetBoundingBox();
+            area.Inflate( m_tolerance );
+
+            m_trackEndpoints.Query( area,
+                    [&]( PCB_TRACK* track ) -> bool
+                    {
+                        if( item->IsOnLayer( track->GetLayer() ) )
+                            candidates.insert( track );
+
+                        return true;
+                    } );
+        }
+    }
+
+    std::vector<TEARDROP_ANCHOR> anchors;
 
     for( PCB_TRACK* track : m_board->Tracks() )
     {
         if( ! ( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T ) )
             continue;
 
+        if( !aForceFullUpdate && !candidates.count( track ) )
+            continue;
+
         std::vector<PAD*>     connectedPads;
         std::vector<PCB_VIA*> connectedVias;
 
         connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
 
-        bool forceUpdate = aForceFullUpdate || alg::contains( *dirtyTracks, track );
+        bool forceUpdate = aForceFullUpdate || dirtyTracks->count( track );
 
         for( PAD* pad : connectedPads )
         {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, pad ) )
+            if( !forceUpdate && !dirtyItems.count( pad ) )
                 continue;
 
             if( pad->GetShape() == PAD_SHAPE::CUSTOM )
@@ -226,25 +275,16 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
             if( !tdParams.m_TdOnPadsInZones && areItemsInSameZone( pad, track ) )
                 continue;
 
-            std::vector<VECTOR2I> points;
-
-            if( computeTeardropPolygon( tdParams, points, track, pad, pad->GetPosition() ) )
-            {
-                ZONE* new_teardrop = createTeardrop( TD_TYPE_PADVIA, points, track );
-                m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                m_createdTdList.push_back( new_teardrop );
-
-                aCommit.Added( new_teardrop );
-            }
+            anchors.push_back( { TD_TYPE_PADVIA, &tdParams, track, pad, pad->GetPosition() } );
         }
 
         for( PCB_VIA* via : connectedVias )
         {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, via ) )
+            if( !forceUpdate && !dirtyItems.count( via ) )
                 continue;
 
-            TEARDROP_PARAMETERS tdParams = via->GetTeardropParams();
-            int                 annularWidth = via->GetWidth();
+            TEARDROP_PARAMETERS& tdParams = via->GetTeardropParams();
+            int                  annularWidth = via->GetWidth();
 
             if( !tdParams.m_Enabled )
                 continue;
@@ -262,19 +302,12 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
                 // The track is entirely inside the via; cannot create a teardrop
                 continue;
 
-            std::vector<VECTOR2I> points;
-
-            if( computeTeardropPolygon( tdParams, points, track, via, via->GetPosition() ) )
-            {
-                ZONE* new_teardrop = createTeardrop( TD_TYPE_PADVIA, points, track );
-                m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                m_createdTdList.push_back( new_teardrop );
-
-                aCommit.Added( new_teardrop );
-            }
+            anchors.push_back( { TD_TYPE_PADVIA, &tdParams, track, via, via->GetPosition() } );
         }
     }
 
+    buildTeardrops( aCommit, anchors );
+
     if( ( aForceFullUpdate || !dirtyTracks->empty() )
         && m_prmsList->GetParameters( TARGET_TRACK )->m_Enabled )
     {
@@ -286,6 +319,47 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
 }
 
 
+void TEARDROP_MANAGER::buildTeardrops( BOARD_COMMIT& aCommit,
+                                       const std::vector<TEARDROP_ANCHOR>& aAnchors )
+{
+    std::vector<std::vector<VECTOR2I>> shapes( aAnchors.size() );
+    std::vector<char>                  built( aAnchors.size(), 0 );   // not vector<bool>: each
+                                                                      // thread writes its own
+
+    auto computeShapes =
+            [&]( size_t aFirst, size_t aLast )
+            {
+                for( size_t ii = aFirst; ii < aLast; ++ii )
+                {
+                    const TEARDROP_ANCHOR& anchor = aAnchors[ii];
+
+                    built[ii] = computeTeardropPolygon( *anchor.m_Params, shapes[ii], anchor.m_Track,
+                                                        anchor.m_Other, anchor.m_OtherPos );
+                }
+            };
+
+    // Moving a single via or track is not worth a trip through the thread pool
+    if( aAnchors.size() < 16 )
+        computeShapes( 0, aAnchors.size() );
+    else
+        GetKiCadThreadPool().parallelize_loop( 0, aAnchors.size(), computeShapes ).wait();
+
+    // Creating the zones and adding them to the board and commit is not thread-safe
+    for( size_t ii = 0; ii < aAnchors.size(); ++ii )
+    {
+        if( !built[ii] )
+            continue;
+
+        ZONE* new_teardrop = createTeardrop( aAnchors[ii].m_Variant, shapes[ii],
+                                             aAnchors[ii].m_Track );
+        m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
+        m_createdTdList.push_back( new_teardrop );
+
+        aCommit.Added( new_teardrop );
+    }
+}
+
+
 void TEARDROP_MANAGER::DeleteTrackToTrackTeardrops( BOARD_COMMIT& aCommit )
 {
     std::vector<ZONE*> stale_teardrops;
@@ -351,111 +425,145 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
     TEARDROP_PARAMETERS                params = *m_prmsList->GetParameters( TARGET_TRACK );
 
-    // Explore groups (a group is a set of tracks on the same layer and the same net):
-    for( auto& grp : m_trackLookupList.GetBuffer() )
-    {
-        int layer, netcode;
-        TRACK_BUFFER::GetNetcodeAndLayerFromIndex( grp.first, &layer, &netcode );
-
-        std::vector<PCB_TRACK*>* sublist = grp.second;
+    // to avoid creating a teardrop between 2 tracks having similar widths give a threshold
+    params.m_WidthtoSizeFilterRatio = std::max( params.m_WidthtoSizeFilterRatio, 0.1 );
+    const double th = 1.0 / params.m_WidthtoSizeFilterRatio;
 
-        if( sublist->size() <= 1 )  // We need at least 2 track segments
-            continue;
+    // For a partial update, explore only the given tracks and the tracks connected to their
+    // ends: RemoveTeardrops() has removed the teardrops touching the given tracks, and those
+    // are the only ones to rebuild.  Teardrops which are still there must not be duplicated.
+    std::unordered_set<PCB_TRACK*> explored;
+    std::vector<ZONE*>             existingTeardrops;
 
-        // The sort function to sort by increasing track widths
-        struct
+    if( !aForceFullUpdate )
+    {
+        for( PCB_TRACK* track : *aTracks )
         {
-            bool operator()(PCB_TRACK* a, PCB_TRACK* b) const
-                { return a->GetWidth() < b->GetWidth(); }
-        } compareLess;
+            explored.insert( track );
 
-        std::sort( sublist->begin(), sublist->end(), compareLess );
-        int min_width = sublist->front()->GetWidth();
-        int max_width = sublist->back()->GetWidth();
-
-        // Skip groups having the same track thickness
-        if( max_width == min_width )
-            continue;
+            for( const VECTOR2I& pt : { track->GetStart(), track->GetEnd() } )
+            {
+                m_trackEndpoints.QueryEndpoint( pt, track->GetLayer(), m_tolerance,
+                        [&]( PCB_TRACK* connected ) -> bool
+                        {
+                            explored.insert( connected );
+                            return true;
+                        } );
+            }
+        }
 
-        for( unsigned ii = 0; ii < sublist->size()-1; ii++ )
+        for( ZONE* zone : m_board->Zones() )
         {
-            PCB_TRACK* track = (*sublist)[ii];
-            int        track_len = (int) track->GetLength();
-            bool       track_needs_update = aForceFullUpdate || alg::contains( *aTracks, track );
-            min_width = track->GetWidth();
-
-            // to avoid creating a teardrop between 2 tracks having similar widths give a threshold
-            params.m_WidthtoSizeFilterRatio = std::max( params.m_WidthtoSizeFilterRatio, 0.1 );
-            const double th = 1.0 / params.m_WidthtoSizeFilterRatio;
-            min_width = KiROUND( min_width * th );
+            if( zone->IsTeardropArea()
+                    && zone->GetTeardropAreaType() == TEARDROP_TYPE::TD_TRACKEND )
+            {
+                existingTeardrops.push_back( zone );
+            }
+        }
+    }
 
-            for( unsigned jj = ii+1; jj < sublist->size(); jj++ )
+    auto hasTeardrop =
+            [&]( PCB_TRACK* aTrack, const VECTOR2I& aPos ) -> bool
             {
-                // Search candidates with thickness > curr thickness
-                PCB_TRACK* candidate = (*sublist)[jj];
+                for( ZONE* td : existingTeardrops )
+                {
+                    if( td->GetLayer() == aTrack->GetLayer()
+                            && td->GetNetCode() == aTrack->GetNetCode()
+                            && td->Outline()->Contains( aPos ) )
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            };
 
-                if( min_width >= candidate->GetWidth() )
-                    continue;
+    std::vector<TEARDROP_ANCHOR> anchors;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( ! ( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T ) )
+            continue;
 
-                // Cannot build a teardrop on a too short track segment.
-                // The min len is > candidate radius
-                if( track_len <= candidate->GetWidth() /2 )
-                    continue;
+        if( !aForceFullUpdate && !explored.count( track ) )
+            continue;
 
-                // Now test end to end connection:
-                EDA_ITEM_FLAGS match_points;    // to return the end point EDA_ITEM_FLAGS:
-                                                // 0, STARTPOINT, ENDPOINT
+        int track_len = (int) track->GetLength();
+        int min_width = KiROUND( track->GetWidth() * th );
 
-                VECTOR2I pos = candidate->GetStart();
-                match_points = track->IsPointOnEnds( pos, m_tolerance );
+        std::vector<PCB_TRACK*> candidates;
 
-                if( !match_points )
-                {
-                    pos = candidate->GetEnd();
-                    match_points = track->IsPointOnEnds( pos, m_tolerance );
-                }
+        // Search candidates with thickness > curr thickness, connected by their end to one
+        // end of the track
+        for( const VECTOR2I& pt : { track->GetStart(), track->GetEnd() } )
+        {
+            m_trackEndpoints.QueryEndpoint( pt, track->GetLayer(), m_tolerance,
+                    [&]( PCB_TRACK* candidate ) -> bool
+                    {
+                        if( candidate != track
+                                && candidate->GetNetCode() == track->GetNetCode()
+                                && candidate->GetWidth() > track->GetWidth()
+                                && candidate->GetWidth() > min_width
+                                && !alg::contains( candidates, candidate ) )
+                        {
+                            candidates.push_back( candidate );
+                        }
+
+                        return true;
+                    } );
+        }
 
-                if( !match_points )
-                    continue;
+        for( PCB_TRACK* candidate : candidates )
+        {
+            // Cannot build a teardrop on a too short track segment.
+            // The min len is > candidate radius
+            if( track_len <= candidate->GetWidth() /2 )
+                continue;
 
-                if( !track_needs_update && alg::contains( *aTracks, candidate ) )
-                    continue;
+            // Now test end to end connection:
+            EDA_ITEM_FLAGS match_points;    // to return the end point EDA_ITEM_FLAGS:
+                                            // 0, STARTPOINT, ENDPOINT
 
-                // Pads/vias have priority for teardrops; ensure there isn't one at our position
-                bool                  existingPadOrVia = false;
-                std::vector<PAD*>     connectedPads;
-                std::vector<PCB_VIA*> connectedVias;
+            VECTOR2I pos = candidate->GetStart();
+            match_points = track->IsPointOnEnds( pos, m_tolerance );
 
-                connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
+            if( !match_points )
+            {
+                pos = candidate->GetEnd();
+                match_points = track->IsPointOnEnds( pos, m_tolerance );
+            }
 
-                for( PAD* pad : connectedPads )
-                {
-                    if( pad->HitTest( pos ) )
-                        existingPadOrVia = true;
-                }
+            if( !match_points )
+                continue;
 
-                for( PCB_VIA* via : connectedVias )
-                {
-                    if( via->HitTest( pos ) )
-                        existingPadOrVia = true;
-                }
+            if( !aForceFullUpdate && hasTeardrop( track, pos ) )
+                continue;
 
-                if( existingPadOrVia )
-                    continue;
+            // Pads/vias have priority for teardrops; ensure there isn't one at our position
+            bool                  existingPadOrVia = false;
+            std::vector<PAD*>     connectedPads;
+            std::vector<PCB_VIA*> connectedVias;
 
-                std::vector<VECTOR2I> points;
+            connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
 
-                if( computeTeardropPolygon( params, points, track, candidate, pos ) )
-                {
-                    ZONE* new_teardrop = createTeardrop( TD_TYPE_TRACKEND, points, track );
-                    m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                    m_createdTdList.push_back( new_teardrop );
+            for( PAD* pad : connectedPads )
+            {
+                if( pad->HitTest( pos ) )
+                    existingPadOrVia = true;
+            }
 
-                    aCommit.Added( new_teardrop );
-                }
+            for( PCB_VIA* via : connectedVias )
+            {
+                if( via->HitTest( pos ) )
+                    existingPadOrVia = true;
             }
+
+            if( existingPadOrVia )
+                continue;
+
+            anchors.push_back( { TD_TYPE_TRACKEND, &params, track, candidate, pos } );
         }
     }
-}
-
 
+    buildTeardrops( aCommit, anchors );
+}
@@ -31,51 +31,66 @@
 #include <pad.h>
 #include <pcb_track.h>
 #include <zone.h>
-#include <drc/drc_rtree.h>
+#include <geometry/rtree.h>
 #include "teardrop_parameters.h"
 
 #define MAGIC_TEARDROP_PADVIA_NAME "$teardrop_padvia$"
 #define MAGIC_TEARDROP_TRACK_NAME "$teardrop_track$"
 
-// A class to store tracks grouped by layer and netcode
-class TRACK_BUFFER
+/**
+ * A spatial index of track end points, used to find the tracks connected end to end with
+ * another track or ending inside a pad or via without walking every track of the board.
+ *
+ * Once built the index is read-only, and can be queried from several threads.
+ */
+class TRACK_ENDPOINT_INDEX
 {
 public:
-    TRACK_BUFFER() {}
+    TRACK_ENDPOINT_INDEX() {}
 
     /**
-     * Add a track in buffer, in space grouping tracks having the same netcode and the same layer
+     * Add the start and end points of a track to the index.
      */
-    void AddTrack( PCB_TRACK* aTrack, int aLayer, int aNetcode );
+    void AddTrack( PCB_TRACK* aTrack );
 
     /**
-     * @return the buffer that stores tracks having the same layer and the same netcode
+     * Call \a aVisitor for each track having an end point inside \a aArea.  A track having
+     * both end points inside the area is visited twice.  Layers are not filtered.
+     *
+     * @param aVisitor is a functor taking a PCB_TRACK* and returning false to stop the search.
      */
-    std::vector<PCB_TRACK*>* GetTrackList( int aLayer, int aNetcode ) const
+    template <class VISITOR>
+    void Query( const BOX2I& aArea, VISITOR aVisitor ) const
     {
-        return m_map_tracks.at( idxFromLayNet( aLayer, aNetcode ) );
+        const int min[2] = { aArea.GetLeft(), aArea.GetTop() };
+        const int max[2] = { aArea.GetRight(), aArea.GetBottom() };
+
+        m_tree.Search( min, max, aVisitor );
     }
 
     /**
-     * @return a reference to the internal buffer
+     * Call \a aVisitor for each track on \a aLayer having an end point within \a aTolerance
+     * of \a aPos (in each axis; use PCB_TRACK::IsPointOnEnds() for the exact distance).
      */
-    const std::map< int, std::vector<PCB_TRACK*>* >& GetBuffer() const { return m_map_tracks; }
-
-    static void GetNetcodeAndLayerFromIndex( int aIdx, int* aLayer, int* aNetcode )
+    template <class VISITOR>
+    void QueryEndpoint( const VECTOR2I& aPos, PCB_LAYER_ID aLayer, int aTolerance,
+                        VISITOR aVisitor ) const
     {
-        *aLayer = aIdx & 0xFF;
-        *aNetcode = aIdx >> 8;
-    }
+        BOX2I area( aPos );
+        area.Inflate( aTolerance );
 
-private:
-    // Build an index from the layer id and the netcode, to store a track in buffer
-    int idxFromLayNet( int aLayer, int aNetcode ) const
-    {
-        return ( aNetcode << 8 ) + ( aLayer & 0xFF );
+        Query( area,
+               [&]( PCB_TRACK* aTrack ) -> bool
+               {
+                   if( aTrack->GetLayer() != aLayer )
+                       return true;
+
+                   return aVisitor( aTrack );
+               } );
     }
 
-    // Track buffer, tracks are grouped by layer+netcode
-    std::map< int, std::vector<PCB_TRACK*>* > m_map_tracks;
+private:
+    RTree<PCB_TRACK*, int, 2, double> m_tree;
 };
 
 
@@ -190,7 +205,6 @@ private:
      * @param aMatchType returns the end point id 0, STARTPOINT, ENDPOINT
      * @param aTrackRef is the reference track
      * @param aEndpoint is the coordinate to test
-     * @param tracksRTree is an RTree containing the available tracks
      */
     PCB_TRACK* findTouchingTrack( EDA_ITEM_FLAGS& aMatchType, PCB_TRACK* aTrackRef,
                                   const VECTOR2I& aEndPoint ) const;
@@ -205,6 +219,24 @@ private:
     ZONE* createTeardrop( TEARDROP_VARIANT aTeardropVariant,
                           std::vector<VECTOR2I>& aPoints, PCB_TRACK* aTrack ) const;
 
+    /**
+     * A teardrop to build: the track and the pad, via or wider track it is anchored on
+     */
+    struct TEARDROP_ANCHOR
+    {
+        TEARDROP_VARIANT           m_Variant;
+        const TEARDROP_PARAMETERS* m_Params;
+        PCB_TRACK*                 m_Track;
+        BOARD_ITEM*                m_Other;
+        VECTOR2I                   m_OtherPos;
+    };
+
+    /**
+     * Compute the teardrop shapes of \a aAnchors on the thread pool, then add the teardrops
+     * which could be built to the board and to \a aCommit, in the order of \a aAnchors
+     */
+    void buildTeardrops( BOARD_COMMIT& aCommit, const std::vector<TEARDROP_ANCHOR>& aAnchors );
+
     /**
      * Set priority of created teardrops. smaller have bigger priority
      */
@@ -237,8 +269,7 @@ private:
     TOOL_MANAGER*             m_toolManager;
     TEARDROP_PARAMETERS_LIST* m_prmsList;       // the teardrop parameters list, from the board design settings
 
-    DRC_RTREE                 m_tracksRTree;
-    TRACK_BUFFER              m_trackLookupList;
+    TRACK_ENDPOINT_INDEX      m_trackEndpoints; // end points of all tracks of m_board
     std::vector<ZONE*>        m_createdTdList;  // list of new created teardrops
 };
 
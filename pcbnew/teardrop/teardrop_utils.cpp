@@ -32,7 +32,6 @@
 #include <pad.h>
 #include <zone_filler.h>
 #include <board_commit.h>
-#include <drc/drc_rtree.h>
 
 #include "teardrop.h"
 #include <geometry/convex_hull.h>
@@ -43,22 +42,13 @@
 #include <wx/log.h>
 
 
-void TRACK_BUFFER::AddTrack( PCB_TRACK* aTrack, int aLayer, int aNetcode )
+void TRACK_ENDPOINT_INDEX::AddTrack( PCB_TRACK* aTrack )
 {
-    auto item = m_map_tracks.find( idxFromLayNet( aLayer, aNetcode ) );
-    std::vector<PCB_TRACK*>* buffer;
-
-    if( item == m_map_tracks.end() )
-    {
-        buffer = new std::vector<PCB_TRACK*>;
-        m_map_tracks[idxFromLayNet( aLayer, aNetcode )] = buffer;
-    }
-    else
+    for( const VECTOR2I& pt : { aTrack->GetStart(), aTrack->GetEnd() } )
     {
-        buffer = (*item).second;
+        const int coord[2] = { pt.x, pt.y };
+        m_tree.Insert( coord, coord, aTrack );
     }
-
-    buffer->push_back( aTrack );
 }
 
 
@@ -103,10 +93,7 @@ void TEARDROP_MANAGER::buildTrackCaches()
     for( PCB_TRACK* track : m_board->Tracks() )
     {
         if( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T )
-        {
-            m_tracksRTree.Insert( track, track->GetLayer() );
-            m_trackLookupList.AddTrack( track, track->GetLayer(), track->GetNetCode() );
-        }
+            m_trackEndpoints.AddTrack( track );
     }
 }
 
@@ -154,16 +141,12 @@ PCB_TRACK* TEARDROP_MANAGER::findTouchingTrack( EDA_ITEM_FLAGS& aMatchType, PCB_
     int matches = 0;                    // Count of candidates: only 1 is acceptable
     PCB_TRACK* candidate = nullptr;     // a reference to the track connected
 
-    m_tracksRTree.QueryColliding( aTrackRef, aTrackRef->GetLayer(), aTrackRef->GetLayer(),
-            // Filter:
-            [&]( BOARD_ITEM* trackItem ) -> bool
-            {
-                return trackItem != aTrackRef;
-            },
-            // Visitor
-            [&]( BOARD_ITEM* trackItem ) -> bool
+    m_trackEndpoints.QueryEndpoint( aEndPoint, aTrackRef->GetLayer(), m_tolerance,
+            [&]( PCB_TRACK* curr_track ) -> bool
             {
-                PCB_TRACK* curr_track = static_cast<PCB_TRACK*>( trackItem );
+                // A track having both ends at aEndPoint is visited twice
+                if( curr_track == aTrackRef || curr_track == candidate )
+                    return true;
 
                 // IsPointOnEnds() returns 0, EDA_ITEM_FLAGS::STARTPOINT or EDA_ITEM_FLAGS::ENDPOINT
                 if( EDA_ITEM_FLAGS match = curr_track->IsPointOnEnds( aEndPoint, m_tolerance ) )
@@ -185,8 +168,7 @@ PCB_TRACK* TEARDROP_MANAGER::findTouchingTrack( EDA_ITEM_FLAGS& aMatchType, PCB_
                 }
 
                 return true;
-            },
-            0 );
+            } );
 
     return candidate;
 }
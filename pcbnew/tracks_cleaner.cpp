@@ -31,9 +31,14 @@
 #include <tool/tool_manager.h>
 #include <tools/pcb_actions.h>
 #include <tools/global_edit_tool.h>
-#include <drc/drc_rtree.h>
+#include <core/thread_pool.h>
+#include <hash.h>
 #include <tracks_cleaner.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 TRACKS_CLEANER::TRACKS_CLEANER( BOARD* aPcb, BOARD_COMMIT& aCommit ) :
         m_brd( aPcb ),
         m_commit( aCommit ),
@@ -349,61 +354,146 @@ void TRACKS_CLEANER::deleteTracksInPads()
 }
 
 
+namespace
+{
+
+/**
+ * What makes two vias or two segments the same for the duplicate checks: the position, type
+ * and layers of a via; the end points (in either order), width and layer of a segment.
+ */
+struct TRACK_GEOMETRY_KEY
+{
+    TRACK_GEOMETRY_KEY( const PCB_TRACK* aTrack ) :
+            A( aTrack->GetStart() ),
+            B( aTrack->GetEnd() ),
+            Param( aTrack->GetWidth() ),
+            Layers( aTrack->GetLayerSet() )
+    {
+        if( aTrack->Type() == PCB_VIA_T )
+        {
+            B = A;
+            Param = static_cast<int>( static_cast<const PCB_VIA*>( aTrack )->GetViaType() );
+        }
+        else if( B.x < A.x || ( B.x == A.x && B.y < A.y ) )
+        {
+            std::swap( A, B );
+        }
+    }
+
+    bool operator==( const TRACK_GEOMETRY_KEY& aOther ) const
+    {
+        return A == aOther.A && B == aOther.B && Param == aOther.Param && Layers == aOther.Layers;
+    }
+
+    VECTOR2I A;
+    VECTOR2I B;
+    int      Param;
+    LSET     Layers;
+};
+
+
+struct TRACK_GEOMETRY_KEY_HASH
+{
+    std::size_t operator()( const TRACK_GEOMETRY_KEY& k ) const
+    {
+        std::size_t seed = 0xa82de1c0;
+        hash_combine( seed, k.A.x, k.A.y, k.B.x, k.B.y, k.Param,
+                      static_cast<const BASE_SET&>( k.Layers ) );
+        return seed;
+    }
+};
+
+}
+
+
 /**
  * Geometry-based cleanup: duplicate items, null items, colinear items.
  */
 void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegments,
                               bool aDeleteDuplicateSegments, bool aMergeSegments )
 {
-    DRC_RTREE rtree;
+    using TRACK_GROUPS = std::unordered_map<TRACK_GEOMETRY_KEY, std::vector<PCB_TRACK*>,
+                                            TRACK_GEOMETRY_KEY_HASH>;
+
+    TRACK_GROUPS viaGroups;
+    TRACK_GROUPS segmentGroups;
 
     for( PCB_TRACK* track : m_brd->Tracks() )
     {
         track->ClearFlags( IS_DELETED | SKIP_STRUCT );
-        rtree.Insert( track, track->GetLayer() );
+
+        if( aDeleteDuplicateVias && track->Type() == PCB_VIA_T )
+        {
+            if( !track->IsLocked() && track->GetStart() != track->GetEnd() )
+                track->SetEnd( track->GetStart() );
+
+            viaGroups[ TRACK_GEOMETRY_KEY( track ) ].push_back( track );
+        }
+        else if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T && !track->IsNull() )
+        {
+            segmentGroups[ TRACK_GEOMETRY_KEY( track ) ].push_back( track );
+        }
     }
 
+    // Of a set of identical items the last one (in board order) is kept, or the locked ones if
+    // there are any.  Each duplicate maps to the number of kept or later items it duplicates,
+    // which is how many times it gets reported.
+    std::unordered_map<PCB_TRACK*, int> duplicates;
+
+    auto findDuplicates =
+            [&]( const TRACK_GROUPS& aGroups )
+            {
+                for( const auto& [key, group] : aGroups )
+                {
+                    if( group.size() < 2 )
+                        continue;
+
+                    int lockedCount = std::count_if( group.begin(), group.end(),
+                                                     []( PCB_TRACK* aTrack )
+                                                     {
+                                                         return aTrack->IsLocked();
+                                                     } );
+                    int laterUnlocked = (int) group.size() - lockedCount;
+
+                    for( PCB_TRACK* track : group )
+                    {
+                        if( track->IsLocked() )
+                            continue;
+
+                        laterUnlocked--;
+
+                        if( lockedCount + laterUnlocked > 0 )
+                            duplicates[ track ] = lockedCount + laterUnlocked;
+                    }
+                }
+            };
+
+    findDuplicates( viaGroups );
+    findDuplicates( segmentGroups );
+
     std::set<BOARD_ITEM*> toRemove;
 
     for( PCB_TRACK* track : m_brd->Tracks() )
     {
-        if( track->HasFlag( IS_DELETED ) || track->IsLocked() )
+        if( track->IsLocked() )
             continue;
 
         if( aDeleteDuplicateVias && track->Type() == PCB_VIA_T )
         {
             PCB_VIA* via = static_cast<PCB_VIA*>( track );
 
-            if( via->GetStart() != via->GetEnd() )
-                via->SetEnd( via->GetStart() );
-
-            rtree.QueryColliding( via, via->GetLayer(), via->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_VIA_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED );
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        PCB_VIA* other = static_cast<PCB_VIA*>( aItem );
-
-                        if( via->GetPosition() == other->GetPosition()
-                                && via->GetViaType() == other->GetViaType()
-                                && via->GetLayerSet() == other->GetLayerSet() )
-                        {
-                            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_REDUNDANT_VIA );
-                            item->SetItems( via );
-                            m_itemsList->push_back( item );
-
-                            via->SetFlags( IS_DELETED );
-                            toRemove.insert( via );
-                        }
+            if( duplicates.count( via ) )
+            {
+                for( int ii = 0; ii < duplicates[ via ]; ++ii )
+                {
+                    auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_REDUNDANT_VIA );
+                    item->SetItems( via );
+                    m_itemsList->push_back( item );
+                }
 
-                        return true;
-                    } );
+                via->SetFlags( IS_DELETED );
+                toRemove.insert( via );
+            }
 
             // To delete through Via on THT pads at same location
             // Examine the list of connected pads: if a through pad is found, the via is redundant
@@ -422,8 +512,6 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
                     break;
                 }
             }
-
-            via->SetFlags( SKIP_STRUCT );
         }
 
         if( aDeleteNullSegments && track->Type() != PCB_VIA_T )
@@ -439,119 +527,156 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
             }
         }
 
-        if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T && !track->IsNull() )
+        if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T && duplicates.count( track ) )
         {
-            rtree.QueryColliding( track, track->GetLayer(), track->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_TRACE_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED )
-                                  && !static_cast<PCB_TRACK*>( aItem )->IsNull();
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        PCB_TRACK* other = static_cast<PCB_TRACK*>( aItem );
-
-                        if( track->IsPointOnEnds( other->GetStart() )
-                                && track->IsPointOnEnds( other->GetEnd() )
-                                && track->GetWidth() == other->GetWidth()
-                                && track->GetLayer() == other->GetLayer() )
-                        {
-                            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DUPLICATE_TRACK );
-                            item->SetItems( track );
-                            m_itemsList->push_back( item );
-
-                            track->SetFlags( IS_DELETED );
-                            toRemove.insert( track );
-                        }
-
-                        return true;
-                    } );
+            for( int ii = 0; ii < duplicates[ track ]; ++ii )
+            {
+                auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DUPLICATE_TRACK );
+                item->SetItems( track );
+                m_itemsList->push_back( item );
+            }
 
-            track->SetFlags( SKIP_STRUCT );
+            track->SetFlags( IS_DELETED );
+            toRemove.insert( track );
         }
     }
 
     if( !m_dryRun )
         removeItems( toRemove );
 
-    auto mergeSegments =
-            [&]( std::shared_ptr<CN_CONNECTIVITY_ALGO> connectivity ) -> bool
-            {
-                for( PCB_TRACK* segment : m_brd->Tracks() )
-                {
-                    // one can merge only collinear segments, not vias or arcs.
-                    if( segment->Type() != PCB_TRACE_T )
-                        continue;
+    if( aMergeSegments )
+    {
+        while( mergeSegmentsPass() )
+        {
+        }
+    }
 
-                    if( segment->HasFlag( IS_DELETED ) )  // already taken into account
-                        continue;
+    for( PCB_TRACK* track : m_brd->Tracks() )
+        track->ClearFlags( IS_DELETED | SKIP_STRUCT );
+}
 
-                    // for each end of the segment:
-                    for( CN_ITEM* citem : connectivity->ItemEntry( segment ).GetItems() )
-                    {
-                        // Do not merge an end which has different width tracks attached -- it's a
-                        // common use-case for necking-down a track between pads.
-                        std::vector<PCB_TRACK*> sameWidthCandidates;
-                        std::vector<PCB_TRACK*> differentWidthCandidates;
 
-                        for( CN_ITEM* connected : citem->ConnectedItems() )
-                        {
-                            if( !connected->Valid() )
-                                continue;
+bool TRACKS_CLEANER::mergeSegmentsPass()
+{
+    while( !m_brd->BuildConnectivity() )
+        wxSafeYield();
+
+    m_connectedItemsCache.clear();
+
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> connectivity =
+            m_brd->GetConnectivity()->GetConnectivityAlgo();
+
+    // Group the segments by net.  ItemEntry() may insert into the item map, so the workers are
+    // handed the connectivity items rather than looking them up.
+    using SEGMENT_ENTRY = std::pair<PCB_TRACK*, const std::list<CN_ITEM*>*>;
+
+    std::unordered_map<int, size_t>         netIndex;
+    std::vector<std::vector<SEGMENT_ENTRY>> nets;
+
+    for( PCB_TRACK* segment : m_brd->Tracks() )
+    {
+        // one can merge only collinear segments, not vias or arcs.
+        if( segment->Type() != PCB_TRACE_T )
+            continue;
+
+        if( segment->HasFlag( IS_DELETED ) )  // already taken into account
+            continue;
+
+        auto [it, inserted] = netIndex.emplace( segment->GetNetCode(), nets.size() );
+
+        if( inserted )
+            nets.emplace_back();
+
+        nets[it->second].emplace_back( segment, &connectivity->ItemEntry( segment ).GetItems() );
+    }
 
-                            BOARD_CONNECTED_ITEM* candidate = connected->Parent();
+    // Find the collinear segments each segment could be merged with, one net per job
+    std::vector<std::vector<std::pair<PCB_TRACK*, PCB_TRACK*>>> candidates( nets.size() );
 
-                            if( candidate->Type() == PCB_TRACE_T
-                                    && !candidate->HasFlag( IS_DELETED ) )
+    auto findCandidates =
+            [&]( size_t aFirst, size_t aLast )
+            {
+                for( size_t ii = aFirst; ii < aLast; ++ii )
+                {
+                    for( const auto& [segment, citems] : nets[ii] )
+                    {
+                        for( CN_ITEM* citem : *citems )
+                        {
+                            // Do not merge an end which has different width tracks attached --
+                            // it's a common use-case for necking-down a track between pads.
+                            std::vector<PCB_TRACK*> sameWidthCandidates;
+                            bool                    differentWidth = false;
+
+                            for( CN_ITEM* connected : citem->ConnectedItems() )
                             {
-                                PCB_TRACK* candidateSegment = static_cast<PCB_TRACK*>( candidate );
+                                if( !connected->Valid() )
+                                    continue;
 
-                                if( candidateSegment->GetWidth() == segment->GetWidth() )
+                                BOARD_CONNECTED_ITEM* candidate = connected->Parent();
+
+                                if( candidate->Type() != PCB_TRACE_T
+                                        || candidate->HasFlag( IS_DELETED ) )
                                 {
-                                    sameWidthCandidates.push_back( candidateSegment );
+                                    continue;
                                 }
-                                else
+
+                                PCB_TRACK* candidateSegment = static_cast<PCB_TRACK*>( candidate );
+
+                                if( candidateSegment->GetWidth() != segment->GetWidth() )
                                 {
-                                    differentWidthCandidates.push_back( candidateSegment );
+                                    differentWidth = true;
                                     break;
                                 }
+
+                                sameWidthCandidates.push_back( candidateSegment );
                             }
-                        }
 
-                        if( !differentWidthCandidates.empty() )
-                            continue;
+                            if( differentWidth )
+                                continue;
 
-                        for( PCB_TRACK* candidate : sameWidthCandidates )
-                        {
-                            if( segment->ApproxCollinear( *candidate )
-                                    && mergeCollinearSegments( segment, candidate ) )
+                            for( PCB_TRACK* candidate : sameWidthCandidates )
                             {
-                                return true;
+                                if( segment->ApproxCollinear( *candidate ) )
+                                    candidates[ii].emplace_back( segment, candidate );
                             }
                         }
                     }
                 }
-
-                return false;
             };
 
-    if( aMergeSegments )
+    GetKiCadThreadPool().parallelize_loop( 0, nets.size(), findCandidates ).wait();
+
+    // Merging two segments changes what is connected to their neighbours, so the rest of this
+    // pass leaves the merged segments and their neighbours alone.  They are looked at again in
+    // the next pass, once the connectivity has been rebuilt.
+    std::unordered_set<BOARD_CONNECTED_ITEM*> touched;
+    bool                                      merged = false;
+
+    for( const std::vector<std::pair<PCB_TRACK*, PCB_TRACK*>>& netCandidates : candidates )
     {
-        do
+        for( const auto& [segment, candidate] : netCandidates )
         {
-            while( !m_brd->BuildConnectivity() )
-                wxSafeYield();
+            if( touched.count( segment ) || touched.count( candidate ) )
+                continue;
 
-            m_connectedItemsCache.clear();
-        } while( mergeSegments( m_brd->GetConnectivity()->GetConnectivityAlgo() ) );
+            if( !mergeCollinearSegments( segment, candidate ) )
+                continue;
+
+            touched.insert( segment );
+            touched.insert( candidate );
+
+            // The connected items were cached by mergeCollinearSegments() before the merge
+            for( BOARD_CONNECTED_ITEM* item : getConnectedItems( segment ) )
+                touched.insert( item );
+
+            for( BOARD_CONNECTED_ITEM* item : getConnectedItems( candidate ) )
+                touched.insert( item );
+
+            merged = true;
+        }
     }
 
-    for( PCB_TRACK* track : m_brd->Tracks() )
-        track->ClearFlags( IS_DELETED | SKIP_STRUCT );
+    return merged;
 }
 
 
@@ -88,6 +88,13 @@ private:
      */
     bool mergeCollinearSegments( PCB_TRACK* aSeg1, PCB_TRACK* aSeg2 );
 
+    /**
+     * Rebuild the connectivity and merge as many pairs of collinear segments as can be merged
+     * independently of each other.  The search for mergeable pairs runs one net per job.
+     * @return true if any segments were merged (and so another pass may find more)
+     */
+    bool mergeSegmentsPass();
+
     /**
      * @return true if a track end position is a node, i.e. a end connected
      * to more than one item.
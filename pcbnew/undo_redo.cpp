@@ -26,8 +26,10 @@
  */
 
 #include <functional>
+#include <unordered_set>
 using namespace std::placeholders;
 #include <macros.h>
+#include <advanced_config.h>
 #include <pcb_edit_frame.h>
 #include <pcb_track.h>
 #include <pcb_group.h>
@@ -35,6 +37,9 @@ using namespace std::placeholders;
 #include <pcb_target.h>
 #include <footprint.h>
 #include <pad.h>
+#include <pcb_shape.h>
+#include <pcb_text.h>
+#include <zone.h>
 #include <origin_viewitem.h>
 #include <connectivity/connectivity_data.h>
 #include <tool/tool_manager.h>
@@ -509,12 +514,203 @@ void PCB_BASE_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aIt
 
         PICKED_ITEMS_LIST* curr_cmd = list.m_CommandsList[0];
         list.m_CommandsList.erase( list.m_CommandsList.begin() );
+        undoMemory( whichList ) -= curr_cmd->GetMemorySize();
         ClearListAndDeleteItems( curr_cmd );
         delete curr_cmd;    // Delete command
     }
 }
 
 
+/**
+ * Rough estimate of the memory held by an item owned by the undo/redo lists.
+ *
+ * Zone fills can be shared between the board and any number of images (see ZONE::GetFill()),
+ * so each one is only counted the first time it is met.  \a aSeenFills should start out with
+ * the fills of the board items, which the undo lists do not pay for.
+ */
+static size_t undoItemSize( const EDA_ITEM* aItem,
+                            std::unordered_set<const SHAPE_POLY_SET*>& aSeenFills )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( aItem );
+        size_t      size = sizeof( ZONE ) + zone->Outline()->FullPointCount() * sizeof( VECTOR2I );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            std::shared_ptr<const SHAPE_POLY_SET> fill = zone->GetFilledPolysList( layer );
+
+            if( aSeenFills.insert( fill.get() ).second )
+                size += fill->FullPointCount() * sizeof( VECTOR2I );
+        }
+
+        return size;
+    }
+
+    case PCB_FOOTPRINT_T:
+    {
+        size_t size = sizeof( FOOTPRINT );
+
+        static_cast<const FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    size += undoItemSize( aChild, aSeenFills );
+                } );
+
+        return size;
+    }
+
+    case PCB_SHAPE_T:
+    {
+        const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
+        size_t           size = sizeof( PCB_SHAPE );
+
+        if( shape->GetShape() == SHAPE_T::POLY )
+            size += shape->GetPolyShape().FullPointCount() * sizeof( VECTOR2I );
+
+        return size;
+    }
+
+    case PCB_PAD_T:   return sizeof( PAD );
+    case PCB_TRACE_T: return sizeof( PCB_TRACK );
+    case PCB_ARC_T:   return sizeof( PCB_ARC );
+    case PCB_VIA_T:   return sizeof( PCB_VIA );
+    default:          return sizeof( PCB_TEXT );    // good enough for the remaining item types
+    }
+}
+
+
+static void addZoneFills( const EDA_ITEM* aItem,
+                          std::unordered_set<const SHAPE_POLY_SET*>& aFills )
+{
+    auto addFills =
+            [&]( const ZONE* aZone )
+            {
+                for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+                {
+                    if( aZone->HasFilledPolysForLayer( layer ) )
+                        aFills.insert( aZone->GetFilledPolysList( layer ).get() );
+                }
+            };
+
+    if( aItem->Type() == PCB_ZONE_T )
+    {
+        addFills( static_cast<const ZONE*>( aItem ) );
+    }
+    else if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        for( const ZONE* zone : static_cast<const FOOTPRINT*>( aItem )->Zones() )
+            addFills( zone );
+    }
+}
+
+
+static size_t undoCommandSize( const PICKED_ITEMS_LIST* aCommand )
+{
+    size_t                                    size = sizeof( PICKED_ITEMS_LIST );
+    std::unordered_set<const SHAPE_POLY_SET*> seenFills;
+
+    auto isOwned =
+            []( const ITEM_PICKER& aPicker )
+            {
+                return ( aPicker.GetFlags() & UR_TRANSIENT )
+                        || aPicker.GetStatus() == UNDO_REDO::DELETED;
+            };
+
+    // An image mostly shares its fill with the board item it was taken from
+    for( unsigned ii = 0; ii < aCommand->GetCount(); ++ii )
+    {
+        ITEM_PICKER picker = aCommand->GetItemWrapper( ii );
+
+        if( picker.GetItem() && !isOwned( picker ) )
+            addZoneFills( picker.GetItem(), seenFills );
+    }
+
+    for( unsigned ii = 0; ii < aCommand->GetCount(); ++ii )
+    {
+        ITEM_PICKER picker = aCommand->GetItemWrapper( ii );
+
+        size += sizeof( ITEM_PICKER );
+
+        if( picker.GetLink() )
+            size += undoItemSize( picker.GetLink(), seenFills );
+
+        if( picker.GetItem() && isOwned( picker ) )
+            size += undoItemSize( picker.GetItem(), seenFills );
+    }
+
+    return size;
+}
+
+
+void PCB_BASE_EDIT_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
+{
+    // Commands may come back modified (e.g. appended to), so they are measured on every push
+    aItem->SetMemorySize( undoCommandSize( aItem ) );
+    m_undoMemory += aItem->GetMemorySize();
+
+    EDA_BASE_FRAME::PushCommandToUndoList( aItem );
+    enforceUndoMemoryBudget( UNDO_LIST );
+}
+
+
+void PCB_BASE_EDIT_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aItem )
+{
+    aItem->SetMemorySize( undoCommandSize( aItem ) );
+    m_redoMemory += aItem->GetMemorySize();
+
+    EDA_BASE_FRAME::PushCommandToRedoList( aItem );
+    enforceUndoMemoryBudget( REDO_LIST );
+}
+
+
+PICKED_ITEMS_LIST* PCB_BASE_EDIT_FRAME::PopCommandFromUndoList()
+{
+    PICKED_ITEMS_LIST* command = EDA_BASE_FRAME::PopCommandFromUndoList();
+
+    if( command )
+        m_undoMemory -= command->GetMemorySize();
+
+    return command;
+}
+
+
+PICKED_ITEMS_LIST* PCB_BASE_EDIT_FRAME::PopCommandFromRedoList()
+{
+    PICKED_ITEMS_LIST* command = EDA_BASE_FRAME::PopCommandFromRedoList();
+
+    if( command )
+        m_redoMemory -= command->GetMemorySize();
+
+    return command;
+}
+
+
+void PCB_BASE_EDIT_FRAME::enforceUndoMemoryBudget( UNDO_REDO_LIST aList )
+{
+    size_t budget = (size_t) ADVANCED_CFG::GetCfg().m_UndoMemoryBudget * 1024 * 1024;
+
+    if( budget == 0 )
+        return;
+
+    UNDO_REDO_CONTAINER& list = aList == UNDO_LIST ? m_undoList : m_redoList;
+    size_t               total = undoMemory( aList );
+
+    // Drop the oldest commands, but always keep the one just pushed however large it is
+    int excess = 0;
+
+    while( total > budget && excess + 1 < (int) list.m_CommandsList.size() )
+        total -= list.m_CommandsList[excess++]->GetMemorySize();
+
+    ClearUndoORRedoList( aList, excess );
+}
+
+
 void PCB_BASE_EDIT_FRAME::ClearListAndDeleteItems( PICKED_ITEMS_LIST* aList )
 {
     aList->ClearListAndDeleteItems(
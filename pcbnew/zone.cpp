@@ -41,6 +41,9 @@
 #include <trigo.h>
 #include <i18n_utility.h>
 
+#include <array>
+#include <cstdint>
+
 
 ZONE::ZONE( BOARD_ITEM_CONTAINER* aParent ) :
         BOARD_CONNECTED_ITEM( aParent, PCB_ZONE_T ),
@@ -165,8 +168,9 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
     {
         std::shared_ptr<SHAPE_POLY_SET> fill = aZone.m_FilledPolysList.at( layer );
 
+        // Fills are copy-on-write: share them until either zone changes its copy (see GetFill())
         if( fill )
-            m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>( *fill );
+            m_FilledPolysList[layer] = fill;
         else
             m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>();
 
@@ -223,7 +227,11 @@ bool ZONE::UnFill()
     {
         change |= !pair.second->IsEmpty();
         m_insulatedIslands[pair.first].clear();
-        pair.second->RemoveAllContours();
+
+        if( pair.second.use_count() > 1 )
+            pair.second = std::make_shared<SHAPE_POLY_SET>();
+        else
+            pair.second->RemoveAllContours();
     }
 
     m_isFilled = false;
@@ -680,7 +688,7 @@ void ZONE::Move( const VECTOR2I& offset )
 
     /* move fills */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
-        pair.second->Move( offset );
+        GetFill( pair.first )->Move( offset );
 
     /*
      * move boundingbox cache
@@ -733,7 +741,7 @@ void ZONE::Rotate( const VECTOR2I& aCentre, const EDA_ANGLE& aAngle )
 
     /* rotate filled areas: */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
-        pair.second->Rotate( aAngle, aCentre );
+        GetFill( pair.first )->Rotate( aAngle, aCentre );
 }
 
 
@@ -741,19 +749,15 @@ void ZONE::Flip( const VECTOR2I& aCentre, bool aFlipLeftRight )
 {
     Mirror( aCentre, aFlipLeftRight );
 
-    std::map<PCB_LAYER_ID, SHAPE_POLY_SET> fillsCopy;
-
-    for( auto& [oldLayer, shapePtr] : m_FilledPolysList )
-    {
-        fillsCopy[oldLayer] = *shapePtr;
-    }
+    // The fills were made private by Mirror(), so they can simply be moved to their new layers
+    std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> fills = m_FilledPolysList;
 
     SetLayerSet( FlipLayerMask( GetLayerSet(), GetBoard()->GetCopperLayerCount() ) );
 
-    for( auto& [oldLayer, shape] : fillsCopy )
+    for( auto& [oldLayer, shapePtr] : fills )
     {
         PCB_LAYER_ID newLayer = FlipLayer( oldLayer, GetBoard()->GetCopperLayerCount() );
-        SetFilledPolysList( newLayer, shape );
+        m_FilledPolysList[newLayer] = shapePtr;
     }
 }
 
@@ -765,7 +769,7 @@ void ZONE::Mirror( const VECTOR2I& aMirrorRef, bool aMirrorLeftRight )
     HatchBorder();
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
-        pair.second->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
+        GetFill( pair.first )->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
 }
 
 
@@ -1085,19 +1089,47 @@ void ZONE::swapData( BOARD_ITEM* aImage )
 }
 
 
-void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
+SHAPE_POLY_SET* ZONE::GetFill( PCB_LAYER_ID aLayer )
+{
+    wxASSERT( m_FilledPolysList.count( aLayer ) );
+
+    std::shared_ptr<SHAPE_POLY_SET>& fill = m_FilledPolysList.at( aLayer );
+
+    if( fill.use_count() > 1 )
+        fill = std::make_shared<SHAPE_POLY_SET>( *fill );
+
+    return fill.get();
+}
+
+
+/**
+ * A fill can be shared by several zones (see ZONE::GetFill()), which may then be asked to
+ * triangulate it from different threads.  Share a handful of locks between all the fills.
+ */
+static void cacheFillTriangulation( SHAPE_POLY_SET& aFill )
+{
+    static std::array<std::mutex, 16> s_locks;
+
+    std::mutex& lock = s_locks[ ( reinterpret_cast<uintptr_t>( &aFill ) >> 4 ) % s_locks.size() ];
+    std::lock_guard<std::mutex> guard( lock );
+
+    aFill.CacheTriangulation();
+}
+
+
+void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer ) const
 {
     if( aLayer == UNDEFINED_LAYER )
     {
         for( auto& [ layer, poly ] : m_FilledPolysList )
-            poly->CacheTriangulation();
+            cacheFillTriangulation( *poly );
 
         m_Poly->CacheTriangulation( false );
     }
     else
     {
         if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ]->CacheTriangulation();
+            cacheFillTriangulation( *m_FilledPolysList.at( aLayer ) );
     }
 }
 
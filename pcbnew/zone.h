@@ -610,25 +610,27 @@ public:
     }
 
     /**
-     * @return a reference to the list of filled polygons.
+     * @return the filled polygons of \a aLayer.  They may be shared with other copies of the
+     *         zone, so they are read-only; use GetFill() to modify them.
      */
-    const std::shared_ptr<SHAPE_POLY_SET>& GetFilledPolysList( PCB_LAYER_ID aLayer ) const
+    std::shared_ptr<const SHAPE_POLY_SET> GetFilledPolysList( PCB_LAYER_ID aLayer ) const
     {
         wxASSERT( m_FilledPolysList.count( aLayer ) );
         return m_FilledPolysList.at( aLayer );
     }
 
-    SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer )
-    {
-        wxASSERT( m_FilledPolysList.count( aLayer ) );
-        return m_FilledPolysList.at( aLayer ).get();
-    }
+    /**
+     * @return the filled polygons of \a aLayer for modification.  Fills are shared between
+     *         copies of a zone (such as undo images), so this first gives the zone a private
+     *         copy if the fill is shared.  Use GetFilledPolysList() to only read it.
+     */
+    SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer );
 
     /**
      * Create a list of triangles that "fill" the solid areas used for instance to draw
      * these solid areas on OpenGL.
      */
-    void CacheTriangulation( PCB_LAYER_ID aLayer = UNDEFINED_LAYER );
+    void CacheTriangulation( PCB_LAYER_ID aLayer = UNDEFINED_LAYER ) const;
 
     /**
      * Set the list of filled polygons.
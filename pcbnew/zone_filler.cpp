@@ -572,24 +572,37 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             // to allow deleting a polygon from list without breaking the remaining of the list
             std::sort( islands.begin(), islands.end(), std::greater<int>() );
 
-            std::shared_ptr<SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
-            long long int                   minArea = zone->GetMinIslandArea();
-            ISLAND_REMOVAL_MODE             mode = zone->GetIslandRemovalMode();
+            std::shared_ptr<const SHAPE_POLY_SET> fill = zone->GetFilledPolysList( layer );
+            long long int                         minArea = zone->GetMinIslandArea();
+            ISLAND_REMOVAL_MODE                   mode = zone->GetIslandRemovalMode();
+            std::vector<int>                      toDelete;
 
             for( int idx : islands )
             {
-                SHAPE_LINE_CHAIN& outline = poly->Outline( idx );
+                const SHAPE_LINE_CHAIN& outline = fill->COutline( idx );
 
                 if( mode == ISLAND_REMOVAL_MODE::ALWAYS )
-                    poly->DeletePolygonAndTriangulationData( idx, false );
+                    toDelete.push_back( idx );
                 else if ( mode == ISLAND_REMOVAL_MODE::AREA && outline.Area( true ) < minArea )
-                    poly->DeletePolygonAndTriangulationData( idx, false );
+                    toDelete.push_back( idx );
                 else
                     zone->SetIsIsland( layer, idx );
             }
 
-            poly->UpdateTriangulationDataHash();
-            zone->CalculateFilledArea();
+            // The fill is shared with the connectivity data (and perhaps undo images), so only
+            // take a private copy of it if something is actually removed
+            if( !toDelete.empty() )
+            {
+                fill.reset();
+
+                SHAPE_POLY_SET* poly = zone->GetFill( layer );
+
+                for( int idx : toDelete )
+                    poly->DeletePolygonAndTriangulationData( idx, false );
+
+                poly->UpdateTriangulationDataHash();
+                zone->CalculateFilledArea();
+            }
 
             if( m_progressReporter && m_progressReporter->IsCancelled() )
                 return false;
@@ -598,9 +611,18 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
     // Now remove islands which are either outside the board edge or fail to meet the minimum
     // area requirements
-    using island_check_return = std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, int>>;
+    struct FILL_TO_CHECK
+    {
+        ZONE*                                 m_zone;
+        PCB_LAYER_ID                          m_layer;
+        std::shared_ptr<const SHAPE_POLY_SET> m_fill;
+        double                                m_minArea;
+    };
+
+    // Pairs of an index into polys_to_check and an outline to remove from that fill
+    using island_check_return = std::vector<std::pair<int, int>>;
 
-    std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, double>> polys_to_check;
+    std::vector<FILL_TO_CHECK> polys_to_check;
 
     // rough estimate to save re-allocation time
     polys_to_check.reserve( m_board->GetCopperLayerCount() * aZones.size() );
@@ -619,7 +641,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
                 continue;
 
-            polys_to_check.emplace_back( zone->GetFilledPolysList( layer ), minArea );
+            polys_to_check.push_back( { zone, layer, zone->GetFilledPolysList( layer ), minArea } );
         }
     }
 
@@ -630,13 +652,14 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
                 for( int ii = aStart; ii < aEnd && !cancelled; ++ii )
                 {
-                    auto [poly, minArea] = polys_to_check[ii];
+                    const SHAPE_POLY_SET* poly = polys_to_check[ii].m_fill.get();
+                    double                minArea = polys_to_check[ii].m_minArea;
 
                     for( int jj = poly->OutlineCount() - 1; jj >= 0; jj-- )
                     {
                         SHAPE_POLY_SET island;
                         SHAPE_POLY_SET intersection;
-                        const SHAPE_LINE_CHAIN& test_poly = poly->Polygon( jj ).front();
+                        const SHAPE_LINE_CHAIN& test_poly = poly->CPolygon( jj ).front();
                         double island_area = test_poly.Area();
 
                         if( island_area < minArea )
@@ -653,7 +676,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                         // slight overlap at the edges, so testing against half-size area acts as
                         // a fail-safe.
                         if( intersection.Area() < island_area / 2.0 )
-                            retval.emplace_back( poly, jj );
+                            retval.emplace_back( ii, jj );
                     }
                 }
 
@@ -696,8 +719,16 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
         if( ret.valid() )
         {
-            for( auto& action_item : ret.get() )
-                action_item.first->DeletePolygonAndTriangulationData( action_item.second, true );
+            // Outlines come back last to first for each fill, so indices stay valid.  Only the
+            // fills which actually lose islands are made private to their zone.
+            for( const auto& [ fillIdx, outlineIdx ] : ret.get() )
+            {
+                FILL_TO_CHECK& check = polys_to_check[fillIdx];
+
+                check.m_fill.reset();
+                check.m_zone->GetFill( check.m_layer )->DeletePolygonAndTriangulationData(
+                        outlineIdx, true );
+            }
         }
     }
 
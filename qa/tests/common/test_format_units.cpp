@@ -28,7 +28,9 @@
 #include <locale_io.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <fmt/core.h>
 
 struct UnitFixture
 {
@@ -84,4 +86,54 @@ BOOST_AUTO_TEST_CASE( VECTOR2IUnitFormat )
 }
 
 
+/**
+ * The integer formatting must give exactly what printing the value in mm as a double with 10
+ * significant digits used to give, so that saved files don't change.
+ */
+BOOST_AUTO_TEST_CASE( FormatInternalUnitsMatchesFloatingPoint )
+{
+    LOCALE_IO   toggle;
+
+    auto formatAsDouble =
+            []( const EDA_IU_SCALE& aIuScale, int aValue ) -> std::string
+            {
+                double      engUnits = aValue / aIuScale.IU_PER_MM;
+                std::string buf;
+
+                if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+                {
+                    buf = fmt::format( "{:.10f}", engUnits );
+
+                    while( buf.back() == '0' )
+                        buf.pop_back();
+
+                    if( buf.back() == '.' )
+                        buf.pop_back();
+                }
+                else
+                {
+                    buf = fmt::format( "{:.10g}", engUnits );
+                }
+
+                return buf;
+            };
+
+    std::vector<int> values = { 0, 1, -1, 9, 10, 99, 100, 101, 999, 1000, 1001, 123456789,
+                                -100000, 2540000, 254000, std::numeric_limits<int>::min(),
+                                std::numeric_limits<int>::max() };
+
+    for( int ii = -20000; ii <= 20000; ++ii )
+        values.push_back( ii * 37 );
+
+    for( const EDA_IU_SCALE& iuScale : { pcbIUScale, schIUScale, gerbIUScale } )
+    {
+        for( int value : values )
+        {
+            BOOST_CHECK_EQUAL( EDA_UNIT_UTILS::FormatInternalUnits( iuScale, value ),
+                               formatAsDouble( iuScale, value ) );
+        }
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <font/font.h>
+#include <font/glyph_cache.h>
+#include <font/outline_font.h>
+
+
+BOOST_AUTO_TEST_SUITE( GlyphCache )
+
+
+BOOST_AUTO_TEST_CASE( HitsMissesAndEvictions )
+{
+    KIFONT::FONT* font = KIFONT::FONT::GetFont( wxT( "DejaVu Sans" ) );
+
+    if( !font->IsOutline() )
+    {
+        BOOST_TEST_MESSAGE( "No outline font available; skipping" );
+        return;
+    }
+
+    const KIFONT::OUTLINE_FONT* outlineFont = static_cast<const KIFONT::OUTLINE_FONT*>( font );
+    const KIFONT::METRICS&      metrics = KIFONT::METRICS::Default();
+    KIFONT::GLYPH_CACHE         cache( 2 );
+    TEXT_ATTRIBUTES             attrs;
+
+    attrs.m_Size = VECTOR2I( 1000000, 1000000 );
+    attrs.m_StrokeWidth = 150000;
+
+    auto getRun =
+            [&]( const wxString& aText )
+            {
+                return cache.GetRun( outlineFont, aText, attrs, metrics );
+            };
+
+    std::shared_ptr<const KIFONT::GLYPH_RUN> a = getRun( wxT( "a" ) );
+
+    BOOST_CHECK_EQUAL( cache.GetStats().m_Misses, 1 );
+    BOOST_CHECK( getRun( wxT( "a" ) ) == a );
+    BOOST_CHECK_EQUAL( cache.GetStats().m_Hits, 1 );
+
+    // Runs are handed out triangulated, and are never changed after that
+    for( const std::unique_ptr<KIFONT::GLYPH>& glyph : *a )
+    {
+        if( glyph->IsOutline() )
+        {
+            const KIFONT::OUTLINE_GLYPH* outline =
+                    static_cast<const KIFONT::OUTLINE_GLYPH*>( glyph.get() );
+
+            BOOST_CHECK( outline->OutlineCount() == 0 || outline->TriangulatedPolyCount() > 0 );
+        }
+    }
+
+    // Colour doesn't change the glyphs, so must not miss the cache
+    attrs.m_Color = KIGFX::COLOR4D( 1.0, 0.0, 0.0, 1.0 );
+    BOOST_CHECK( getRun( wxT( "a" ) ) == a );
+    attrs.m_Color = KIGFX::COLOR4D::UNSPECIFIED;
+
+    std::shared_ptr<const KIFONT::GLYPH_RUN> b = getRun( wxT( "b" ) );
+
+    // "a" is now the most recently used, so "b" is the one to go when "c" comes in
+    BOOST_CHECK( getRun( wxT( "a" ) ) == a );
+    getRun( wxT( "c" ) );
+
+    KIFONT::GLYPH_CACHE::STATS stats = cache.GetStats();
+
+    BOOST_CHECK_EQUAL( cache.Size(), 2 );
+    BOOST_CHECK_EQUAL( stats.m_Hits, 3 );
+    BOOST_CHECK_EQUAL( stats.m_Misses, 3 );
+    BOOST_CHECK_EQUAL( stats.m_Evictions, 1 );
+
+    BOOST_CHECK( getRun( wxT( "a" ) ) == a );
+    BOOST_CHECK_EQUAL( cache.GetStats().m_Evictions, 1 );
+
+    // An evicted run is rebuilt, but texts still holding the old one keep it
+    BOOST_CHECK( getRun( wxT( "b" ) ) != b );
+    BOOST_CHECK_EQUAL( cache.GetStats().m_Misses, 4 );
+    BOOST_CHECK_EQUAL( cache.GetStats().m_Evictions, 2 );
+    BOOST_CHECK( !b->empty() );
+
+    cache.Clear();
+    BOOST_CHECK_EQUAL( cache.Size(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
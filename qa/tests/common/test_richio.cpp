@@ -31,6 +31,9 @@
 // Code under test
 #include <richio.h>
 
+#include <filesystem>
+#include <fstream>
+
 /**
  * Declare the test suite
  */
@@ -74,4 +77,109 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+
+/**
+ * Write \a aContents to a temporary file and read it back a line at a time with a
+ * #FILE_LINE_READER, checking the reported file position after each line.
+ */
+static std::vector<std::string> readLines( const std::string& aContents )
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "richio_tst.txt";
+
+    {
+        std::ofstream out( path, std::ios::binary );
+        out << aContents;
+    }
+
+    std::vector<std::string> lines;
+
+    {
+        FILE_LINE_READER reader( wxString( path.string() ) );
+        size_t           pos = 0;
+
+        while( char* line = reader.ReadLine() )
+        {
+            lines.emplace_back( line, reader.Length() );
+            pos += reader.Length();
+
+            BOOST_CHECK_EQUAL( reader.LineNumber(), lines.size() );
+            BOOST_CHECK_EQUAL( reader.CurPos(), (long int) pos );
+        }
+
+        // Reading past the end keeps returning nothing
+        BOOST_CHECK( reader.ReadLine() == nullptr );
+    }
+
+    std::filesystem::remove( path );
+
+    return lines;
+}
+
+
+/**
+ * Test #FILE_LINE_READER reading its file in blocks.
+ */
+BOOST_AUTO_TEST_CASE( FileLineReaderBlocks )
+{
+    // FILE_LINE_READER reads its own files in 64 KiB blocks
+    const size_t blockSize = 64 * 1024;
+
+    // A line ending just before, exactly at and just after a block boundary
+    for( size_t firstLength : { blockSize - 1, blockSize, blockSize + 1 } )
+    {
+        std::string first = std::string( firstLength - 1, 'a' ) + "\n";
+        std::string second = std::string( 100, 'b' ) + "\n";
+
+        std::vector<std::string> lines = readLines( first + second + "end\n" );
+
+        BOOST_REQUIRE_EQUAL( lines.size(), 3 );
+        BOOST_CHECK( lines[0] == first );
+        BOOST_CHECK( lines[1] == second );
+        BOOST_CHECK( lines[2] == "end\n" );
+    }
+
+    // A line crossing a block boundary
+    {
+        std::string first = std::string( blockSize - 10, 'a' ) + "\n";
+        std::string second = std::string( 100, 'b' ) + "\n";
+
+        std::vector<std::string> lines = readLines( first + second );
+
+        BOOST_REQUIRE_EQUAL( lines.size(), 2 );
+        BOOST_CHECK( lines[0] == first );
+        BOOST_CHECK( lines[1] == second );
+    }
+
+    // A line longer than several blocks
+    {
+        std::string first = "short\n";
+        std::string second = std::string( 3 * blockSize + 123, 'c' ) + "\n";
+
+        std::vector<std::string> lines = readLines( first + second + "x\n" );
+
+        BOOST_REQUIRE_EQUAL( lines.size(), 3 );
+        BOOST_CHECK( lines[0] == first );
+        BOOST_CHECK_EQUAL( lines[1].size(), second.size() );
+        BOOST_CHECK( lines[1] == second );
+        BOOST_CHECK( lines[2] == "x\n" );
+    }
+
+    // A final line with no newline, also once it is split by a block boundary
+    for( size_t lastLength : { (size_t) 1, blockSize + 5 } )
+    {
+        std::string first = "first\n";
+        std::string last( lastLength, 'd' );
+
+        std::vector<std::string> lines = readLines( first + last );
+
+        BOOST_REQUIRE_EQUAL( lines.size(), 2 );
+        BOOST_CHECK( lines[0] == first );
+        BOOST_CHECK( lines[1] == last );
+    }
+
+    // An empty file
+    BOOST_CHECK( readLines( "" ).empty() );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,330 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_field.h>
+#include <netlist_reader/pcb_netlist.h>
+#include <netlist_reader/board_netlist_updater.h>
+#include <settings/settings_manager.h>
+#include <template_fieldnames.h>
+#include <tool/tool_manager.h>
+
+#include <set>
+
+
+struct BOARD_NETLIST_UPDATER_TEST_FIXTURE
+{
+    BOARD_NETLIST_UPDATER_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+/**
+ * Collect the footprints the commits report as changed.
+ */
+class CHANGED_FOOTPRINTS_LISTENER : public BOARD_LISTENER
+{
+public:
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override
+    {
+        for( BOARD_ITEM* item : aItems )
+        {
+            if( item->Type() == PCB_FOOTPRINT_T )
+                m_Changed.insert( static_cast<FOOTPRINT*>( item ) );
+        }
+    }
+
+    std::set<FOOTPRINT*> m_Changed;
+};
+
+
+/**
+ * Build the netlist the board's schematic would produce, i.e. one with nothing to update.
+ */
+static void buildNetlist( BOARD* aBoard, NETLIST& aNetlist )
+{
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        KIID_PATH         path = footprint->GetPath();
+        std::vector<KIID> kiids;
+
+        if( !path.empty() )
+        {
+            kiids.push_back( path.back() );
+            path.pop_back();
+        }
+
+        COMPONENT* component = new COMPONENT( footprint->GetFPID(), footprint->GetReference(),
+                                              footprint->GetValue(), path, kiids );
+
+        nlohmann::ordered_map<wxString, wxString> fields;
+        fields[GetCanonicalFieldName( REFERENCE_FIELD )] = footprint->GetReference();
+        fields[GetCanonicalFieldName( VALUE_FIELD )] = footprint->GetValue();
+
+        for( PCB_FIELD* field : footprint->GetFields() )
+        {
+            if( !field->IsReference() && !field->IsValue() )
+                fields[field->GetName()] = field->GetText();
+        }
+
+        component->SetFields( fields );
+
+        std::map<wxString, wxString> properties;
+        properties[wxT( "Sheetname" )] = footprint->GetSheetname();
+        properties[wxT( "Sheetfile" )] = footprint->GetSheetfile();
+        properties[wxT( "ki_fp_filters" )] = footprint->GetFilters();
+
+        if( footprint->GetAttributes() & FP_EXCLUDE_FROM_BOM )
+            properties[wxT( "exclude_from_bom" )] = wxEmptyString;
+
+        if( footprint->GetAttributes() & FP_DNP )
+            properties[wxT( "dnp" )] = wxEmptyString;
+
+        component->SetProperties( properties );
+
+        std::set<wxString> pinNames;
+
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( !pad->IsOnCopperLayer() || pad->GetNumber().IsEmpty() )
+                continue;
+
+            if( pinNames.insert( pad->GetNumber() ).second )
+            {
+                component->AddNet( pad->GetNumber(), pad->GetNetname(), pad->GetPinFunction(),
+                                   pad->GetPinType() );
+            }
+        }
+
+        aNetlist.AddComponent( component );
+    }
+}
+
+
+static void updateBoard( BOARD* aBoard, NETLIST& aNetlist )
+{
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( aBoard, nullptr, nullptr, nullptr, nullptr );
+
+    KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+    toolMgr.RegisterTool( dummyTool );
+
+    BOARD_NETLIST_UPDATER updater( &toolMgr, aBoard );
+    updater.SetLookupByTimestamp( true );
+    updater.SetReplaceFootprints( false );
+    updater.SetDeleteUnusedFootprints( false );
+
+    BOOST_CHECK( updater.UpdateNetlist( aNetlist ) );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( UpdateOnlyChangedFootprints, BOARD_NETLIST_UPDATER_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    CHANGED_FOOTPRINTS_LISTENER listener;
+    m_board->AddListener( &listener );
+
+    // An up to date netlist leaves every footprint alone
+    {
+        NETLIST netlist;
+        buildNetlist( m_board.get(), netlist );
+        updateBoard( m_board.get(), netlist );
+
+        BOOST_CHECK( listener.m_Changed.empty() );
+    }
+
+    // Changed values, fields and pad nets still go through
+    {
+        NETLIST netlist;
+        buildNetlist( m_board.get(), netlist );
+
+        BOOST_REQUIRE_GE( netlist.GetCount(), 3 );
+
+        std::vector<FOOTPRINT*> footprints( m_board->Footprints().begin(),
+                                            m_board->Footprints().end() );
+
+        // Components are in board order
+        COMPONENT* valueComp = netlist.GetComponent( 0 );
+        valueComp->SetValue( wxT( "NEW_VALUE" ) );
+
+        COMPONENT* fieldComp = netlist.GetComponent( 1 );
+        nlohmann::ordered_map<wxString, wxString> fields = fieldComp->GetFields();
+        fields[wxT( "MPN" )] = wxT( "NEW_MPN" );
+        fieldComp->SetFields( fields );
+
+        FOOTPRINT* netFootprint = nullptr;
+        PAD*       netPad = nullptr;
+
+        for( size_t ii = 2; ii < footprints.size() && !netPad; ++ii )
+        {
+            COMPONENT* netComp = netlist.GetComponent( ii );
+
+            if( netComp->GetNetCount() == 0 )
+                continue;
+
+            const COMPONENT_NET& net = netComp->GetNet( 0u );
+
+            for( PAD* pad : footprints[ii]->Pads() )
+            {
+                if( pad->GetNumber() == net.GetPinName() && !pad->IsNoConnectPad() )
+                {
+                    netFootprint = footprints[ii];
+                    netPad = pad;
+                    break;
+                }
+            }
+
+            if( netPad )
+            {
+                std::vector<COMPONENT_NET> nets;
+
+                for( unsigned jj = 0; jj < netComp->GetNetCount(); ++jj )
+                    nets.push_back( netComp->GetNet( jj ) );
+
+                netComp->ClearNets();
+
+                for( const COMPONENT_NET& pin : nets )
+                {
+                    wxString netName = pin.GetNetName();
+
+                    if( pin.GetPinName() == netPad->GetNumber() )
+                        netName = wxT( "/NEW_NET" );
+
+                    netComp->AddNet( pin.GetPinName(), netName, pin.GetPinFunction(),
+                                     pin.GetPinType() );
+                }
+            }
+        }
+
+        BOOST_REQUIRE( netPad );
+
+        updateBoard( m_board.get(), netlist );
+
+        BOOST_CHECK_EQUAL( footprints[0]->GetValue(), wxT( "NEW_VALUE" ) );
+
+        PCB_FIELD* mpn = footprints[1]->GetFieldByName( wxT( "MPN" ) );
+        BOOST_REQUIRE( mpn );
+        BOOST_CHECK_EQUAL( mpn->GetText(), wxT( "NEW_MPN" ) );
+
+        BOOST_CHECK_EQUAL( netPad->GetNetname(), wxT( "/NEW_NET" ) );
+
+        std::set<FOOTPRINT*> expected = { footprints[0], footprints[1], netFootprint };
+        BOOST_CHECK( listener.m_Changed == expected );
+    }
+
+    m_board->RemoveListener( &listener );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( AddRepeatedFootprints, BOARD_NETLIST_UPDATER_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+
+    // Use a footprint of the board, nets and all, as the library footprint
+    FOOTPRINT* source = nullptr;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->GetNetCode() > 0 )
+                source = footprint;
+        }
+
+        if( source )
+            break;
+    }
+
+    BOOST_REQUIRE( source );
+
+    std::unique_ptr<FOOTPRINT> prototype( static_cast<FOOTPRINT*>( source->Clone() ) );
+    std::set<KIID>             prototypeIds;
+
+    prototypeIds.insert( prototype->m_Uuid );
+    prototype->RunOnChildren(
+            [&]( BOARD_ITEM* aChild )
+            {
+                prototypeIds.insert( aChild->m_Uuid );
+            } );
+
+    LIB_ID  fpid( wxT( "QA" ), wxT( "Repeated" ) );
+    NETLIST netlist;
+    buildNetlist( m_board.get(), netlist );
+
+    const size_t repeats = 3;
+
+    for( size_t ii = 0; ii < repeats; ++ii )
+    {
+        wxString reference = wxString::Format( wxT( "U%d" ), 901 + (int) ii );
+
+        netlist.AddComponent( new COMPONENT( fpid, reference, wxT( "VALUE" ), KIID_PATH(),
+                                             { KIID() } ) );
+    }
+
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+    KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+    toolMgr.RegisterTool( dummyTool );
+
+    BOARD_NETLIST_UPDATER updater( &toolMgr, m_board.get() );
+    updater.SetLookupByTimestamp( true );
+    updater.SetReplaceFootprints( false );
+    updater.SetDeleteUnusedFootprints( false );
+    updater.SetFootprintPrototype( fpid, std::move( prototype ) );
+
+    BOOST_CHECK( updater.UpdateNetlist( netlist ) );
+
+    std::vector<FOOTPRINT*> added = updater.GetAddedFootprints();
+    BOOST_REQUIRE_EQUAL( added.size(), repeats );
+
+    // Every footprint and every item in them gets an id of its own
+    std::set<KIID> ids;
+
+    for( FOOTPRINT* footprint : added )
+    {
+        BOOST_CHECK( footprint->GetFPID() == fpid );
+        BOOST_CHECK( !prototypeIds.count( footprint->m_Uuid ) );
+        BOOST_CHECK( ids.insert( footprint->m_Uuid ).second );
+
+        footprint->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    BOOST_CHECK( !prototypeIds.count( aChild->m_Uuid ) );
+                    BOOST_CHECK( ids.insert( aChild->m_Uuid ).second );
+                } );
+
+        // The library footprint's nets don't come along
+        for( PAD* pad : footprint->Pads() )
+            BOOST_CHECK_EQUAL( pad->GetNetCode(), 0 );
+    }
+}
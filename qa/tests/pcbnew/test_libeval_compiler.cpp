@@ -146,6 +146,33 @@ BOOST_AUTO_TEST_CASE( SimpleExpressions )
 }
 
 
+BOOST_AUTO_TEST_CASE( ConstantFolding )
+{
+    PCBEXPR_COMPILER  compiler( new PCBEXPR_UNIT_RESOLVER() );
+    PCBEXPR_UCODE     ucode;
+    PCBEXPR_CONTEXT   preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+    BOOST_REQUIRE( compiler.Compile( "-(1 + (2 - 4)) * 20.8 / 2 > 10", &ucode,
+                                     &preflightContext ) );
+
+    // The whole expression is constant, so it should compile to a single push
+    BOOST_CHECK_EQUAL( ucode.Dump().Freq( '\n' ), 1 );
+
+    // Values are recycled between contexts; repeated evaluation must stay stable
+    for( int i = 0; i < 100; ++i )
+    {
+        PCBEXPR_CONTEXT context( NULL_CONSTRAINT, UNDEFINED_LAYER );
+        BOOST_CHECK_EQUAL( ucode.Run( &context )->AsDouble(), 1.0 );
+    }
+
+    // A division by zero is left for evaluation rather than folded away
+    PCBEXPR_UCODE divUcode;
+
+    BOOST_REQUIRE( compiler.Compile( "1 / 0", &divUcode, &preflightContext ) );
+    BOOST_CHECK_EQUAL( divUcode.Dump().Freq( '\n' ), 3 );
+}
+
+
 BOOST_AUTO_TEST_CASE( IntrospectedProperties )
 {
     PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
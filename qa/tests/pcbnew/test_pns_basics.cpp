@@ -24,12 +24,17 @@
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <settings/settings_manager.h>
 
+#include <optional>
+
+#include <geometry/shape_rect.h>
+
 #include <pcbnew/pad.h>
 #include <pcbnew/pcb_track.h>
 
 #include <router/pns_node.h>
 #include <router/pns_router.h>
 #include <router/pns_item.h>
+#include <router/pns_solid.h>
 #include <router/pns_via.h>
 #include <router/pns_kicad_iface.h>
 
@@ -288,6 +293,19 @@ public:
                       bool aIsHeadTrace = false ) override {};
     PNS::RULE_RESOLVER* GetRuleResolver() override;
 
+    using PNS_KICAD_IFACE_BASE::IsFlashedOnLayer;
+
+    bool IsFlashedOnLayer( const PNS::ITEM* aItem, int aLayer ) const override
+    {
+        if( m_forceFlashed )
+            return *m_forceFlashed;
+
+        return PNS_KICAD_IFACE_BASE::IsFlashedOnLayer( aItem, aLayer );
+    }
+
+    ///< Overrides the flashed state of every item when set
+    std::optional<bool> m_forceFlashed;
+
 private:
     PNS_TEST_FIXTURE* m_testFixture;
 };
@@ -403,3 +421,132 @@ BOOST_FIXTURE_TEST_CASE( PNSHoleCollisions, PNS_TEST_FIXTURE )
     }
 }
 
+
+
+BOOST_FIXTURE_TEST_CASE( PNSFindItemsByParents, PNS_TEST_FIXTURE )
+{
+    PCB_VIA pcbVia1( nullptr );
+    PCB_VIA pcbVia2( nullptr );
+
+    PNS::VIA* v1 = new PNS::VIA( VECTOR2I( 0, 1000000 ), LAYER_RANGE( F_Cu, B_Cu ), 50000, 10000 );
+    PNS::VIA* v2 = new PNS::VIA( VECTOR2I( 0, 2000000 ), LAYER_RANGE( F_Cu, B_Cu ), 50000, 10000 );
+
+    v1->SetParent( &pcbVia1 );
+    v2->SetParent( &pcbVia2 );
+
+    std::unique_ptr<PNS::NODE> world( new PNS::NODE );
+
+    world->SetMaxClearance( 10000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+
+    world->AddRaw( v1 );
+    world->AddRaw( v2 );
+
+    // Holes are removed along with their via, so they must not be reported
+    std::vector<PNS::ITEM*> found = world->FindItemsByParents( { &pcbVia1 } );
+
+    BOOST_REQUIRE_EQUAL( found.size(), 1 );
+    BOOST_CHECK_EQUAL( found[0], v1 );
+
+    world->Remove( found[0] );
+
+    BOOST_CHECK( world->FindItemsByParents( { &pcbVia1 } ).empty() );
+    BOOST_CHECK_EQUAL( world->FindItemsByParents( { &pcbVia1, &pcbVia2 } ).size(), 1 );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( PNSBranchOverrides, PNS_TEST_FIXTURE )
+{
+    std::vector<PNS::VIA*> vias;
+
+    std::unique_ptr<PNS::NODE> world( new PNS::NODE );
+
+    world->SetMaxClearance( 10000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+
+    for( int i = 0; i < 8; i++ )
+    {
+        vias.push_back( new PNS::VIA( VECTOR2I( 0, i * 1000000 ), LAYER_RANGE( F_Cu, B_Cu ),
+                                      50000, 10000 ) );
+        world->AddRaw( vias.back() );
+    }
+
+    PNS::NODE* branch = world->Branch();
+
+    // Remove in an order unrelated to the item addresses, and twice, to exercise the
+    // sorted override table
+    for( int i : { 5, 1, 7, 3, 1 } )
+        branch->Remove( vias[i] );
+
+    PNS::NODE* child = branch->Branch();
+
+    child->Remove( vias[0] );
+
+    for( int i = 0; i < 8; i++ )
+    {
+        bool removed = ( i % 2 ) == 1;
+
+        BOOST_CHECK_EQUAL( branch->Overrides( vias[i] ), removed );
+        BOOST_CHECK_EQUAL( branch->Overrides( vias[i]->Hole() ), removed );
+        BOOST_CHECK_EQUAL( child->Overrides( vias[i] ), removed || i == 0 );
+    }
+
+    PNS::NODE::ITEM_VECTOR removedItems, addedItems;
+
+    branch->GetUpdatedItems( removedItems, addedItems );
+
+    // Four vias and their holes
+    BOOST_CHECK_EQUAL( removedItems.size(), 8 );
+    BOOST_CHECK( addedItems.empty() );
+
+    world->KillChildren();
+}
+
+
+BOOST_AUTO_TEST_CASE( PNSSolidHullCache )
+{
+    PNS::SOLID solid;
+
+    solid.SetShape( new SHAPE_RECT( VECTOR2I( 0, 0 ), 1000000, 500000 ) );
+    solid.SetPos( VECTOR2I( 500000, 250000 ) );
+
+    SHAPE_LINE_CHAIN hull = solid.Hull( 100000, 200000 );
+
+    // Cached hulls must be identical to freshly built ones
+    BOOST_CHECK( solid.Hull( 100000, 200000 ).CompareGeometry( hull ) );
+    BOOST_CHECK( !solid.Hull( 50000, 200000 ).CompareGeometry( hull ) );
+
+    // ...and must follow the solid when it moves
+    solid.SetPos( VECTOR2I( 1500000, 250000 ) );
+
+    SHAPE_LINE_CHAIN moved = solid.Hull( 100000, 200000 );
+
+    hull.Move( VECTOR2I( 1000000, 0 ) );
+    BOOST_CHECK( moved.CompareGeometry( hull ) );
+
+    solid.SetShape( new SHAPE_RECT( VECTOR2I( 0, 0 ), 2000000, 500000 ) );
+    BOOST_CHECK( !solid.Hull( 100000, 200000 ).CompareGeometry( moved ) );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( PNSViaHullCacheFlashing, PNS_TEST_FIXTURE )
+{
+    PNS::VIA via( VECTOR2I( 0, 0 ), LAYER_RANGE( F_Cu, B_Cu ), 500000, 200000 );
+
+    m_iface->m_forceFlashed = true;
+    SHAPE_LINE_CHAIN flashed = via.Hull( 100000, 0, F_Cu );
+
+    // A via losing its pad on a layer (e.g. once its last track there is removed) must not
+    // keep reporting the hull of the pad
+    m_iface->m_forceFlashed = false;
+    SHAPE_LINE_CHAIN unflashed = via.Hull( 100000, 0, F_Cu );
+
+    BOOST_CHECK( !unflashed.CompareGeometry( flashed ) );
+    BOOST_CHECK( unflashed.BBox().GetWidth() < flashed.BBox().GetWidth() );
+
+    std::unique_ptr<PNS::VIA> fresh( via.Clone() );
+    BOOST_CHECK( fresh->Hull( 100000, 0, F_Cu ).CompareGeometry( unflashed ) );
+
+    m_iface->m_forceFlashed = true;
+    BOOST_CHECK( via.Hull( 100000, 0, F_Cu ).CompareGeometry( flashed ) );
+}
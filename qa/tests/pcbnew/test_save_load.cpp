@@ -21,12 +21,17 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <clocale>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <pcbnew_utils/board_test_utils.h>
 #include <pcbnew_utils/board_file_utils.h>
 #include <board.h>
+#include <board_design_settings.h>
+#include <pcb_track.h>
 #include <settings/settings_manager.h>
 
 
@@ -64,3 +69,73 @@ BOOST_FIXTURE_TEST_CASE( RegressionSaveLoadTests, SAVE_LOAD_TEST_FIXTURE )
     }
 }
 
+
+static std::string readFile( const std::filesystem::path& aPath )
+{
+    std::ifstream      in( aPath, std::ios::binary );
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+
+BOOST_FIXTURE_TEST_CASE( SaveLoadCommaDecimalLocale, SAVE_LOAD_TEST_FIXTURE )
+{
+    /*
+     * Boards are written and read without switching to the C locale, so a locale with a
+     * decimal comma must not change the file or what is read back from it.
+     */
+    auto refPath = std::filesystem::temp_directory_path() / "locale_saveload_ref.kicad_pcb";
+    auto savePath = std::filesystem::temp_directory_path() / "locale_saveload_tst.kicad_pcb";
+
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", m_board );
+    KI_TEST::DumpBoardToFile( *m_board.get(), refPath.string() );
+
+    std::string oldLocale = setlocale( LC_NUMERIC, nullptr );
+    bool        haveCommaLocale = false;
+
+    for( const char* name : { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8",
+                              "German_Germany.1252" } )
+    {
+        if( setlocale( LC_NUMERIC, name ) && *localeconv()->decimal_point == ',' )
+        {
+            haveCommaLocale = true;
+            break;
+        }
+    }
+
+    if( !haveCommaLocale )
+    {
+        setlocale( LC_NUMERIC, oldLocale.c_str() );
+        BOOST_TEST_MESSAGE( "No locale with a decimal comma available, skipping" );
+        return;
+    }
+
+    std::unique_ptr<BOARD> board;
+    KI_TEST::LoadBoard( m_settingsManager, "complex_hierarchy", board );
+    KI_TEST::DumpBoardToFile( *board.get(), savePath.string() );
+
+    std::unique_ptr<BOARD> board2 = KI_TEST::ReadBoardFromFileOrStream( savePath.string() );
+
+    setlocale( LC_NUMERIC, oldLocale.c_str() );
+
+    BOOST_CHECK( readFile( savePath ) == readFile( refPath ) );
+
+    BOOST_REQUIRE( board2 );
+    BOOST_CHECK_EQUAL( board2->GetDesignSettings().GetBoardThickness(),
+                       m_board->GetDesignSettings().GetBoardThickness() );
+    BOOST_REQUIRE_EQUAL( board2->Tracks().size(), m_board->Tracks().size() );
+
+    auto expected = m_board->Tracks().begin();
+
+    for( PCB_TRACK* track : board2->Tracks() )
+    {
+        BOOST_CHECK_EQUAL( track->GetStart(), ( *expected )->GetStart() );
+        BOOST_CHECK_EQUAL( track->GetEnd(), ( *expected )->GetEnd() );
+        BOOST_CHECK_EQUAL( track->GetWidth(), ( *expected )->GetWidth() );
+        ++expected;
+    }
+
+    std::filesystem::remove( refPath );
+    std::filesystem::remove( savePath );
+}
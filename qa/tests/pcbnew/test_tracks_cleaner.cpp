@@ -27,6 +27,8 @@
 #include <board_commit.h>
 #include <board_design_settings.h>
 #include <connectivity/connectivity_data.h>
+#include <netinfo.h>
+#include <pcb_track.h>
 #include <tracks_cleaner.h>
 #include <cleanup_item.h>
 #include <drc/drc_item.h>
@@ -224,3 +226,137 @@ BOOST_FIXTURE_TEST_CASE( TrackCleanerRegressionTests, TRACK_CLEANER_TEST_FIXTURE
     }
 }
 
+
+BOOST_FIXTURE_TEST_CASE( TrackCleanerDuplicatesAndMerges, TRACK_CLEANER_TEST_FIXTURE )
+{
+    /*
+     * Cleans a small board with duplicate, locked and collinear tracks, and checks the items
+     * reported and the tracks left are the ones the per-item R-tree search and the merge-one-
+     * rebuild-all loop used to produce.
+     */
+    m_board = std::make_unique<BOARD>();
+
+    NETINFO_ITEM* net = new NETINFO_ITEM( m_board.get(), wxT( "N1" ), 1 );
+    m_board->Add( net );
+
+    const int narrow = pcbIUScale.mmToIU( 0.25 );
+    const int wide = pcbIUScale.mmToIU( 0.5 );
+
+    auto addTrack =
+            [&]( double x1, double y1, double x2, double y2, int aWidth, bool aLocked )
+            {
+                PCB_TRACK* track = new PCB_TRACK( m_board.get() );
+                track->SetStart( VECTOR2I( pcbIUScale.mmToIU( x1 ), pcbIUScale.mmToIU( y1 ) ) );
+                track->SetEnd( VECTOR2I( pcbIUScale.mmToIU( x2 ), pcbIUScale.mmToIU( y2 ) ) );
+                track->SetWidth( aWidth );
+                track->SetLayer( F_Cu );
+                track->SetNet( net );
+                track->SetLocked( aLocked );
+                m_board->Add( track, ADD_MODE::APPEND );
+                return track;
+            };
+
+    auto addVia =
+            [&]( double x, double y )
+            {
+                PCB_VIA* via = new PCB_VIA( m_board.get() );
+                via->SetPosition( VECTOR2I( pcbIUScale.mmToIU( x ), pcbIUScale.mmToIU( y ) ) );
+                via->SetViaType( VIATYPE::THROUGH );
+                via->SetLayerPair( F_Cu, B_Cu );
+                via->SetWidth( pcbIUScale.mmToIU( 0.8 ) );
+                via->SetDrill( pcbIUScale.mmToIU( 0.4 ) );
+                via->SetNet( net );
+                m_board->Add( via, ADD_MODE::APPEND );
+                return via;
+            };
+
+    // A chain of four collinear segments, merged into one
+    addTrack( 0, 0, 1, 0, narrow, false );
+    addTrack( 1, 0, 2, 0, narrow, false );
+    addTrack( 2, 0, 3, 0, narrow, false );
+    addTrack( 3, 0, 4, 0, narrow, false );
+
+    // A segment duplicated with its ends swapped: one of them goes
+    addTrack( 10, 0, 12, 0, narrow, false );
+    addTrack( 12, 0, 10, 0, narrow, false );
+
+    // A locked segment is neither merged nor removed as a duplicate
+    PCB_TRACK* locked = addTrack( 20, 0, 21, 0, narrow, true );
+    PCB_TRACK* unlocked = addTrack( 21, 0, 22, 0, narrow, false );
+    PCB_TRACK* lockedDuplicate = addTrack( 20, 5, 22, 5, narrow, true );
+    addTrack( 20, 5, 22, 5, narrow, false );
+
+    // A track necked down to a different width is not merged
+    PCB_TRACK* neckA = addTrack( 30, 0, 31, 0, narrow, false );
+    PCB_TRACK* neckB = addTrack( 31, 0, 32, 0, wide, false );
+
+    // A zero length segment
+    addTrack( 40, 0, 40, 0, narrow, false );
+
+    // Two identical vias: one of them goes
+    addVia( 50, 0 );
+    addVia( 50, 0 );
+
+    m_board->BuildConnectivity();
+
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+    KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+    toolMgr.RegisterTool( dummyTool );
+
+    BOARD_COMMIT                                 commit( dummyTool );
+    TRACKS_CLEANER                               cleaner( m_board.get(), commit );
+    std::vector< std::shared_ptr<CLEANUP_ITEM> > items;
+
+    cleaner.CleanupBoard( false, &items, false,   // short circuits
+                                         true,    // redundant vias
+                                         true,    // redundant tracks
+                                         false,   // dangling tracks
+                                         false,   // tracks in pads
+                                         false ); // dangling vias
+
+    commit.Push( wxT( "Cleanup" ) );
+
+    std::map<int, int> itemCounts;
+
+    for( const std::shared_ptr<CLEANUP_ITEM>& item : items )
+        itemCounts[ item->GetErrorCode() ]++;
+
+    BOOST_CHECK_EQUAL( itemCounts[ CLEANUP_MERGE_TRACKS ], 3 );
+    BOOST_CHECK_EQUAL( itemCounts[ CLEANUP_DUPLICATE_TRACK ], 2 );
+    BOOST_CHECK_EQUAL( itemCounts[ CLEANUP_REDUNDANT_VIA ], 1 );
+    BOOST_CHECK_EQUAL( itemCounts[ CLEANUP_ZERO_LENGTH_TRACK ], 1 );
+    BOOST_CHECK_EQUAL( items.size(), 7 );
+
+    std::vector<PCB_TRACK*> tracks( m_board->Tracks().begin(), m_board->Tracks().end() );
+
+    BOOST_CHECK_EQUAL( tracks.size(), 8 );
+
+    auto findTrack =
+            [&]( double x1, double y1, double x2, double y2 ) -> int
+            {
+                VECTOR2I a( pcbIUScale.mmToIU( x1 ), pcbIUScale.mmToIU( y1 ) );
+                VECTOR2I b( pcbIUScale.mmToIU( x2 ), pcbIUScale.mmToIU( y2 ) );
+
+                return std::count_if( tracks.begin(), tracks.end(),
+                                      [&]( PCB_TRACK* aTrack )
+                                      {
+                                          return aTrack->IsPointOnEnds( a )
+                                                 && aTrack->IsPointOnEnds( b );
+                                      } );
+            };
+
+    BOOST_CHECK_EQUAL( findTrack( 0, 0, 4, 0 ), 1 );
+    BOOST_CHECK_EQUAL( findTrack( 10, 0, 12, 0 ), 1 );
+    BOOST_CHECK_EQUAL( findTrack( 20, 5, 22, 5 ), 1 );
+
+    for( PCB_TRACK* track : { locked, unlocked, lockedDuplicate, neckA, neckB } )
+        BOOST_CHECK( std::count( tracks.begin(), tracks.end(), track ) == 1 );
+
+    BOOST_CHECK_EQUAL( std::count_if( tracks.begin(), tracks.end(),
+                                      []( PCB_TRACK* aTrack )
+                                      {
+                                          return aTrack->Type() == PCB_VIA_T;
+                                      } ), 1 );
+}
@@ -162,6 +162,43 @@ BOOST_FIXTURE_TEST_CASE( NotchedZones, ZONE_FILL_TEST_FIXTURE )
 }
 
 
+BOOST_FIXTURE_TEST_CASE( ZoneFillCopyOnWrite, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "notched_zones", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    ZONE* zone = nullptr;
+
+    for( ZONE* candidate : m_board->Zones() )
+    {
+        if( candidate->HasFilledPolysForLayer( F_Cu )
+                && !candidate->GetFilledPolysList( F_Cu )->IsEmpty() )
+        {
+            zone = candidate;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( zone );
+
+    // A copy (such as an undo image) shares the fill rather than duplicating it...
+    std::unique_ptr<ZONE> image( static_cast<ZONE*>( zone->Clone() ) );
+
+    BOOST_CHECK( image->GetFilledPolysList( F_Cu ) == zone->GetFilledPolysList( F_Cu ) );
+
+    // ... until one of them changes it.
+    BOX2I    before = zone->GetFilledPolysList( F_Cu )->BBox();
+    VECTOR2I offset( pcbIUScale.mmToIU( 1 ), 0 );
+
+    zone->Move( offset );
+
+    BOOST_CHECK( image->GetFilledPolysList( F_Cu ) != zone->GetFilledPolysList( F_Cu ) );
+    BOOST_CHECK_EQUAL( image->GetFilledPolysList( F_Cu )->BBox().GetOrigin(), before.GetOrigin() );
+    BOOST_CHECK_EQUAL( zone->GetFilledPolysList( F_Cu )->BBox().GetOrigin(),
+                       before.GetOrigin() + offset );
+}
+
+
 BOOST_FIXTURE_TEST_CASE( RegressionZoneFillTests, ZONE_FILL_TEST_FIXTURE )
 {
     std::vector<wxString> tests = { "issue18",
@@ -0,0 +1,163 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Measure how many rule conditions per second the expression evaluator can run.
+ *
+ * Usage: libeval_compiler_bench <board.kicad_pcb> <rules.kicad_dru> [passes]
+ *
+ * Every rule condition in the rules file is evaluated against consecutive pairs of
+ * board items, the same way the DRC engine evaluates conditions.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <wx/filefn.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <core/profile.h>
+#include <drc/drc_rule.h>
+#include <drc/drc_rule_condition.h>
+#include <drc/drc_rule_parser.h>
+#include <properties/property_mgr.h>
+#include <reporter.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+
+int main( int argc, char* argv[] )
+{
+    if( argc < 3 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <board.kicad_pcb> <rules.kicad_dru> [passes]"
+                  << std::endl;
+        return 1;
+    }
+
+    int passes = argc > 3 ? std::max( 1, atoi( argv[3] ) ) : 10;
+
+    PROPERTY_MANAGER::Instance().Rebuild();
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !board )
+    {
+        std::cerr << "Could not load board " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::shared_ptr<DRC_RULE>> rules;
+    FILE*                                  fp = wxFopen( wxString::FromUTF8( argv[2] ), "rt" );
+
+    if( !fp )
+    {
+        std::cerr << "Could not open rules file " << argv[2] << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        DRC_RULES_PARSER parser( fp, wxString::FromUTF8( argv[2] ) );
+        parser.Parse( rules, &NULL_REPORTER::GetInstance() );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        std::cerr << "Could not parse rules: " << ioe.What().ToStdString() << std::endl;
+        return 1;
+    }
+
+    std::vector<BOARD_ITEM*> items;
+
+    for( PCB_TRACK* track : board->Tracks() )
+        items.push_back( track );
+
+    for( FOOTPRINT* footprint : board->Footprints() )
+    {
+        items.push_back( footprint );
+
+        for( PAD* pad : footprint->Pads() )
+            items.push_back( pad );
+    }
+
+    for( ZONE* zone : board->Zones() )
+        items.push_back( zone );
+
+    if( items.size() < 2 )
+    {
+        std::cerr << "Board has too few items to benchmark" << std::endl;
+        return 1;
+    }
+
+    long long totalEvals = 0;
+    double    totalMs = 0.0;
+
+    for( const std::shared_ptr<DRC_RULE>& rule : rules )
+    {
+        if( !rule->m_Condition || rule->m_Condition->GetExpression().IsEmpty() )
+            continue;
+
+        int constraint = rule->m_Constraints.empty() ? NULL_CONSTRAINT
+                                                     : rule->m_Constraints.front().m_Type;
+        long long  evals = 0;
+        long long  hits = 0;
+        PROF_TIMER timer;
+
+        for( int pass = 0; pass < passes; ++pass )
+        {
+            for( size_t i = 0; i < items.size(); ++i )
+            {
+                BOARD_ITEM* a = items[i];
+                BOARD_ITEM* b = rule->m_Unary ? nullptr : items[( i + 1 ) % items.size()];
+
+                if( rule->m_Condition->EvaluateFor( a, b, constraint, F_Cu ) )
+                    hits++;
+
+                evals++;
+            }
+        }
+
+        timer.Stop();
+
+        printf( "%-40s %10lld evals %10.1f ms %12.0f evals/s (%lld true)\n",
+                rule->m_Name.ToStdString().c_str(), evals, timer.msecs(),
+                evals / ( timer.msecs() / 1000.0 ), hits );
+
+        totalEvals += evals;
+        totalMs += timer.msecs();
+    }
+
+    if( totalMs > 0.0 )
+    {
+        printf( "%-40s %10lld evals %10.1f ms %12.0f evals/s\n", "TOTAL", totalEvals, totalMs,
+                totalEvals / ( totalMs / 1000.0 ) );
+    }
+
+    return 0;
+}
@@ -0,0 +1,422 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <wx/textfile.h>
+#include <wx/tokenzr.h>
+
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+#include <core/profile.h>
+#include <netinfo.h>
+#include <pcb_track.h>
+#include <reporter.h>
+
+#include <router/pns_arc.h>
+#include <router/pns_joint.h>
+#include <router/pns_node.h>
+#include <router/pns_segment.h>
+#include <router/pns_sizes_settings.h>
+#include <router/pns_via.h>
+
+#include "pns_batch_router.h"
+
+using namespace PNS;
+
+
+PNS_BATCH_ROUTER_IFACE::PNS_BATCH_ROUTER_IFACE()
+{
+}
+
+
+PNS_BATCH_ROUTER_IFACE::~PNS_BATCH_ROUTER_IFACE()
+{
+    delete m_ruleResolver;
+}
+
+
+void PNS_BATCH_ROUTER_IFACE::AddItem( ITEM* aItem )
+{
+    BOARD_CONNECTED_ITEM* newItem = nullptr;
+
+    switch( aItem->Kind() )
+    {
+    case ITEM::ARC_T:
+    {
+        ARC*     arc = static_cast<ARC*>( aItem );
+        PCB_ARC* newArc = new PCB_ARC( m_board, static_cast<const SHAPE_ARC*>( arc->Shape() ) );
+
+        newArc->SetWidth( arc->Width() );
+        newArc->SetLayer( ToLAYER_ID( arc->Layers().Start() ) );
+        newItem = newArc;
+        break;
+    }
+
+    case ITEM::SEGMENT_T:
+    {
+        SEGMENT*   seg = static_cast<SEGMENT*>( aItem );
+        PCB_TRACK* track = new PCB_TRACK( m_board );
+
+        track->SetStart( seg->Seg().A );
+        track->SetEnd( seg->Seg().B );
+        track->SetWidth( seg->Width() );
+        track->SetLayer( ToLAYER_ID( seg->Layers().Start() ) );
+        newItem = track;
+        break;
+    }
+
+    case ITEM::VIA_T:
+    {
+        VIA*     via = static_cast<VIA*>( aItem );
+        PCB_VIA* newVia = new PCB_VIA( m_board );
+
+        newVia->SetPosition( via->Pos() );
+        newVia->SetWidth( via->Diameter() );
+        newVia->SetDrill( via->Drill() );
+        newVia->SetViaType( via->ViaType() ); // MUST be before SetLayerPair()
+        newVia->SetIsFree( via->IsFree() );
+        newVia->SetLayerPair( ToLAYER_ID( via->Layers().Start() ),
+                              ToLAYER_ID( via->Layers().End() ) );
+        newItem = newVia;
+        break;
+    }
+
+    default:
+        // Batch routing never drags footprints, so there are no solids to move
+        return;
+    }
+
+    newItem->SetNet( static_cast<NETINFO_ITEM*>( aItem->Net() ) );
+    aItem->SetParent( newItem );
+    m_board->Add( newItem, ADD_MODE::APPEND );
+}
+
+
+void PNS_BATCH_ROUTER_IFACE::UpdateItem( ITEM* aItem )
+{
+    BOARD_ITEM* parent = aItem->Parent();
+
+    switch( aItem->Kind() )
+    {
+    case ITEM::ARC_T:
+    {
+        ARC*             arc = static_cast<ARC*>( aItem );
+        PCB_ARC*         pcbArc = static_cast<PCB_ARC*>( parent );
+        const SHAPE_ARC* shape = static_cast<const SHAPE_ARC*>( arc->Shape() );
+
+        pcbArc->SetStart( shape->GetP0() );
+        pcbArc->SetMid( shape->GetArcMid() );
+        pcbArc->SetEnd( shape->GetP1() );
+        pcbArc->SetWidth( arc->Width() );
+        break;
+    }
+
+    case ITEM::SEGMENT_T:
+    {
+        SEGMENT*   seg = static_cast<SEGMENT*>( aItem );
+        PCB_TRACK* track = static_cast<PCB_TRACK*>( parent );
+
+        track->SetStart( seg->Seg().A );
+        track->SetEnd( seg->Seg().B );
+        track->SetWidth( seg->Width() );
+        break;
+    }
+
+    case ITEM::VIA_T:
+    {
+        VIA*     via = static_cast<VIA*>( aItem );
+        PCB_VIA* pcbVia = static_cast<PCB_VIA*>( parent );
+
+        pcbVia->SetPosition( via->Pos() );
+        pcbVia->SetWidth( via->Diameter() );
+        pcbVia->SetDrill( via->Drill() );
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+
+void PNS_BATCH_ROUTER_IFACE::RemoveItem( ITEM* aItem )
+{
+    BOARD_ITEM* parent = aItem->Parent();
+
+    if( !parent || aItem->OfKind( ITEM::SOLID_T ) )
+        return;
+
+    m_board->Remove( parent );
+    m_removedItems.emplace_back( parent );
+}
+
+
+int PNS_BATCH_ROUTER_IFACE::GetNetCode( NET_HANDLE aNet ) const
+{
+    if( aNet )
+        return static_cast<NETINFO_ITEM*>( aNet )->GetNetCode();
+    else
+        return -1;
+}
+
+
+wxString PNS_BATCH_ROUTER_IFACE::GetNetName( NET_HANDLE aNet ) const
+{
+    if( aNet )
+        return static_cast<NETINFO_ITEM*>( aNet )->GetNetname();
+    else
+        return wxEmptyString;
+}
+
+
+PNS_BATCH_ROUTER::PNS_BATCH_ROUTER( std::shared_ptr<BOARD> aBoard ) :
+        m_board( aBoard ),
+        m_reporter( &NULL_REPORTER::GetInstance() )
+{
+    m_iface = std::make_unique<PNS_BATCH_ROUTER_IFACE>();
+    m_iface->SetBoard( m_board.get() );
+
+    m_settings = std::make_unique<ROUTING_SETTINGS>( nullptr, "" );
+    m_settings->SetMode( RM_Shove );
+
+    m_router = std::make_unique<ROUTER>();
+    m_router->SetInterface( m_iface.get() );
+    m_router->ClearWorld();
+    m_router->SyncWorld();
+    m_router->LoadSettings( m_settings.get() );
+    m_router->SetMode( PNS_MODE_ROUTE_SINGLE );
+}
+
+
+PNS_BATCH_ROUTER::~PNS_BATCH_ROUTER()
+{
+}
+
+
+void PNS_BATCH_ROUTER::SetMode( PNS_MODE aMode )
+{
+    m_settings->SetMode( aMode );
+}
+
+
+ITEM* PNS_BATCH_ROUTER::pickItem( const VECTOR2I& aWhere, int aLayer )
+{
+    ITEM*       best = nullptr;
+    SEG::ecoord bestDist = VECTOR2I::ECOORD_MAX;
+    bool        bestOnLayer = false;
+    ITEM_SET    candidates = m_router->QueryHoverItems( aWhere );
+
+    for( ITEM* item : candidates.CItems() )
+    {
+        if( !item->IsRoutable() || !IsCopperLayer( item->Layers().Start() ) )
+            continue;
+
+        if( !item->OfKind( ITEM::SOLID_T | ITEM::VIA_T | ITEM::SEGMENT_T | ITEM::ARC_T ) )
+            continue;
+
+        bool        onLayer = aLayer < 0 || item->Layers().Overlaps( aLayer );
+        SEG::ecoord dist;
+
+        if( item->OfKind( ITEM::SOLID_T | ITEM::VIA_T ) )
+        {
+            dist = ( item->Shape()->Centre() - aWhere ).SquaredEuclideanNorm();
+        }
+        else
+        {
+            LINKED_ITEM* li = static_cast<LINKED_ITEM*>( item );
+
+            dist = std::min( ( li->Anchor( 0 ) - aWhere ).SquaredEuclideanNorm(),
+                             ( li->Anchor( 1 ) - aWhere ).SquaredEuclideanNorm() );
+        }
+
+        if( ( onLayer && !bestOnLayer ) || ( onLayer == bestOnLayer && dist < bestDist ) )
+        {
+            best = item;
+            bestDist = dist;
+            bestOnLayer = onLayer;
+        }
+    }
+
+    return best;
+}
+
+
+bool PNS_BATCH_ROUTER::RouteConnection( const CONNECTION& aConnection )
+{
+    ITEM* startItem = pickItem( aConnection.m_start, aConnection.m_layer );
+
+    int layer = aConnection.m_layer;
+
+    if( layer == UNDEFINED_LAYER )
+        layer = startItem ? startItem->Layers().Start() : F_Cu;
+
+    SIZES_SETTINGS sizes( m_router->Sizes() );
+
+    m_iface->SetStartLayer( layer );
+    m_iface->ImportSizes( sizes, startItem, nullptr );
+    m_router->UpdateSizes( sizes );
+
+    if( !m_router->StartRouting( aConnection.m_start, startItem, layer ) )
+    {
+        m_reporter->Report( wxString::Format( wxT( "Can't start routing at (%d, %d): %s" ),
+                                              aConnection.m_start.x, aConnection.m_start.y,
+                                              m_router->FailureReason() ),
+                            RPT_SEVERITY_WARNING );
+        return false;
+    }
+
+    // The end item is looked up once the placer has a node, as only then can it tell which
+    // items belong to the net being routed
+    ITEM* endItem = pickItem( aConnection.m_end, -1 );
+
+    if( endItem && startItem && endItem->Net() != startItem->Net() )
+        endItem = nullptr;
+
+    const JOINT* endJoint = endItem ? m_router->GetWorld()->FindJoint( aConnection.m_end, endItem )
+                                    : nullptr;
+    int          linksBefore = endJoint ? endJoint->LinkCount() : 0;
+
+    m_router->Move( aConnection.m_end, endItem );
+
+    bool fixed = m_router->FixRoute( aConnection.m_end, endItem, true );
+
+    m_router->StopRouting();
+
+    if( !fixed )
+        return false;
+
+    if( !endItem )
+        return true;
+
+    // Routed all the way if something new is now attached to the end point
+    endJoint = m_router->GetWorld()->FindJoint( aConnection.m_end, endItem );
+
+    return endJoint && endJoint->LinkCount() > linksBefore;
+}
+
+
+PNS_BATCH_ROUTER::RESULT PNS_BATCH_ROUTER::Route( const std::vector<CONNECTION>& aConnections )
+{
+    RESULT     result;
+    PROF_TIMER timer;
+
+    for( const CONNECTION& connection : aConnections )
+    {
+        if( RouteConnection( connection ) )
+            result.m_routed++;
+        else
+            result.m_failed++;
+    }
+
+    timer.Stop();
+    result.m_msecs = timer.msecs();
+
+    return result;
+}
+
+
+std::vector<PNS_BATCH_ROUTER::CONNECTION> PNS_BATCH_ROUTER::ConnectionsFromRatsnest( BOARD* aBoard )
+{
+    std::vector<CONNECTION> connections;
+
+    aBoard->GetConnectivity()->RunOnUnconnectedEdges(
+            [&]( CN_EDGE& aEdge )
+            {
+                CONNECTION connection;
+
+                connection.m_start = aEdge.GetSourcePos();
+                connection.m_end = aEdge.GetTargetPos();
+                connections.push_back( connection );
+                return true;
+            } );
+
+    return connections;
+}
+
+
+bool PNS_BATCH_ROUTER::LoadConnections( const wxString& aFileName, BOARD* aBoard,
+                                        std::vector<CONNECTION>& aConnections,
+                                        REPORTER* aReporter )
+{
+    wxTextFile file( aFileName );
+
+    if( !file.Open() )
+    {
+        aReporter->Report( wxString::Format( wxT( "Can't open connection list '%s'." ),
+                                             aFileName ),
+                           RPT_SEVERITY_ERROR );
+        return false;
+    }
+
+    auto parseCoord =
+            []( const wxString& aToken, int& aValue ) -> bool
+            {
+                double mm;
+
+                if( !aToken.ToCDouble( &mm ) )
+                    return false;
+
+                aValue = pcbIUScale.mmToIU( mm );
+                return true;
+            };
+
+    for( size_t lineNo = 0; lineNo < file.GetLineCount(); lineNo++ )
+    {
+        wxString line = file.GetLine( lineNo ).Trim( true ).Trim( false );
+
+        if( line.IsEmpty() || line.StartsWith( wxT( "#" ) ) )
+            continue;
+
+        wxArrayString tokens = wxStringTokenize( line );
+        CONNECTION    connection;
+
+        if( tokens.size() < 4
+                || !parseCoord( tokens[0], connection.m_start.x )
+                || !parseCoord( tokens[1], connection.m_start.y )
+                || !parseCoord( tokens[2], connection.m_end.x )
+                || !parseCoord( tokens[3], connection.m_end.y ) )
+        {
+            aReporter->Report( wxString::Format( wxT( "%s:%d: expected 'start_x start_y end_x "
+                                                      "end_y [layer]'." ),
+                                                 aFileName, (int) lineNo + 1 ),
+                               RPT_SEVERITY_ERROR );
+            return false;
+        }
+
+        if( tokens.size() > 4 )
+        {
+            connection.m_layer = aBoard->GetLayerID( tokens[4] );
+
+            if( connection.m_layer == UNDEFINED_LAYER || !IsCopperLayer( connection.m_layer ) )
+            {
+                aReporter->Report( wxString::Format( wxT( "%s:%d: '%s' is not a copper layer." ),
+                                                     aFileName, (int) lineNo + 1, tokens[4] ),
+                                   RPT_SEVERITY_ERROR );
+                return false;
+            }
+        }
+
+        aConnections.push_back( connection );
+    }
+
+    return true;
+}
@@ -0,0 +1,131 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __PNS_BATCH_ROUTER_H
+#define __PNS_BATCH_ROUTER_H
+
+#include <memory>
+#include <vector>
+
+#include <pcbnew/board.h>
+
+#include <router/pns_kicad_iface.h>
+#include <router/pns_router.h>
+#include <router/pns_routing_settings.h>
+
+class REPORTER;
+
+
+/**
+ * Router interface which writes the routed tracks straight into the board, with no
+ * view, tool or undo stack behind it.
+ */
+class PNS_BATCH_ROUTER_IFACE : public PNS_KICAD_IFACE_BASE
+{
+public:
+    PNS_BATCH_ROUTER_IFACE();
+    ~PNS_BATCH_ROUTER_IFACE();
+
+    void AddItem( PNS::ITEM* aItem ) override;
+    void UpdateItem( PNS::ITEM* aItem ) override;
+    void RemoveItem( PNS::ITEM* aItem ) override;
+
+    int GetNetCode( PNS::NET_HANDLE aNet ) const override;
+    wxString GetNetName( PNS::NET_HANDLE aNet ) const override;
+
+private:
+    // Items removed from the board are still referenced by the router's garbage, so they
+    // are only freed along with the iface
+    std::vector<std::unique_ptr<BOARD_ITEM>> m_removedItems;
+};
+
+
+/**
+ * Routes a list of connections through PNS::ROUTER without any GUI, the same way the
+ * interactive router would if the user clicked on the start point and then on the end point.
+ */
+class PNS_BATCH_ROUTER
+{
+public:
+    struct CONNECTION
+    {
+        VECTOR2I     m_start;
+        VECTOR2I     m_end;
+        PCB_LAYER_ID m_layer = UNDEFINED_LAYER; ///< Start layer; undefined to pick it from the
+                                                ///<   item under the start point
+    };
+
+    struct RESULT
+    {
+        int    m_routed = 0;
+        int    m_failed = 0;
+        double m_msecs = 0.0;
+    };
+
+    PNS_BATCH_ROUTER( std::shared_ptr<BOARD> aBoard );
+    ~PNS_BATCH_ROUTER();
+
+    void SetReporter( REPORTER* aReporter ) { m_reporter = aReporter; }
+
+    /**
+     * Set the routing mode (PNS::RM_Shove or PNS::RM_Walkaround).
+     */
+    void SetMode( PNS::PNS_MODE aMode );
+
+    PNS::ROUTER* Router() const { return m_router.get(); }
+
+    /**
+     * Route a single connection.  The routed tracks are added to the board and to the
+     * router's world, so later connections have to get around them.
+     *
+     * @return true if the connection was routed all the way to its end point.
+     */
+    bool RouteConnection( const CONNECTION& aConnection );
+
+    RESULT Route( const std::vector<CONNECTION>& aConnections );
+
+    /**
+     * Build a connection for each unrouted ratsnest line of \a aBoard.
+     */
+    static std::vector<CONNECTION> ConnectionsFromRatsnest( BOARD* aBoard );
+
+    /**
+     * Read connections from a text file.  Each non-empty line not starting with '#' holds
+     * "start_x start_y end_x end_y [layer_name]", with coordinates in millimetres.
+     */
+    static bool LoadConnections( const wxString& aFileName, BOARD* aBoard,
+                                 std::vector<CONNECTION>& aConnections, REPORTER* aReporter );
+
+private:
+    PNS::ITEM* pickItem( const VECTOR2I& aWhere, int aLayer );
+
+    std::shared_ptr<BOARD>                  m_board;
+    std::unique_ptr<PNS_BATCH_ROUTER_IFACE> m_iface;
+
+    ///< Declared after m_iface so the world goes before the rule resolver the iface owns
+    std::unique_ptr<PNS::ROUTER>            m_router;
+    std::unique_ptr<PNS::ROUTING_SETTINGS>  m_settings;
+    REPORTER*                               m_reporter;
+};
+
+#endif
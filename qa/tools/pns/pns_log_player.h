@@ -94,6 +94,12 @@ public:
 
     void SetTimeLimit( uint64_t microseconds ) { m_timeLimitUs = microseconds; }
 
+    /**
+     * Turn off the debug decorator's geometry capture (on by default), e.g. when the replay
+     * is being timed.
+     */
+    void SetDebugEnabled( bool aEnabled ) { m_debugEnabled = aEnabled; }
+
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
@@ -106,6 +112,7 @@ private:
     std::unique_ptr<PNS_LOG_PLAYER_KICAD_IFACE> m_iface;
     std::unique_ptr<PNS::ROUTER>          m_router;
     uint64_t m_timeLimitUs;
+    bool      m_debugEnabled;
     REPORTER* m_reporter;
 };
 
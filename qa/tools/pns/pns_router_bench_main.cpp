@@ -0,0 +1,262 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Measure the latency of the router's expensive operations.
+ *
+ * Usage:
+ *   pns_router_bench replay <log base path | tests.lst> ...
+ *   pns_router_bench route <board.kicad_pcb> [connections.txt] [--walkaround] [-o out.kicad_pcb]
+ *
+ * "replay" plays back P&S event logs (as recorded by the router's event logger, or the
+ * regression suite's tests.lst), "route" routes every unrouted ratsnest line of a board (or
+ * the connections listed in a file) through the headless batch router.  Both print the
+ * latency distribution of SHOVE::ShoveLines(), WALKAROUND::Route() and OPTIMIZER::Optimize().
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <wx/filename.h>
+#include <wx/textfile.h>
+
+#include <board.h>
+#include <core/profile.h>
+#include <properties/property_mgr.h>
+#include <reporter.h>
+#include <router/pns_op_profiler.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include "pns_batch_router.h"
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+
+static double percentile( const std::vector<double>& aSorted, double aFraction )
+{
+    if( aSorted.empty() )
+        return 0.0;
+
+    size_t idx = static_cast<size_t>( aFraction * ( aSorted.size() - 1 ) + 0.5 );
+
+    return aSorted[ std::min( idx, aSorted.size() - 1 ) ];
+}
+
+
+static void printProfile( const PNS::OP_PROFILER& aProfiler )
+{
+    printf( "%-22s %8s %10s %10s %10s %10s %12s\n", "operation", "calls", "p50 (us)", "p90 (us)",
+            "p99 (us)", "max (us)", "total (ms)" );
+
+    for( int op = 0; op < PNS::OP_PROFILER::OP_COUNT; ++op )
+    {
+        std::vector<double> samples = aProfiler.Samples( (PNS::OP_PROFILER::OPERATION) op );
+        double              total = 0.0;
+
+        std::sort( samples.begin(), samples.end() );
+
+        for( double sample : samples )
+            total += sample;
+
+        printf( "%-22s %8d %10.1f %10.1f %10.1f %10.1f %12.1f\n",
+                PNS::OP_PROFILER::OperationName( (PNS::OP_PROFILER::OPERATION) op ),
+                (int) samples.size(), percentile( samples, 0.5 ), percentile( samples, 0.9 ),
+                percentile( samples, 0.99 ), samples.empty() ? 0.0 : samples.back(),
+                total / 1000.0 );
+    }
+}
+
+
+static std::vector<wxString> expandLogList( const wxString& aPath )
+{
+    std::vector<wxString> logs;
+    wxFileName            fn( aPath );
+
+    if( fn.GetFullName() != wxT( "tests.lst" ) )
+    {
+        logs.push_back( aPath );
+        return logs;
+    }
+
+    wxTextFile fp( aPath );
+
+    if( !fp.Open() )
+    {
+        std::cerr << "Could not open test list " << aPath.ToStdString() << std::endl;
+        return logs;
+    }
+
+    for( wxString line = fp.GetFirstLine(); !fp.Eof(); line = fp.GetNextLine() )
+    {
+        line.Trim( true ).Trim( false );
+
+        if( !line.IsEmpty() )
+            logs.push_back( fn.GetPath() + wxFileName::GetPathSeparator() + line + wxT( "/pns" ) );
+    }
+
+    return logs;
+}
+
+
+static int replayLogs( const std::vector<wxString>& aArgs )
+{
+    PNS::OP_PROFILER profiler;
+    int              replayed = 0;
+    double           totalMs = 0.0;
+
+    PNS::OP_PROFILER::SetActive( &profiler );
+
+    for( const wxString& arg : aArgs )
+    {
+        for( const wxString& logName : expandLogList( arg ) )
+        {
+            PNS_LOG_FILE   logFile;
+            PNS_LOG_PLAYER player;
+
+            if( !logFile.Load( wxFileName( logName ), &NULL_REPORTER::GetInstance() ) )
+            {
+                std::cerr << "Could not load log " << logName.ToStdString() << std::endl;
+                continue;
+            }
+
+            PROF_TIMER timer;
+
+            player.SetDebugEnabled( false );
+            player.ReplayLog( &logFile, 0 );
+            timer.Stop();
+
+            printf( "%-60s %10.1f ms\n", logName.ToStdString().c_str(), timer.msecs() );
+
+            totalMs += timer.msecs();
+            replayed++;
+        }
+    }
+
+    PNS::OP_PROFILER::SetActive( nullptr );
+
+    if( !replayed )
+        return 1;
+
+    printf( "\n%d logs replayed in %.1f ms\n\n", replayed, totalMs );
+    printProfile( profiler );
+    return 0;
+}
+
+
+static int routeBoard( const std::vector<wxString>& aArgs )
+{
+    wxString boardFile;
+    wxString connectionsFile;
+    wxString outputFile;
+    bool     walkaround = false;
+
+    for( size_t i = 0; i < aArgs.size(); ++i )
+    {
+        if( aArgs[i] == wxT( "--walkaround" ) )
+            walkaround = true;
+        else if( aArgs[i] == wxT( "--shove" ) )
+            walkaround = false;
+        else if( aArgs[i] == wxT( "-o" ) && i + 1 < aArgs.size() )
+            outputFile = aArgs[++i];
+        else if( boardFile.IsEmpty() )
+            boardFile = aArgs[i];
+        else
+            connectionsFile = aArgs[i];
+    }
+
+    if( boardFile.IsEmpty() )
+    {
+        std::cerr << "No board given" << std::endl;
+        return 1;
+    }
+
+    std::shared_ptr<BOARD> board( KI_TEST::ReadBoardFromFileOrStream( boardFile.ToStdString() ) );
+
+    if( !board )
+    {
+        std::cerr << "Could not load board " << boardFile.ToStdString() << std::endl;
+        return 1;
+    }
+
+    board->BuildConnectivity();
+
+    STDOUT_REPORTER                       reporter;
+    std::vector<PNS_BATCH_ROUTER::CONNECTION> connections;
+
+    if( connectionsFile.IsEmpty() )
+        connections = PNS_BATCH_ROUTER::ConnectionsFromRatsnest( board.get() );
+    else if( !PNS_BATCH_ROUTER::LoadConnections( connectionsFile, board.get(), connections,
+                                                 &reporter ) )
+        return 1;
+
+    PNS::OP_PROFILER profiler;
+    PNS_BATCH_ROUTER router( board );
+
+    router.SetReporter( &reporter );
+    router.SetMode( walkaround ? PNS::RM_Walkaround : PNS::RM_Shove );
+
+    PNS::OP_PROFILER::SetActive( &profiler );
+    PNS_BATCH_ROUTER::RESULT result = router.Route( connections );
+    PNS::OP_PROFILER::SetActive( nullptr );
+
+    printf( "%d connections: %d routed, %d failed in %.1f ms\n\n", (int) connections.size(),
+            result.m_routed, result.m_failed, result.m_msecs );
+    printProfile( profiler );
+
+    if( !outputFile.IsEmpty() )
+        KI_TEST::DumpBoardToFile( *board, outputFile.ToStdString() );
+
+    return 0;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    if( argc < 3 )
+    {
+        std::cerr << "Usage: " << argv[0] << " replay <log base path | tests.lst> ...\n"
+                  << "       " << argv[0] << " route <board.kicad_pcb> [connections.txt] "
+                                             "[--shove|--walkaround] [-o out.kicad_pcb]"
+                  << std::endl;
+        return 1;
+    }
+
+    PROPERTY_MANAGER::Instance().Rebuild();
+
+    std::string           mode( argv[1] );
+    std::vector<wxString> args;
+
+    for( int i = 2; i < argc; ++i )
+        args.push_back( wxString::FromUTF8( argv[i] ) );
+
+    if( mode == "replay" )
+        return replayLogs( args );
+    else if( mode == "route" )
+        return routeBoard( args );
+
+    std::cerr << "Unknown mode '" << mode << "'" << std::endl;
+    return 1;
+}
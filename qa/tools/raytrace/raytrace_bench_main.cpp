@@ -0,0 +1,215 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2023 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Measure the frame rate of the 3D viewer's raytracer.
+ *
+ * Usage:
+ *   raytrace_bench <board.kicad_pcb> [--frames N] [--size WIDTHxHEIGHT] [--high] [--bottom]
+ *                  [-o last_frame.png]
+ *
+ * The scene of the board (with the models of its footprints) is built once, then traced
+ * off-screen N times from the same camera.  Prints the scene build time, the time of each
+ * frame and the average frames per second.  "--high" turns on every raytracing option
+ * (reflections, refractions, anti-aliasing and post processing), otherwise only shadows are
+ * traced.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <wx/filename.h>
+#include <wx/image.h>
+#include <wx/init.h>
+
+#include <board.h>
+#include <core/profile.h>
+#include <locale_io.h>
+#include <pcbnew_settings.h>
+#include <pgm_base.h>
+#include <project.h>
+#include <project_pcb.h>
+#include <properties/property_mgr.h>
+#include <settings/settings_manager.h>
+#include <wildcards_and_files_ext.h>
+
+#include <3d_rendering/raytracing/render_3d_raytrace.h>
+#include <3d_rendering/track_ball.h>
+#include <3d_viewer/eda_3d_viewer_settings.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+
+static int runBenchmark( const wxString& aBoardFile, int aFrames, const wxSize& aSize,
+                         bool aHighQuality, bool aBottom, const wxString& aOutputFile )
+{
+    SETTINGS_MANAGER& mgr = Pgm().GetSettingsManager();
+    wxFileName        pro( aBoardFile );
+
+    pro.SetExt( ProjectFileExtension );
+    pro.MakeAbsolute();
+
+    {
+        LOCALE_IO dummy;
+        mgr.LoadProject( pro.FileExists() ? pro.GetFullPath() : wxString( "" ) );
+    }
+
+    std::unique_ptr<BOARD> board( KI_TEST::ReadBoardFromFileOrStream( aBoardFile.ToStdString() ) );
+
+    if( !board )
+    {
+        std::cerr << "Could not load board " << aBoardFile.ToStdString() << std::endl;
+        return 1;
+    }
+
+    board->SetProject( &mgr.Prj() );
+
+    EDA_3D_VIEWER_SETTINGS* cfg = mgr.GetAppSettings<EDA_3D_VIEWER_SETTINGS>();
+
+    cfg->m_Render.engine = RENDER_ENGINE::RAYTRACING;
+    cfg->m_Render.raytrace_anti_aliasing = aHighQuality;
+    cfg->m_Render.raytrace_post_processing = aHighQuality;
+    cfg->m_Render.raytrace_procedural_textures = aHighQuality;
+    cfg->m_Render.raytrace_reflections = aHighQuality;
+    cfg->m_Render.raytrace_refractions = aHighQuality;
+    cfg->m_Render.raytrace_shadows = true;
+
+    BOARD_ADAPTER boardAdapter;
+
+    boardAdapter.SetBoard( board.get() );
+    boardAdapter.m_Cfg = cfg;
+    boardAdapter.Set3dCacheManager( PROJECT_PCB::Get3DCacheManager( board->GetProject() ) );
+
+    TRACK_BALL         camera( 2 * RANGE_SCALE_3D );
+    RENDER_3D_RAYTRACE raytrace( nullptr, boardAdapter, camera );
+
+    camera.SetCurWindowSize( aSize );
+
+    PROF_TIMER sceneTimer;
+    raytrace.Reload( nullptr, nullptr, false );
+    sceneTimer.Stop();
+
+    camera.Reset();
+
+    if( aBottom )
+        camera.RotateY( glm::radians( 180.0f ) );
+
+    printf( "%s: scene built in %.1f ms\n", aBoardFile.ToStdString().c_str(), sceneTimer.msecs() );
+
+    std::vector<double> frameMs;
+    wxImage             image;
+
+    for( int ii = 0; ii < aFrames; ++ii )
+    {
+        PROF_TIMER frameTimer;
+
+        if( !raytrace.RenderToImage( aSize, image, nullptr ) )
+        {
+            std::cerr << "Could not render the board at " << aSize.x << "x" << aSize.y
+                      << std::endl;
+            return 1;
+        }
+
+        frameTimer.Stop();
+        frameMs.push_back( frameTimer.msecs() );
+
+        printf( "frame %3d: %10.1f ms\n", ii, frameMs.back() );
+    }
+
+    double total = 0.0;
+
+    for( double ms : frameMs )
+        total += ms;
+
+    std::sort( frameMs.begin(), frameMs.end() );
+
+    printf( "\n%d frames at %dx%d, %s quality\n", aFrames, aSize.x, aSize.y,
+            aHighQuality ? "high" : "basic" );
+    printf( "min %.1f ms, median %.1f ms, max %.1f ms, %.3f fps\n", frameMs.front(),
+            frameMs[frameMs.size() / 2], frameMs.back(), 1000.0 * aFrames / total );
+
+    if( !aOutputFile.IsEmpty() && !image.SaveFile( aOutputFile, wxBITMAP_TYPE_PNG ) )
+    {
+        std::cerr << "Could not save " << aOutputFile.ToStdString() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    wxString boardFile;
+    wxString outputFile;
+    int      frames = 5;
+    wxSize   size( 1280, 720 );
+    bool     highQuality = false;
+    bool     bottom = false;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg( argv[i] );
+
+        if( arg == "--frames" && i + 1 < argc )
+            frames = std::max( 1, atoi( argv[++i] ) );
+        else if( arg == "--size" && i + 1 < argc )
+            sscanf( argv[++i], "%dx%d", &size.x, &size.y );
+        else if( arg == "--high" )
+            highQuality = true;
+        else if( arg == "--bottom" )
+            bottom = true;
+        else if( arg == "-o" && i + 1 < argc )
+            outputFile = wxString::FromUTF8( argv[++i] );
+        else if( boardFile.IsEmpty() )
+            boardFile = wxString::FromUTF8( argv[i] );
+    }
+
+    if( boardFile.IsEmpty() )
+    {
+        std::cerr << "Usage: " << argv[0] << " <board.kicad_pcb> [--frames N] "
+                     "[--size WIDTHxHEIGHT] [--high] [--bottom] [-o last_frame.png]"
+                  << std::endl;
+        return 1;
+    }
+
+    if( !wxInitialize( argc, argv ) )
+        return 1;
+
+    Pgm().InitPgm( true, true );
+    Pgm().GetSettingsManager().RegisterSettings( new PCBNEW_SETTINGS, false );
+    Pgm().GetSettingsManager().RegisterSettings( new EDA_3D_VIEWER_SETTINGS, false );
+    Pgm().GetSettingsManager().Load();
+
+    wxInitAllImageHandlers();
+    PROPERTY_MANAGER::Instance().Rebuild();
+
+    int ret = runBenchmark( boardFile, frames, size, highQuality, bottom, outputFile );
+
+    Pgm().Destroy();
+    wxUninitialize();
+
+    return ret;
+}